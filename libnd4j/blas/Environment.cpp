@@ -44,6 +44,15 @@ namespace nd4j {
         _leaks.store(false);
         _dataType.store(nd4j::DataType::FLOAT32);
 
+        // cached blocks would hide use-after-free & overflows from AddressSanitizer
+#if defined(__SANITIZE_ADDRESS__)
+        _hostCache.store(false);
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+        _hostCache.store(false);
+#endif
+#endif
+
 #ifndef ANDROID
         const char* omp_threads = std::getenv("OMP_NUM_THREADS");
         if (omp_threads != nullptr) {
@@ -24,6 +24,7 @@
 #include <atomic>
 #include <vector>
 #include <dll.h>
+#include <pointercast.h>
 #include <stdexcept>
 #include <array/DataType.h>
 #include <types/pair.h>
@@ -41,6 +42,14 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<bool> _numaAware{false};
+        std::atomic<bool> _numaReplication{false};
+        std::atomic<bool> _hugePages{false};
+        std::atomic<Nd4jLong> _hugePagesThreshold{16L * 1024L * 1024L};
+        std::atomic<bool> _hostCache{true};
+        std::atomic<Nd4jLong> _hostCacheLimit{256L * 1024L * 1024L};
+        std::atomic<Nd4jLong> _shapeCacheLimit{0L};
+        std::atomic<Nd4jLong> _tadCacheLimit{0L};
 
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
@@ -80,6 +89,37 @@ namespace nd4j{
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        // if TRUE, graph sessions are bound to NUMA node of the thread that created them
+        bool isNumaAware() { return _numaAware.load(); }
+        void setNumaAware(bool reallyAware) { _numaAware.store(reallyAware); }
+
+        // if TRUE, NUMA-bound sessions read graph variables from per-node replicas
+        bool isNumaReplication() { return _numaReplication.load(); }
+        void setNumaReplication(bool reallyReplicate) { _numaReplication.store(reallyReplicate); }
+
+        // if TRUE, host buffers of workspaces and arrays above threshold are backed by huge pages
+        bool isHugePages() { return _hugePages.load(); }
+        void setHugePages(bool reallyUse) { _hugePages.store(reallyUse); }
+
+        Nd4jLong hugePagesThreshold() { return _hugePagesThreshold.load(); }
+        void setHugePagesThreshold(Nd4jLong numBytes) { _hugePagesThreshold.store(numBytes); }
+
+        // if TRUE, released host buffers allocated outside of workspaces are cached for reuse. Disabled under ASAN
+        bool isHostCache() { return _hostCache.load(); }
+        void setHostCache(bool reallyCache) { _hostCache.store(reallyCache); }
+
+        // max number of bytes kept in host cache
+        Nd4jLong hostCacheLimit() { return _hostCacheLimit.load(); }
+        void setHostCacheLimit(Nd4jLong numBytes) { _hostCacheLimit.store(numBytes); }
+
+        // max number of bytes kept in ConstantShapeHelper and ConstantTadHelper caches, 0 means no limit. CPU backend only.
+        // limit is split evenly between 64 shards of each cache, so with small limits eviction starts well below the limit
+        Nd4jLong shapeCacheLimit() { return _shapeCacheLimit.load(std::memory_order_relaxed); }
+        void setShapeCacheLimit(Nd4jLong numBytes) { _shapeCacheLimit.store(numBytes); }
+
+        Nd4jLong tadCacheLimit() { return _tadCacheLimit.load(std::memory_order_relaxed); }
+        void setTadCacheLimit(Nd4jLong numBytes) { _tadCacheLimit.store(numBytes); }
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
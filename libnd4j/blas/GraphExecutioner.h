@@ -42,7 +42,25 @@ namespace nd4j {
 
     class ND4J_EXPORT GraphExecutioner {
     protected:
+        /**
+         * This method returns TRUE if given node can be executed concurrently with other nodes
+         * of the same graph: i.e. it's not a LOGIC op, it doesn't work inplace and has fixed number of outputs
+         */
+        static bool isParallelizable(Node *node);
 
+        /**
+         * This method checks if given node has disabled inputs, or inputs coming from inactive divergent branch.
+         * If so, node is marked as inactive within FlowPath, and TRUE is returned.
+         */
+        static bool hasInactiveInputs(Graph *graph, Node *node, FlowPath *flowPath);
+
+        /**
+         * This method executes given nodes in dependency-driven order: each node is scheduled as soon
+         * as all its inputs within the given list are computed, and ready nodes are executed concurrently.
+         *
+         * PLEASE NOTE: given nodes are expected to be parallelizable, and listed in topological order
+         */
+        static Nd4jStatus executeParallel(Graph *graph, std::vector<Node*> &nodes, VariableSpace *variableSpace);
 
     public:
         //static Nd4jStatus executeFlatNode(nd4j::graph::Graph *graph, nd4j::graph::Node *node, nd4j::graph::VariableSpace<float> *variableSpace);
@@ -72,6 +90,15 @@ namespace nd4j {
         static Graph *importFromFlatBuffers(const char *filename);
 
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
+
+        /**
+        * This method imports FlatBuffers graph via mmap: arrays are pointing directly into the mapped file whenever
+        * byte order and alignment allow that, and the rest of arrays are copied
+        *
+        * @param filename
+        * @return
+        */
+        static Graph *importFromMappedFlatBuffers(const char *filename);
     };
 
     long getFileSize(const char * filename);
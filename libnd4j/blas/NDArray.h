@@ -1223,9 +1223,11 @@ namespace nd4j {
 
 
         /**
-        *  default destructor
+        *  destructor, unpins shapeInfo
         */
-        ~NDArray() noexcept = default;
+        ~NDArray() noexcept {
+            ConstantShapeHelper::release(_shapeInfo);
+        }
 
         /**
         *  set _shapeInfo
@@ -1539,7 +1541,11 @@ namespace nd4j {
 
     //////////////////////////////////////////////////////////////////////////
     void NDArray::setShapeInfo(Nd4jLong *shapeInfo) {
+        // shapeInfo is pinned before guard is released, so it can't be evicted meanwhile
+        EpochGuard guard;
         auto buffer = ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfo);
+        ConstantShapeHelper::retain(buffer.primaryAsT<Nd4jLong>());
+        ConstantShapeHelper::release(_shapeInfo);
         _shapeInfo = buffer.primaryAsT<Nd4jLong>();
         _shapeInfoD = buffer.specialAsT<Nd4jLong>();
 
@@ -1558,7 +1564,11 @@ namespace nd4j {
 
     //////////////////////////////////////////////////////////////////////////
     void NDArray::setShapeInfo(Nd4jLong *shapeInfo, const nd4j::DataType dtype) {
+        // shapeInfo is pinned before guard is released, so it can't be evicted meanwhile
+        EpochGuard guard;
         auto buffer = ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfo);
+        ConstantShapeHelper::retain(buffer.primaryAsT<Nd4jLong>());
+        ConstantShapeHelper::release(_shapeInfo);
         _shapeInfo = buffer.primaryAsT<Nd4jLong>();
         _shapeInfoD = buffer.specialAsT<Nd4jLong>();
 
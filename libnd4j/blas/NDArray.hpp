@@ -509,6 +509,8 @@ void NDArray::streamline(char o) {
     char order = o == 'a' ? this->ordering() : o;
     syncToDevice();
     std::shared_ptr<DataBuffer> newBuffer = std::make_shared<DataBuffer>(this->lengthOf() * sizeOfT(), dataType(), getContext()->getWorkspace());
+    // shapeInfo is pinned before guard is released, so it can't be evicted meanwhile
+    EpochGuard guard;
     auto shapeBuffer = ConstantShapeHelper::getInstance()->bufferForShapeInfo(dataType(), order, rankOf(), shapeOf());
     NativeOpExecutioner::execTransformSame(getContext(), transform::Copy, getBuffer(), getShapeInfo(), getSpecialBuffer(), getSpecialShapeInfo(), newBuffer->primary(), static_cast<Nd4jLong*>(shapeBuffer.primary()), newBuffer->special(), static_cast<Nd4jLong*>(shapeBuffer.special()), nullptr, nullptr, nullptr);
     setShapeInfo(static_cast<Nd4jLong*>(shapeBuffer.primary()));
@@ -523,6 +525,9 @@ NDArray& NDArray::operator=(NDArray&& other) noexcept {
     if (this == &other)
         return *this;
 
+    // pin of other array's shapeInfo is taken over
+    ConstantShapeHelper::release(_shapeInfo);
+
     _isView       = other._isView;
     _buffer       = other._buffer;
     _shapeInfo    = other._shapeInfo;
@@ -4317,8 +4322,12 @@ void NDArray::setShapeInfo(const Nd4jLong *shapeInfo) {
     if (shapeInfo != nullptr) {
 
         ShapeDescriptor descriptor(shapeInfo);
+        // shapeInfo is pinned before guard is released, so it can't be evicted meanwhile
+        EpochGuard guard;
         auto shapeBuffer = ConstantShapeHelper::getInstance()->bufferForShapeInfo(descriptor);
 
+        ConstantShapeHelper::retain(reinterpret_cast<Nd4jLong *>(shapeBuffer.primary()));
+        ConstantShapeHelper::release(_shapeInfo);
         _shapeInfo  = reinterpret_cast<Nd4jLong *>(shapeBuffer.primary());
         #ifdef __CUDABLAS__
             _shapeInfoD = reinterpret_cast<Nd4jLong *>(shapeBuffer.special());
@@ -4333,6 +4342,7 @@ void NDArray::setShapeInfo(const Nd4jLong *shapeInfo) {
     }
     else {
         _dataType = nd4j::DataType::INHERIT;
+        ConstantShapeHelper::release(_shapeInfo);
         _shapeInfoD = _shapeInfo = nullptr;
     }
 }
@@ -4344,8 +4354,12 @@ void NDArray::setShapeInfo(const Nd4jLong *shapeInfo, const nd4j::DataType dtype
 
         Nd4jLong* shapeInfoTemp = ShapeBuilders::copyShapeInfoAndType(shapeInfo, dtype, true, getContext()->getWorkspace());
         ShapeDescriptor descriptor(shapeInfoTemp);
+        // shapeInfo is pinned before guard is released, so it can't be evicted meanwhile
+        EpochGuard guard;
         auto shapeBuffer = ConstantShapeHelper::getInstance()->bufferForShapeInfo(descriptor);
 
+        ConstantShapeHelper::retain(reinterpret_cast<Nd4jLong *>(shapeBuffer.primary()));
+        ConstantShapeHelper::release(_shapeInfo);
         _shapeInfo  = reinterpret_cast<Nd4jLong *>(shapeBuffer.primary());
         #ifdef __CUDABLAS__
             _shapeInfoD = reinterpret_cast<Nd4jLong *>(shapeBuffer.special());
@@ -4360,6 +4374,7 @@ void NDArray::setShapeInfo(const Nd4jLong *shapeInfo, const nd4j::DataType dtype
     }
     else {
         _dataType = nd4j::DataType::INHERIT;
+        ConstantShapeHelper::release(_shapeInfo);
         _shapeInfoD = _shapeInfo = nullptr;
     }
 }
@@ -4367,8 +4382,12 @@ void NDArray::setShapeInfo(const Nd4jLong *shapeInfo, const nd4j::DataType dtype
 //////////////////////////////////////////////////////////////////////////
 void NDArray::setShapeInfo(const ShapeDescriptor& descriptor) {
 
+    // shapeInfo is pinned before guard is released, so it can't be evicted meanwhile
+    EpochGuard guard;
     auto shapeBuffer = ConstantShapeHelper::getInstance()->bufferForShapeInfo(const_cast<ShapeDescriptor &>(descriptor));
 
+    ConstantShapeHelper::retain(reinterpret_cast<Nd4jLong *>(shapeBuffer.primary()));
+    ConstantShapeHelper::release(_shapeInfo);
     _shapeInfo  = reinterpret_cast<Nd4jLong *>(shapeBuffer.primary());
     #ifdef __CUDABLAS__
         _shapeInfoD = reinterpret_cast<Nd4jLong *>(shapeBuffer.special());
@@ -4385,6 +4404,8 @@ void NDArray::setShapeInfo(const ShapeDescriptor& descriptor) {
 //////////////////////////////////////////////////////////////////////////
 void NDArray::setShapeInfo(const ConstantDataBuffer& shapeBuffer) {
 
+    ConstantShapeHelper::retain(reinterpret_cast<Nd4jLong *>(const_cast<ConstantDataBuffer&>(shapeBuffer).primary()));
+    ConstantShapeHelper::release(_shapeInfo);
     _shapeInfo  = reinterpret_cast<Nd4jLong *>(const_cast<ConstantDataBuffer&>(shapeBuffer).primary());
     #ifdef __CUDABLAS__
     _shapeInfoD = reinterpret_cast<Nd4jLong *>(const_cast<ConstantDataBuffer&>(shapeBuffer).special());
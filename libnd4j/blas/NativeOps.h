@@ -766,6 +766,35 @@ public:
      */
     Nd4jLong getCachedMemory(int deviceId);
 
+    /**
+     * This method sets max number of bytes kept in shapes cache, 0 means no limit.
+     * Limit is split evenly between 64 cache shards, so small limits trigger eviction before total size reaches them.
+     *
+     * PLEASE NOTE: evicted shapeInfo is released, so shapes obtained via shapeBuffer() or shapeBufferForNumpy()
+     * must be released via deleteShapeBuffer() or releaseShapeInfo() only once they're not used anymore
+     *
+     * @param numBytes
+     */
+    void setShapeCacheLimit(Nd4jLong numBytes);
+
+    /**
+     * This method sets max number of bytes kept in TADs cache, 0 means no limit.
+     * Same as for shapes cache, limit is split evenly between 64 cache shards
+     *
+     * @param numBytes
+     */
+    void setTadCacheLimit(Nd4jLong numBytes);
+
+    /**
+     * These methods return number of hits, misses and evictions of shapes and TADs caches for current device
+     */
+    Nd4jLong getShapeCacheHits();
+    Nd4jLong getShapeCacheMisses();
+    Nd4jLong getShapeCacheEvictions();
+    Nd4jLong getTadCacheHits();
+    Nd4jLong getTadCacheMisses();
+    Nd4jLong getTadCacheEvictions();
+
     /**
      *
      * @param ptrToDeviceId
@@ -1338,6 +1367,7 @@ public:
 
 
 /**
+ * Returned shapeInfo is pinned within shapes cache until releaseShapeInfo() call
  *
  * @param npyArray
  * @return
@@ -1693,7 +1723,16 @@ public:
     void inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4jLong *shapeInfo, Nd4jPointer specialBuffer, Nd4jLong *specialShapeInfo, Nd4jPointer debugInfo);
 
 
+    /**
+     * This method returns cached shapeInfo. It stays pinned within shapes cache until deleteShapeBuffer() call
+     */
     nd4j::ConstantDataBuffer* shapeBuffer(int rank, Nd4jLong *shape, Nd4jLong *strides, nd4j::DataType dtype, char order, Nd4jLong ews, bool empty);
+    void deleteShapeBuffer(nd4j::ConstantDataBuffer* ptr);
+
+    /**
+     * This method unpins shapeInfo returned by shapeBufferForNumpy()
+     */
+    void releaseShapeInfo(Nd4jPointer shapeInfo);
 
     nd4j::ConstantDataBuffer* constantBuffer(nd4j::DataType dtype, Nd4jLong *data, int length);
     nd4j::ConstantDataBuffer* constantBuffer(nd4j::DataType dtype, double *data, int length);
@@ -31,6 +31,8 @@
 #include <Scope.h>
 #include <GraphExecutioner.h>
 #include <graph/TimeHolder.h>
+#include <graph/FlatUtils.h>
+#include <helpers/NumaHelper.h>
 #include <loops/scalar.h>
 #include <loops/pairwise_transform.h>
 #include <loops/transform_same.h>
@@ -41,6 +43,10 @@
 
 #include <fcntl.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <chrono>
 #include <ctime>
 #include <graph/execution/LogicExecutor.h>
@@ -50,14 +56,39 @@
 #include <helpers/ShapeUtils.h>
 #include <Status.h>
 #include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <templatemath.h>
+#include <openmp_pragmas.h>
 #include <graph/ResultWrapper.h>
 #include <graph/ExecutionResult.h>
+#include <graph/MappedFile.h>
 #include <exceptions/graph_execution_exception.h>
 #include <exceptions/no_results_exception.h>
 
+// graphs with loops are capped by number of executed nodes
+#define MAX_EXECUTION_STEPS 10000
+
 namespace nd4j{
 namespace graph {
 
+/**
+ * This method accounts given number of nodes about to be executed, and returns error once graph ran for too long.
+ * Sequential and parallel paths both count every node they execute here, so they stop with the same status
+ */
+static Nd4jStatus countSteps(Nd4jLong &counter, Nd4jLong steps) {
+    counter += steps;
+    return counter > MAX_EXECUTION_STEPS ? Status::THROW("Early termination hit") : Status::OK();
+}
+
+/**
+ * This method returns frame of the node: either defined by graph, or propagated during current execution
+ */
+static Nd4jLong frameOf(Node *node, FlowPath *flowPath) {
+    return node->getFrameId() >= 0 ? node->getFrameId() : flowPath->frameId(node->id());
+}
+
 /**
  * This method executes given Node (as in Op within Node)
  *
@@ -198,6 +229,185 @@ namespace graph {
 }
 
 
+bool GraphExecutioner::isParallelizable(Node *node) {
+    // LOGIC ops are changing FlowPath frames & branches, so they are always executed sequentially
+    if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || !node->hasCustomOp())
+        return false;
+
+    if (node->isInplace() || node->isDivergencePoint())
+        return false;
+
+    // ops with variable number of outputs might add new Variables to VariableSpace during execution
+    return node->getCustomOp()->getOpDescriptor()->getNumberOfOutputs() > 0;
+}
+
+bool GraphExecutioner::hasInactiveInputs(Graph *graph, Node *node, FlowPath *flowPath) {
+    for (int e = 0; e < node->input()->size(); e++) {
+        auto inputId = node->input()->at(e);
+
+        // not a node. skipping checks
+        if (graph->getMapped()->count(inputId.first) == 0)
+            continue;
+
+        /**
+         * We can skip current node, in two cases:
+         * 1) If previous node was disabled
+         * 2) If previous node was divergent node (i.e. IF op) and code went other way
+         */
+        Node *prevNode = graph->getMapped()->at(inputId.first);
+        if (!flowPath->isNodeActive(inputId.first)) {
+            flowPath->markNodeActive(node->id(), false);
+
+            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
+            return true;
+        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
+            if (flowPath->branch(inputId.first) != inputId.second) {
+                flowPath->markNodeActive(node->id(), false);
+
+                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(), inputId.first);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+Nd4jStatus GraphExecutioner::executeParallel(Graph *graph, std::vector<Node*> &nodes, VariableSpace *variableSpace) {
+    auto flowPath = variableSpace->flowPath();
+    auto profiling = Environment::getInstance()->isProfiling();
+    int numNodes = static_cast<int>(nodes.size());
+
+    // position of each node within given list
+    std::map<int, int> positions;
+    for (int e = 0; e < numNodes; e++)
+        positions[nodes[e]->id()] = e;
+
+    // number of inputs not computed yet, and list of dependent nodes, for each node
+    std::vector<int> pending(numNodes, 0);
+    std::vector<std::vector<int>> dependents(numNodes);
+
+    for (int e = 0; e < numNodes; e++) {
+        auto node = nodes[e];
+
+        // all FlowPath states & profiles are created here, so workers only update existing entries
+        flowPath->registerNode(node->id());
+        if (profiling)
+            flowPath->profile()->nodeById(node->id(), node->name()->c_str());
+
+        // same for output Variables: workers only look VariableSpace up, so its maps are never modified concurrently
+        auto numOutputs = node->getCustomOp()->getOpDescriptor()->getNumberOfOutputs();
+        for (int o = 0; o < numOutputs; o++) {
+            std::pair<int, int> pair(node->id(), o);
+            if (!variableSpace->hasVariable(pair))
+                variableSpace->putVariable(pair, new Variable(nullptr, nullptr, node->id(), o));
+        }
+
+        std::vector<int> seen;
+        for (auto &inputId: *node->input()) {
+            if (graph->getMapped()->count(inputId.first) > 0)
+                flowPath->registerNode(inputId.first);
+
+            if (positions.count(inputId.first) == 0 || std::find(seen.begin(), seen.end(), inputId.first) != seen.end())
+                continue;
+
+            seen.emplace_back(inputId.first);
+            dependents[positions[inputId.first]].emplace_back(e);
+            pending[e]++;
+        }
+    }
+
+    std::deque<int> ready;
+    for (int e = 0; e < numNodes; e++)
+        if (pending[e] == 0)
+            ready.emplace_back(e);
+
+    std::mutex queueLock;
+    std::condition_variable queueCondition;
+    int finished = 0;
+
+    std::atomic<bool> failed(false);
+    Nd4jStatus result = Status::OK();
+    std::exception_ptr exception = nullptr;
+
+#ifdef _OPENMP
+    int numThreads = nd4j::math::nd4j_min<int>(omp_get_max_threads(), numNodes);
+#else
+    int numThreads = 1;
+#endif
+
+    PRAGMA_OMP_PARALLEL_THREADS(numThreads)
+    {
+        while (true) {
+            int e = 0;
+            {
+                std::unique_lock<std::mutex> guard(queueLock);
+                queueCondition.wait(guard, [&] { return !ready.empty() || finished == numNodes; });
+
+                if (ready.empty())
+                    break;
+
+                e = ready.front();
+                ready.pop_front();
+            }
+
+            auto node = nodes[e];
+            Nd4jStatus status = Status::OK();
+
+            // after first failure all remaining nodes are just drained from the queue
+            if (!failed.load() && !hasInactiveInputs(graph, node, flowPath)) {
+                nd4j_debug("Scheduled Node: %i <%s>\n", node->id(), node->name()->c_str());
+
+                flowPath->markNodeActive(node->id(), true);
+
+                auto timeStart = std::chrono::system_clock::now();
+
+                try {
+                    status = executeFlatNode(graph, node, variableSpace);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(queueLock);
+                    if (exception == nullptr)
+                        exception = std::current_exception();
+
+                    status = ND4J_STATUS_BAD_INPUT;
+                }
+
+                auto timeEnd = std::chrono::system_clock::now();
+                auto outerTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+
+                flowPath->setOuterTime(node->id(), outerTime);
+
+                if (profiling)
+                    flowPath->profile()->nodeById(node->id())->setTotalTime(outerTime);
+
+                if (status == ND4J_STATUS_OK)
+                    flowPath->markExecuted(node->id(), true);
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(queueLock);
+                if (status != ND4J_STATUS_OK && result == Status::OK()) {
+                    result = status;
+                    failed = true;
+                }
+
+                finished++;
+                for (auto d: dependents[e])
+                    if (--pending[d] == 0)
+                        ready.emplace_back(d);
+            }
+
+            queueCondition.notify_all();
+        }
+    }
+
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+
+    return result;
+}
+
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -207,6 +417,9 @@ namespace graph {
 Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace) {
     auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
 
+    // NUMA-bound sessions are executed by thread pinned to their node, so their arrays are allocated there
+    NumaBinding numaBinding(graph->numaNode());
+
     bool tempFlow = false;
     if (__variableSpace->flowPath() == nullptr) {
         tempFlow = true;
@@ -226,14 +439,18 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         }
     }
 
+    bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
+
+    // planned arrays share memory based on sequential order of layers, so plan isn't used by parallel executor
+    if (!pe && graph->isMemoryPlanning() && graph->getMemoryPlan() != nullptr)
+        __variableSpace->attachMemoryPlan(graph->getMemoryPlan());
+
     // optionally saving graph build time
     if (Environment::getInstance()->isProfiling())
         flowPath->profile()->setBuildTime(GraphProfile::relativeTime(tb0));
 
     Nd4jLong timeStart = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
 
-    bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
-
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -244,17 +461,71 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     auto nodeTime = GraphProfile::currentTime();
     int lastId = -10000000;
     Nd4jLong exec_counter = 0;
+    int chainedUntil = 0;
     // we loop through op layers here
     for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
         int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
 
+        // in AUTO mode we collect consecutive layers without LOGIC ops, and pass them to the scheduler at once
+        if (pe && l >= chainedUntil) {
+            std::vector<Node*> segment;
+            bool wide = false;
+            int lastLayer = l;
+            for (; lastLayer < (int) graph->getOnion()->size(); lastLayer++) {
+                if (graph->getOnion()->count(lastLayer) == 0)
+                    continue;
+
+                auto layer = graph->getOnion()->at(lastLayer);
+                if (!std::all_of(layer->begin(), layer->end(), isParallelizable))
+                    break;
+
+                wide |= layer->size() > 1;
+                segment.insert(segment.end(), layer->begin(), layer->end());
+            }
+
+            // there's no reason to schedule plain chain of nodes
+            if (wide) {
+                auto steps = countSteps(exec_counter, segment.size());
+                if (steps != Status::OK())
+                    return steps;
+
+                // if we're out of frame - let's remove it from queue
+                if (leftFrame) {
+                    auto frame_id = frames.back();
+                    frames.pop_back();
+                    flowPath->markFrameActive(frame_id, false);
+                    flowPath->forgetFrame(frame_id);
+
+                    leftFrame = false;
+                }
+
+                if (Environment::getInstance()->isProfiling() && lastId != -10000000) {
+                    flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
+                    lastId = -10000000;
+                }
+
+                // we're propagating frameId here (but only if wasn't set earlier)
+                for (auto node: segment)
+                    if (frames.size() > 0 && frameOf(node, flowPath) < 0)
+                        flowPath->setFrameId(node->id(), frames.back());
+
+                auto status = executeParallel(graph, segment, __variableSpace);
+                if (status != Status::OK())
+                    return status;
+
+                l = lastLayer - 1;
+                continue;
+            }
+
+            // layers up to lastLayer form a chain, so there's no need to check them again
+            chainedUntil = lastLayer;
+        }
+
         int n = 0;
-// this omp block will probably never be the case
         for (; n < layerSize; n++) {
-            if (++exec_counter > 10000) {
-                l = graph->getOnion()->size();
-                return Status::THROW("Early termination hit");
-            }
+            auto steps = countSteps(exec_counter, 1);
+            if (steps != Status::OK())
+                return steps;
 
             Node* node = graph->getOnion()->at(l)->at(n);
 
@@ -300,36 +571,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 } else {
                     // let's check for input nodes, if they are disabled or contain divergents
-                    for (int e = 0; e < node->input()->size(); e++) {
-                        auto inputId = node->input()->at(e);
-
-                        // not a node. skipping checks
-                        if (graph->getMapped()->count(inputId.first) == 0)
-                            continue;
-
-                        /**
-                         * We can skip current node, in two cases:
-                         * 1) If previous node was disabled
-                         * 2) If previous node was divergent node (i.e. IF op) and code went other way
-                         */
-                        Node *prevNode = graph->getMapped()->at(inputId.first);
-                        if (!flowPath->isNodeActive(inputId.first)) {
-                            shouldSkip = true;
-                            flowPath->markNodeActive(node->id(), false);
-
-                            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
-                            break;
-
-                        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
-                            if (flowPath->branch(inputId.first) != inputId.second) {
-                                shouldSkip = true;
-                                flowPath->markNodeActive(node->id(), false);
-                                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(),
-                                           inputId.first);
-                                break;
-                            }
-                        }
-                    }
+                    shouldSkip = hasInactiveInputs(graph, node, flowPath);
                 }
 
                 if (shouldSkip)
@@ -337,8 +579,8 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
             }
 
             // we're propagating frameId here (but only if wasn't set earlier)
-            if (frames.size() > 0 && node->getFrameId() < 0)
-                node->setFrameId(frames.back());
+            if (frames.size() > 0 && frameOf(node, flowPath) < 0)
+                flowPath->setFrameId(node->id(), frames.back());
 
 
             flowPath->markNodeActive(node->id(), true);
@@ -348,7 +590,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 // VALIDATED
 
                 // we expect this node to have frameId set
-                auto frame_id = node->getFrameId();
+                auto frame_id = frameOf(node, flowPath);
 
                 // new frame starts here
                 if (frames.size() == 0 || (frames.size() > 0 && frames.back() != frame_id)) {
@@ -481,13 +723,18 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     // optionally saving execution time
     if (Environment::getInstance()->isProfiling()) {
-        flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
+        if (lastId != -10000000)
+            flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
         flowPath->profile()->setExecutionTime(GraphProfile::relativeTime(timeStart));
         //flowPath->profile().printOut();
     }
 
+    // first sequential run provides array sizes for memory plan. warm-up with made up shapes doesn't, first real request will
+    if (!pe && graph->isMemoryPlanning() && graph->getMemoryPlan() == nullptr && !graph->hasSyntheticInputs())
+        graph->buildMemoryPlan(__variableSpace);
+
     // saving memory footprint for current run
-    if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
+    if (__variableSpace->launchContext()->getWorkspace() != nullptr && !graph->hasSyntheticInputs()) {
         auto m = __variableSpace->launchContext()->getWorkspace()->getAllocatedSize();
         auto h = graph->hashCode();
         nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(h, m);
@@ -576,14 +823,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
 
         NDArray* array = var->getNDArray();
-        auto byteVector = array->asByteVector();
-
-        auto fBuffer = builder.CreateVector(byteVector);
-        auto fShape = builder.CreateVector(array->getShapeInfoAsFlatVector());
-
-        auto bo = static_cast<nd4j::graph::ByteOrder>(BitwiseUtils::asByteOrder());
-
-        auto fArray = CreateFlatArray(builder, fShape, fBuffer, static_cast<nd4j::graph::DataType>(array->dataType()), bo);
+        auto fArray = FlatUtils::toFlatArray(builder, *array);
 
         auto fName = builder.CreateString(*(var->getName()));
         auto id = CreateIntPair(builder, var->id(), var->index());
@@ -905,5 +1145,21 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
 
             return restoredGraph;
         }
+
+        Graph* GraphExecutioner::importFromMappedFlatBuffers(const char *filename) {
+            auto file = new MappedFile(filename);
+
+            Graph *restoredGraph = nullptr;
+            try {
+                auto fg = GetFlatGraph(file->data());
+                restoredGraph = new Graph(fg, nullptr, true);
+            } catch (...) {
+                delete file;
+                throw;
+            }
+
+            restoredGraph->attachMappedFile(file);
+            return restoredGraph;
+        }
     }
 }
\ No newline at end of file
@@ -72,6 +72,8 @@ bool experimentalSupport = false;
 #include <graph/ResultWrapper.h>
 #include <helpers/DebugHelper.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/EpochManager.h>
+#include <memory/CachingHostAllocator.h>
 #include <performance/benchmarking/BenchmarkSuit.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
@@ -106,6 +108,7 @@ void NativeOps::execIndexReduceScalar(Nd4jPointer *extraPointers,
                                                 void *extraParams,
                                                 void *hZ, Nd4jLong *hZShapeInfo,
                                                 void *dZ, Nd4jLong *dZShapeInfo) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execIndexReduceScalar(nullptr, opNum, hX, hXShapeInfo, dX, dXShapeInfo, extraParams, hZ, hZShapeInfo, dZ, dZShapeInfo);
 }
@@ -129,6 +132,7 @@ void  NativeOps::execIndexReduce(Nd4jPointer *extraPointers,int opNum,
                                         void *dZ, Nd4jLong *dZShapeInfo,
                                         void *hDimension, Nd4jLong *hDimensionShape,
                                         void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -179,6 +183,8 @@ void NativeOps::execBroadcast(Nd4jPointer *extraPointers,
                                       void *dZ, Nd4jLong *dZShapeInfo,
                                       void *hDimension, Nd4jLong *hDimensionShape,
                                       void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -216,6 +222,8 @@ void NativeOps::execBroadcastBool(Nd4jPointer *extraPointers,
                               void *dZ, Nd4jLong *dZShapeInfo,
                                   void *hDimension, Nd4jLong *hDimensionShape,
                                   void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -265,6 +273,8 @@ void NativeOps::execPairwiseTransform(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
+
     NativeOpExecutioner::execPairwiseTransform(nullptr,
                                               opNum,
             hX,
@@ -292,6 +302,8 @@ void NativeOps::execPairwiseTransformBool(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
+
     NativeOpExecutioner::execPairwiseBoolTransform(nullptr,
                                                   opNum,
             hX,
@@ -326,6 +338,7 @@ void NativeOps::execReduceFloat(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execReduceFloatScalar(nullptr,
                                               opNum,
@@ -349,6 +362,7 @@ void NativeOps::execReduceSame(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execReduceSameScalar(nullptr,
                                              opNum,
@@ -372,6 +386,7 @@ void NativeOps::execReduceBool(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execReduceBoolScalar(nullptr,
                                              opNum,
@@ -395,6 +410,7 @@ void NativeOps::execReduceLong(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execReduceLongScalar(nullptr,
                                              opNum,
@@ -428,6 +444,8 @@ void NativeOps::execReduceFloat(Nd4jPointer *extraPointers,
                                    void *dZ, Nd4jLong *dZShapeInfo,
                                 void *hDimension, Nd4jLong *hDimensionShape,
                                 void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -461,6 +479,8 @@ void NativeOps::execReduceBool(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -494,6 +514,8 @@ void NativeOps::execReduceSame(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -527,6 +549,8 @@ void NativeOps::execReduceLong(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -658,6 +682,8 @@ void NativeOps::execScalar(
         void *hScalar, Nd4jLong *hScalarShapeInfo,
         void *dScalar, Nd4jLong *dScalarShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
+
     NativeOpExecutioner::execScalar(nullptr,
                                    opNum,
             hX,
@@ -685,6 +711,7 @@ void NativeOps::execScalarBool(
         void *hScalar, Nd4jLong *hScalarShapeInfo,
         void *dScalar, Nd4jLong *dScalarShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execScalarBool(nullptr,
                                        opNum,
@@ -718,6 +745,8 @@ void NativeOps::execSummaryStatsScalar(Nd4jPointer *extraPointers,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         bool biasCorrected) {
+    EpochGuard guard;
+
     NativeOpExecutioner::execSummaryStatsScalar(nullptr,
                                                opNum,
             hX,
@@ -748,6 +777,8 @@ void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                          void *hZ, Nd4jLong *hZShapeInfo,
                                          void *dZ, Nd4jLong *dZShapeInfo,
                                          bool biasCorrected) {
+    EpochGuard guard;
+
     NativeOpExecutioner::execSummaryStats(nullptr,
                                          opNum,
             hX,
@@ -783,6 +814,8 @@ void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                          void *dDimension, Nd4jLong *dDimensionShape,
                                          bool biasCorrected,
                                          Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets) {
+    EpochGuard guard;
+
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -824,6 +857,7 @@ void NativeOps::execTransformFloat(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execTransformFloat(nullptr,
                                            opNum,
@@ -848,6 +882,7 @@ void NativeOps::execTransformSame(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execTransformSame(nullptr,
                                           opNum,
@@ -872,6 +907,7 @@ void NativeOps::execTransformBool(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execTransformBool(nullptr,
                                           opNum,
@@ -896,6 +932,7 @@ void NativeOps::execTransformAny(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execTransformAny(nullptr,
                                          opNum,
@@ -920,6 +957,7 @@ void NativeOps::execTransformStrict(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execTransformStrict(nullptr,
                                             opNum,
@@ -1635,6 +1673,8 @@ void NativeOps::execMetaPredicateShape(Nd4jPointer *extras,
                                         void *extraB,
                                         double scalarA,
                                         double scalarB) {
+    EpochGuard guard;
+
     // no-op;
 }
 */
@@ -1656,6 +1696,7 @@ void NativeOps::execScalar(Nd4jPointer *extraPointers,
                                  void *dDimension, Nd4jLong *dDimensionShape,
                                  Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets,
                                  Nd4jLong *tadShapeInfoZ, Nd4jLong *tadOffsetsZ) {
+    EpochGuard guard;
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1696,6 +1737,7 @@ void NativeOps::execScalarBool(Nd4jPointer *extraPointers,
                            void *dDimension, Nd4jLong *dDimensionShape,
                            Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets,
                            Nd4jLong *tadShapeInfoZ, Nd4jLong *tadOffsetsZ) {
+    EpochGuard guard;
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1753,6 +1795,7 @@ void NativeOps::execAggregate(Nd4jPointer *extraPointers,int opNum,
                                     void *realArguments,
                                     int numRealArguments,
                                     nd4j::DataType dtype) {
+    EpochGuard guard;
 
     BUILD_SINGLE_SELECTOR(dtype, NativeOpExecutioner::execAggregate, (nullptr, opNum, arguments, numArguments, shapeArguments, numShapeArguments, indexArguments, numIndexArguments, intArrays, numIntArrays, realArguments, numRealArguments), FLOAT_TYPES);
 
@@ -1826,6 +1869,8 @@ void NativeOps::execAggregateBatch(Nd4jPointer *extraPointers,
                                          int maxReals,
                                          void *ptrToArguments,
                                          nd4j::DataType dtype) {
+    EpochGuard guard;
+
     BUILD_SINGLE_SELECTOR(dtype, _batchExecutor, (extraPointers, numAggregates, opNum, maxArgs, maxShapes, maxIntArrays, maxIntArraySize, maxIdx, maxReals, ptrToArguments, dtype), FLOAT_TYPES);
 }
 
@@ -1836,6 +1881,8 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    EpochGuard guard;
+
     NativeOpExecutioner::execRandom(nullptr, opNum, state, hZ, hZShapeInfo, dZ, dZShapeInfo, extraArguments);
 }
 
@@ -1849,6 +1896,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execRandom(nullptr, opNum, state, hX, hXShapeInfo, dX, dXShapeInfo, hY, hYShapeInfo, dY, dYShapeInfo, hZ, hZShapeInfo, dZ, dZShapeInfo, extraArguments);
 }
@@ -1861,6 +1909,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    EpochGuard guard;
 
     NativeOpExecutioner::execRandom(nullptr, opNum, state, hX, hXShapeInfo, dX, dXShapeInfo, hZ, hZShapeInfo, dZ, dZShapeInfo, extraArguments);
 }
@@ -2258,14 +2307,8 @@ static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong gr
         auto array = new nd4j::NDArray(inputBuffers[e], reinterpret_cast<Nd4jLong *>(inputShapes[e]));
         handles.emplace_back(array);
 
-        if (varSpace->hasVariable(idx)) {
-            auto var = varSpace->getVariable(idx);
-            if (var->hasNDArray())
-                delete var->getNDArray();
-
-            var->setNDArray(array);
-        } else
-            varSpace->putVariable(idx, array);
+        // graph is a session here, so inputs are stored within session and original graph stays intact
+        varSpace->putVariable(idx, array);
     }
 
     auto hZ = nd4j::graph::GraphExecutioner::execute(graph, varSpace);
@@ -2412,6 +2455,8 @@ Nd4jStatus execCustomOpWithScope_(Nd4jPointer *extraPointers, nd4j::graph::Graph
 }
 
 Nd4jStatus NativeOps::execCustomOpWithScope(Nd4jPointer *extraPointers, Nd4jPointer state, Nd4jLong opHash, Nd4jLong *scopes, int numScopes, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int numInputs, Nd4jPointer *outputBuffers, Nd4jPointer *outputShapes, int numOutputs) {
+    EpochGuard guard;
+
     return execCustomOpWithScope_(extraPointers, reinterpret_cast<nd4j::graph::GraphState*>(state), opHash, scopes, numScopes, inputBuffers, inputShapes, numInputs, outputBuffers, outputShapes, numOutputs);
 }
 
@@ -2695,11 +2740,24 @@ void NativeOps::tryPointer(Nd4jPointer extra, Nd4jPointer p, int len) {
 }
 
 nd4j::ConstantDataBuffer* NativeOps::shapeBuffer(int rank, Nd4jLong *shape, Nd4jLong *strides, nd4j::DataType dtype, char order, Nd4jLong ews, bool empty) {
+    // shapeInfo stays pinned until deleteShapeBuffer() call, so cache can't evict it while Java array uses it
+    EpochGuard guard;
+
     auto buffer = new ConstantDataBuffer();
     *buffer = nd4j::ConstantShapeHelper::getInstance()->bufferForShapeInfo(ShapeDescriptor(dtype, order, shape, strides, rank, ews, empty));
+    nd4j::ConstantShapeHelper::retain(buffer->primaryAsT<Nd4jLong>());
     return buffer;
 }
 
+void NativeOps::deleteShapeBuffer(nd4j::ConstantDataBuffer* ptr) {
+    nd4j::ConstantShapeHelper::release(ptr->primaryAsT<Nd4jLong>());
+    delete ptr;
+}
+
+void NativeOps::releaseShapeInfo(Nd4jPointer shapeInfo) {
+    nd4j::ConstantShapeHelper::release(reinterpret_cast<Nd4jLong *>(shapeInfo));
+}
+
 nd4j::ConstantDataBuffer* NativeOps::constantBuffer(nd4j::DataType dtype, Nd4jLong *data, int length) {
     return nullptr;
 }
@@ -2744,7 +2802,12 @@ Nd4jPointer NativeOps::shapeBufferForNumpy(Nd4jPointer npyArray) {
     } else {
         shapeBuffer = nd4j::ShapeBuilders::createShapeInfo(dtype, arr.fortranOrder ? 'f' : 'c', shape);
     }
-    return reinterpret_cast<Nd4jPointer>(nd4j::ConstantShapeHelper::getInstance()->createFromExisting(shapeBuffer, true));
+    // pinned until releaseShapeInfo() call
+    EpochGuard guard;
+
+    auto result = nd4j::ConstantShapeHelper::getInstance()->createFromExisting(shapeBuffer, true);
+    nd4j::ConstantShapeHelper::retain(result);
+    return reinterpret_cast<Nd4jPointer>(result);
 }
 
 void NativeOps::sortByKey(Nd4jPointer *extraPointers,
@@ -2815,7 +2878,39 @@ const char* NativeOps::runLightBenchmarkSuit(bool printOut) {
 }
 
 Nd4jLong NativeOps::getCachedMemory(int deviceId) {
-    return nd4j::ConstantHelper::getInstance()->getCachedAmount(deviceId);
+    return nd4j::ConstantHelper::getInstance()->getCachedAmount(deviceId) + nd4j::memory::CachingHostAllocator::getInstance()->cachedBytes();
+}
+
+void NativeOps::setShapeCacheLimit(Nd4jLong numBytes) {
+    nd4j::Environment::getInstance()->setShapeCacheLimit(numBytes);
+}
+
+void NativeOps::setTadCacheLimit(Nd4jLong numBytes) {
+    nd4j::Environment::getInstance()->setTadCacheLimit(numBytes);
+}
+
+Nd4jLong NativeOps::getShapeCacheHits() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong NativeOps::getShapeCacheMisses() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong NativeOps::getShapeCacheEvictions() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheEvictions();
+}
+
+Nd4jLong NativeOps::getTadCacheHits() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong NativeOps::getTadCacheMisses() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong NativeOps::getTadCacheEvictions() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheEvictions();
 }
 
 const char* NativeOps::runFullBenchmarkSuit(bool printOut) {
@@ -49,6 +49,9 @@ using namespace nd4j;
 #include <loops/special_kernels.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
+#include <memory/CachingHostAllocator.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <helpers/ConstantTadHelper.h>
 
 cudaDeviceProp *deviceProperties;
 cudaFuncAttributes *funcAttributes = new cudaFuncAttributes[64];
@@ -3238,9 +3241,19 @@ int NativeOps::dataTypeFromNpyHeader(void *header) {
 nd4j::ConstantDataBuffer* NativeOps::shapeBuffer(int rank, Nd4jLong *shape, Nd4jLong *strides, nd4j::DataType dtype, char order, Nd4jLong ews, bool empty) {
     auto buffer = new ConstantDataBuffer();
     *buffer = nd4j::ConstantShapeHelper::getInstance()->bufferForShapeInfo(ShapeDescriptor(dtype, order, shape, strides, rank, ews, empty));
+    nd4j::ConstantShapeHelper::retain(buffer->primaryAsT<Nd4jLong>());
     return buffer;
 }
 
+void NativeOps::deleteShapeBuffer(nd4j::ConstantDataBuffer* ptr) {
+    nd4j::ConstantShapeHelper::release(ptr->primaryAsT<Nd4jLong>());
+    delete ptr;
+}
+
+void NativeOps::releaseShapeInfo(Nd4jPointer shapeInfo) {
+    nd4j::ConstantShapeHelper::release(reinterpret_cast<Nd4jLong *>(shapeInfo));
+}
+
 nd4j::ConstantDataBuffer* NativeOps::constantBuffer(nd4j::DataType dtype, Nd4jLong *data, int length) {
     return nd4j::ConstantHelper::getInstance()->constantBuffer(ConstantDescriptor(data, length), dtype);
 }
@@ -3279,7 +3292,9 @@ Nd4jPointer NativeOps::shapeBufferForNumpy(Nd4jPointer npyArray) {
     } else {
         shapeBuffer = nd4j::ShapeBuilders::createShapeInfo(dtype, arr.fortranOrder ? 'f' : 'c', shape);
     }
-    return reinterpret_cast<Nd4jPointer>(nd4j::ConstantShapeHelper::getInstance()->createFromExisting(shapeBuffer, true));
+    auto result = nd4j::ConstantShapeHelper::getInstance()->createFromExisting(shapeBuffer, true);
+    nd4j::ConstantShapeHelper::retain(result);
+    return reinterpret_cast<Nd4jPointer>(result);
 }
 
 const char* NativeOps::runLightBenchmarkSuit(bool printOut) {
@@ -3311,5 +3326,37 @@ const char* NativeOps::runFullBenchmarkSuit(bool printOut) {
 }
 
 Nd4jLong NativeOps::getCachedMemory(int deviceId) {
-    return nd4j::ConstantHelper::getInstance()->getCachedAmount(deviceId);
+    return nd4j::ConstantHelper::getInstance()->getCachedAmount(deviceId) + nd4j::memory::CachingHostAllocator::getInstance()->cachedBytes();
+}
+
+void NativeOps::setShapeCacheLimit(Nd4jLong numBytes) {
+    nd4j::Environment::getInstance()->setShapeCacheLimit(numBytes);
+}
+
+void NativeOps::setTadCacheLimit(Nd4jLong numBytes) {
+    nd4j::Environment::getInstance()->setTadCacheLimit(numBytes);
+}
+
+Nd4jLong NativeOps::getShapeCacheHits() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong NativeOps::getShapeCacheMisses() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong NativeOps::getShapeCacheEvictions() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheEvictions();
+}
+
+Nd4jLong NativeOps::getTadCacheHits() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong NativeOps::getTadCacheMisses() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong NativeOps::getTadCacheEvictions() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheEvictions();
 }
\ No newline at end of file
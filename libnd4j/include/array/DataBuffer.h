@@ -28,6 +28,9 @@
 #include <pointercast.h>
 #include <array/DataType.h>
 #include <memory/Workspace.h>
+#include <memory/HugePages.h>
+#include <memory/CachingHostAllocator.h>
+#include <Environment.h>
 #include <execution/LaunchContext.h>
 
 namespace nd4j {
@@ -43,6 +46,7 @@ class ND4J_EXPORT DataBuffer {
         memory::Workspace* _workspace;
         bool _isOwnerPrimary;
         bool _isOwnerSpecial;
+        bool _isCachedPrimary = false;
 
     #ifdef __CUDABLAS__
         mutable std::atomic<Nd4jLong> _counter;
@@ -238,11 +242,13 @@ DataBuffer::DataBuffer(DataBuffer&& other) {
     _workspace      = other._workspace;
     _isOwnerPrimary = other._isOwnerPrimary;
     _isOwnerSpecial = other._isOwnerSpecial;
+    _isCachedPrimary = other._isCachedPrimary;
 
     copyCounters(other);
 
     other._primaryBuffer = other._specialBuffer = nullptr;
     other.setAllocFlags(false, false);
+    other._isCachedPrimary = false;
     other._lenInBytes = 0;
 }
 
@@ -281,11 +287,13 @@ DataBuffer& DataBuffer::operator=(DataBuffer&& other) noexcept {
     _workspace      = other._workspace;
     _isOwnerPrimary = other._isOwnerPrimary;
     _isOwnerSpecial = other._isOwnerSpecial;
+    _isCachedPrimary = other._isCachedPrimary;
 
     copyCounters(other);
 
     other._primaryBuffer = other._specialBuffer = nullptr;
     other.setAllocFlags(false, false);
+    other._isCachedPrimary = false;
     other._lenInBytes = 0;
 
     return *this;
@@ -327,7 +335,22 @@ T* DataBuffer::specialAsT() {
 void DataBuffer::allocatePrimary() {
 
     if (_primaryBuffer == nullptr && getLenInBytes() > 0) {
-        ALLOCATE(_primaryBuffer, _workspace, getLenInBytes(), int8_t);
+        // large buffers outside of workspaces might be backed by huge pages, they're zero-filled already
+        if (_workspace == nullptr && memory::HugePages::isEligible(getLenInBytes()))
+            _primaryBuffer = memory::HugePages::allocate(getLenInBytes());
+
+        // smaller ones are taken from host cache, and have to be zeroed here. Leaks detector has to see every allocation though
+        _isCachedPrimary = false;
+        if (_primaryBuffer == nullptr && _workspace == nullptr && Environment::getInstance()->isHostCache() && !Environment::getInstance()->isDetectingLeaks()) {
+            _primaryBuffer = memory::CachingHostAllocator::getInstance()->allocate(getLenInBytes());
+            memset(_primaryBuffer, 0, getLenInBytes());
+            _isCachedPrimary = true;
+        }
+
+        if (_primaryBuffer == nullptr) {
+            ALLOCATE(_primaryBuffer, _workspace, getLenInBytes(), int8_t);
+        }
+
         _isOwnerPrimary = true;
     }
 }
@@ -344,9 +367,14 @@ void DataBuffer::deletePrimary() {
 
     if(_isOwnerPrimary && _primaryBuffer != nullptr && getLenInBytes() != 0) {
         auto p = reinterpret_cast<int8_t*>(_primaryBuffer);
-        RELEASE(p, _workspace);
+        if (_isCachedPrimary) {
+            memory::CachingHostAllocator::getInstance()->release(p);
+        } else if (_workspace != nullptr || !memory::HugePages::release(p)) {
+            RELEASE(p, _workspace);
+        }
         _primaryBuffer = nullptr;
         _isOwnerPrimary = false;
+        _isCachedPrimary = false;
     }
 }
 
@@ -78,6 +78,9 @@ class ND4J_EXPORT ShapeDescriptor {
         // less than operator
         bool operator<(const ShapeDescriptor &other) const;
 
+        // hash over all fields compared by equal to operator
+        Nd4jLong hash() const;
+
         Nd4jLong* toShapeInfo() const;
 
 
@@ -51,6 +51,9 @@ namespace nd4j {
         // less than operator
         bool operator<(const TadDescriptor &other) const;
 
+        // hash over all fields compared by equal to operator
+        Nd4jLong hash() const;
+
         std::vector<int>& axis();
         ShapeDescriptor& originalShape();
         bool areUnitiesinShape() const;
@@ -22,18 +22,31 @@
 #define DEV_TESTS_TADPACK_H
 
 #include "ConstantDataBuffer.h"
+#include <atomic>
 
 namespace nd4j {
     class ND4J_EXPORT TadPack {
     private:
         ConstantDataBuffer _tadShape;
         ConstantDataBuffer _tadOffsets;
-        Nd4jLong _numTads;
+        Nd4jLong _numTads = 0;
         int _shapeInfoLength;
+
+        // number of TadPack instances sharing these buffers, if they're evictable from cache
+        std::atomic<Nd4jLong> *_pins = nullptr;
     public:
-        explicit TadPack(ConstantDataBuffer &shapes, ConstantDataBuffer &offets, Nd4jLong numTads);
+        explicit TadPack(ConstantDataBuffer &shapes, ConstantDataBuffer &offets, Nd4jLong numTads, std::atomic<Nd4jLong> *pins = nullptr);
         TadPack() = default;
-        ~TadPack() = default;
+        TadPack(const TadPack &other);
+        ~TadPack();
+
+        TadPack& operator=(const TadPack &other);
+
+        /**
+         * This method returns number of TadPack instances sharing buffers of this one, or 0 if buffers aren't evictable
+         */
+        Nd4jLong pins() const;
+        std::atomic<Nd4jLong>* pinsCounter() const;
 
         Nd4jLong* primaryShapeInfo() const;
         Nd4jLong* primaryOffsets() const;
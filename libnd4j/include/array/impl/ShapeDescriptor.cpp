@@ -54,6 +54,32 @@ bool ShapeDescriptor::operator<(const ShapeDescriptor& other) const {
     return std::tie(_empty, _rank, _dataType, _ews, _order, _shape, _strides) < std::tie(other._empty, other._rank, other._dataType, other._ews, other._order, other._shape, other._strides);
 }
 
+//////////////////////////////////////////////////////////////////////////
+Nd4jLong ShapeDescriptor::hash() const {
+    uint64_t h = static_cast<uint64_t>(_rank);
+    auto mix = [&h](uint64_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+
+    mix(static_cast<uint64_t>(_empty));
+    mix(static_cast<uint64_t>(_order));
+    mix(static_cast<uint64_t>(_dataType));
+    mix(static_cast<uint64_t>(_ews));
+
+    for (auto v : _shape)
+        mix(static_cast<uint64_t>(v));
+
+    for (auto v : _strides)
+        mix(static_cast<uint64_t>(v));
+
+    // final avalanche, so both low and high bits are usable
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return static_cast<Nd4jLong>(h);
+}
+
 Nd4jLong* ShapeDescriptor::toShapeInfo() const {
     if (_empty) {
         if (_rank == 0)
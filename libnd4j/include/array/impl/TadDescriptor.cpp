@@ -61,6 +61,20 @@ namespace nd4j {
         return std::tie(_originalShape, _axis, _unitiesInShape) < std::tie(other._originalShape, other._axis, other._unitiesInShape);
     }
 
+    Nd4jLong TadDescriptor::hash() const {
+        uint64_t h = static_cast<uint64_t>(_originalShape.hash());
+
+        for (auto v : _axis)
+            h = (h ^ static_cast<uint64_t>(v)) * 0x100000001b3ULL;
+
+        h = (h ^ static_cast<uint64_t>(_unitiesInShape)) * 0x100000001b3ULL;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+
+        return static_cast<Nd4jLong>(h);
+    }
+
     std::vector<int>& TadDescriptor::axis() {
         return _axis;
     }
@@ -23,10 +23,55 @@
 #include <helpers/shape.h>
 
 namespace nd4j {
-    TadPack::TadPack(ConstantDataBuffer &shapes, ConstantDataBuffer &offets, Nd4jLong numTads) {
+    TadPack::TadPack(ConstantDataBuffer &shapes, ConstantDataBuffer &offets, Nd4jLong numTads, std::atomic<Nd4jLong> *pins) {
         _tadShape = shapes;
         _tadOffsets = offets;
         _numTads = numTads;
+        _pins = pins;
+
+        if (_pins != nullptr)
+            _pins->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TadPack::TadPack(const TadPack &other) {
+        _tadShape = other._tadShape;
+        _tadOffsets = other._tadOffsets;
+        _numTads = other._numTads;
+        _pins = other._pins;
+
+        if (_pins != nullptr)
+            _pins->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TadPack::~TadPack() {
+        if (_pins != nullptr)
+            _pins->fetch_sub(1, std::memory_order_release);
+    }
+
+    TadPack& TadPack::operator=(const TadPack &other) {
+        if (this == &other)
+            return *this;
+
+        if (other._pins != nullptr)
+            other._pins->fetch_add(1, std::memory_order_relaxed);
+
+        if (_pins != nullptr)
+            _pins->fetch_sub(1, std::memory_order_release);
+
+        _tadShape = other._tadShape;
+        _tadOffsets = other._tadOffsets;
+        _numTads = other._numTads;
+        _pins = other._pins;
+
+        return *this;
+    }
+
+    Nd4jLong TadPack::pins() const {
+        return _pins == nullptr ? 0L : _pins->load(std::memory_order_acquire);
+    }
+
+    std::atomic<Nd4jLong>* TadPack::pinsCounter() const {
+        return _pins;
     }
 
     Nd4jLong* TadPack::primaryShapeInfo() const {
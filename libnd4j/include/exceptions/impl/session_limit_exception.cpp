@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/StringUtils.h>
+#include <exceptions/session_limit_exception.h>
+
+namespace nd4j {
+    session_limit_exception::session_limit_exception(Nd4jLong graphId) : graph_exception(StringUtils::buildGraphErrorMessage("Number of streaming sessions reached its limit", graphId), graphId) {
+        _graphId = graphId;
+    }
+}
@@ -70,6 +70,9 @@ namespace nd4j {
             std::vector<NDArray*> _fastpath_in;
             std::vector<NDArray*> _fastpath_out;
             std::vector<NDArray*> _handles;
+
+            // number of input arrays/variables requested from this Context
+            Nd4jLong _inputAccesses = 0L;
         public:
             Context(ContextPrototype* prototype, VariableSpace* variableSpace);
 
@@ -145,6 +148,14 @@ namespace nd4j {
             Variable* getVariable(int idx);
             Variable* variable(int idx);
 
+            /**
+             * This method resolves variable for a given input index via dense slot, if Graph assigned one,
+             * without debug output and without counting it as input access
+             * @param idx
+             * @return
+             */
+            Variable* inputVariable(int idx);
+
             /**
              * This method is shortcut to getVariable(int idx);
              *
@@ -164,6 +175,13 @@ namespace nd4j {
             Variable* variable(std::pair<int,int>& p);
             Variable* variable(std::initializer_list<int> p);
 
+            /**
+             * These methods track input arrays requested via array()/getVariable(),
+             * so we can tell if shape function depends on input values, not only on input shapes
+             */
+            Nd4jLong inputAccesses();
+            void resetInputAccesses();
+
 
             void pushNDArrayToVariableSpace(int nodeId, int index, NDArray* array, bool removable = true);
             void pushNDArrayToVariableSpace(std::pair<int, int>& pair, NDArray* array, bool removable = true);
@@ -35,6 +35,10 @@ namespace nd4j {
         protected:
             // int ids of the input nodes
             std::vector<std::pair<int, int>> _inputs;
+
+            // dense VariableSpace slots of the inputs, assigned by Graph
+            std::vector<int> _inputSlots;
+
             int _nodeId;
             std::vector<double> _tArgs;
             std::vector<int> _iArgs;
@@ -79,6 +83,13 @@ namespace nd4j {
             void fillInputs(std::vector<int>& inputs);
             std::vector<std::pair<int, int>>* inputs();
 
+            /**
+             * This method sets dense slots for inputs, so they can be resolved without map lookups.
+             * Slots are only valid for VariableSpace these were attached to by Graph.
+             */
+            void setInputSlots(const std::vector<int>& slots);
+            std::vector<int>* inputSlots();
+
             std::vector<double>* getTArguments();
             std::vector<int>* getIArguments();
             std::vector<bool>* getBArguments();
@@ -36,6 +36,23 @@ namespace nd4j {
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
             static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+
+            /**
+             * This method returns NDArray pointing directly to FlatArray buffer, without copying it.
+             * If byte order, alignment or data type don't allow that - array is copied, same as fromFlatArray() does
+             *
+             * PLEASE NOTE: FlatBuffer must outlive returned array
+             */
+            static NDArray* fromFlatArrayView(const nd4j::graph::FlatArray* flatArray);
+
+            /**
+             * This method serializes NDArray into FlatArray, writing data directly into space reserved within FlatBufferBuilder.
+             * Dense arrays are copied with single memcpy, strided views are gathered into 'c' order with single pass,
+             * so no intermediate copies are made.
+             *
+             * Data is aligned to element size, so fromFlatArrayView() can use it in place
+             */
+            static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array);
         };
     }
 }
@@ -22,6 +22,7 @@
 #define LIBND4J_FLOWPATH_H
 
 #include <map>
+#include <vector>
 #include <pointercast.h>
 #include <graph/NodeState.h>
 #include <graph/FrameState.h>
@@ -32,17 +33,27 @@ namespace nd4j {
     namespace graph {
         class ND4J_EXPORT FlowPath {
         private:
-            std::map<int, NodeState> _states;
+            // node ids are dense enough to index states directly, anything else goes to map
+            std::vector<NodeState> _states;
+            std::map<int, NodeState> _sparse;
             std::map<Nd4jLong, FrameState> _frames;
 
-            void ensureNode(int nodeId);
+            NodeState& ensureNode(int nodeId);
             void ensureFrame(int nodeId);
 
             GraphProfile _profile;
         public:
+            static const int MAX_DENSE_ID = 65536;
+
             FlowPath() = default;
             ~FlowPath() = default;
 
+            /**
+             * This method creates NodeState for given node, if it wasn't created before.
+             * Once registered, state of this node can be updated concurrently with other registered nodes
+             */
+            void registerNode(int nodeId);
+
             void setInnerTime(int nodeId, Nd4jLong time);
             void setOuterTime(int nodeId, Nd4jLong time);
 
@@ -58,6 +69,13 @@ namespace nd4j {
             int branch(int nodeId);
             void markBranch(int nodeId, int index);
 
+            /**
+             * Frame id propagated to the node during this execution. Nodes are shared between sessions,
+             * so frames are tracked here, and Node::getFrameId() holds only frame id defined by graph itself
+             */
+            Nd4jLong frameId(int nodeId);
+            void setFrameId(int nodeId, Nd4jLong frameId);
+
             // Frame-related methods
 
             void registerFrame(Nd4jLong frameId);
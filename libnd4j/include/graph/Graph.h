@@ -24,12 +24,16 @@
 #include <list>
 #include <algorithm>
 #include <map>
+#include <memory>
 //#include <NDArray.h>
 #include <graph/Node.h>
 #include <graph/Stash.h>
 #include <graph/Scope.h>
 #include <graph/Variable.h>
 #include <graph/VariableSpace.h>
+#include <graph/MemoryPlan.h>
+#include <graph/MappedFile.h>
+#include <graph/GraphOptimizer.h>
 #include <graph/generated/node_generated.h>
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
@@ -58,6 +62,39 @@ namespace nd4j {
 
             std::mutex _mutexPreprocessing;
             std::atomic<bool> _built;
+            std::atomic<bool> _frozen{false};
+
+            // if this Graph is a session - it shares nodes, onion and scopes with original Graph
+            Graph* _origin = nullptr;
+
+            // optional reference to original Graph, keeping it alive as long as this session exists
+            std::shared_ptr<Graph> _originHandle;
+
+            // static memory plan for intermediate arrays, built after first planned execution
+            std::atomic<bool> _memoryPlanning{false};
+            std::atomic<MemoryPlan*> _memoryPlan{nullptr};
+
+            // optimization passes are applied only once
+            std::atomic<bool> _optimized{false};
+            OptimizationStats _optimizationStats;
+
+            std::atomic<Nd4jLong> _warmUpTime{-1L};
+
+            // TRUE for warm-up session with made up placeholder dims: its array sizes don't match real requests
+            bool _syntheticInputs = false;
+
+            // NUMA node this session is bound to, -1 if none
+            int _numaNode = -1;
+
+            // per-node copies of VariableSpace, used by NUMA-bound sessions if replication is enabled
+            std::map<int, VariableSpace*> _replicas;
+            std::mutex _mutexReplicas;
+
+            // dense VariableSpace slots for node inputs, shared with sessions
+            std::map<std::pair<int, int>, int> _slots;
+
+            // memory-mapped FlatBuffers file, if arrays of this Graph point directly into it
+            MappedFile* _mappedFile = nullptr;
 
             std::vector<int> _output;
             std::vector<int> _autos;
@@ -79,8 +116,14 @@ namespace nd4j {
 
             void prepareOutputs();
 
+            // assigns dense slot to each distinct node input, and attaches slots to VariableSpace
+            void assignSlots();
+
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            /**
+             * @param zeroCopy - if TRUE, arrays will point directly to FlatGraph buffers whenever possible, so FlatGraph must outlive this Graph
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, bool zeroCopy = false);
 
             ~Graph();
 
@@ -192,6 +235,112 @@ namespace nd4j {
              */
             Graph* cloneWithProxy();
 
+            /**
+             * This method returns lightweight session of this Graph, suitable for a single execution.
+             * Nodes, onion and scopes are shared with this Graph, and only VariableSpace (backed by VariableProxy)
+             * and ExecutorConfiguration belong to the session.
+             *
+             * If NUMA node is given, session is executed by thread pinned to that node, and with NUMA replication enabled
+             * session reads variables from replica allocated on that node.
+             *
+             * PLEASE NOTE: Graph is built & frozen on first call, nodes can't be added to it after that
+             */
+            Graph* createSession(int numaNode = -1);
+
+            /**
+             * This method returns NUMA node this session is bound to, or -1
+             */
+            int numaNode();
+
+            /**
+             * This method returns TRUE if this Graph was created via createSession()
+             */
+            bool isSession();
+
+            /**
+             * This method makes this session hold reference to original Graph, so original Graph is released only after this session
+             */
+            void retainOrigin(std::shared_ptr<Graph> origin);
+
+            /**
+             * This method returns copy of VariableSpace with arrays allocated on given NUMA node. Copy is created once per node.
+             */
+            VariableSpace* replicaOf(int node);
+
+            /**
+             * This method enables static memory planning for this Graph: after first sequential execution
+             * intermediate arrays get fixed offsets within single arena, and arrays with non-overlapping lifetimes share memory.
+             *
+             * PLEASE NOTE: only graph outputs are guaranteed to be valid after planned execution
+             */
+            void setMemoryPlanning(bool reallyPlan);
+            bool isMemoryPlanning();
+
+            /**
+             * This method returns memory plan of this Graph, or nullptr if plan wasn't built yet
+             */
+            MemoryPlan* getMemoryPlan();
+
+            /**
+             * This method builds memory plan using arrays produced by execution of this Graph within given VariableSpace.
+             * Plan is built only once, and it's shared by all sessions of this Graph
+             */
+            MemoryPlan* buildMemoryPlan(VariableSpace *variableSpace);
+
+            /**
+             * This method stores estimates of memory plan into given MemoryReport. Returns FALSE if plan wasn't built yet
+             */
+            bool reportMemoryPlan(nd4j::memory::MemoryReport &report);
+
+            /**
+             * This method returns IDs of output nodes of this Graph
+             */
+            std::vector<int>* getOutputIds();
+
+            /**
+             * This method applies optimization passes (see GraphOptimizer) to this Graph.
+             * Graph is optimized only once, and only before its first session is created
+             */
+            OptimizationStats optimize();
+            bool isOptimized();
+
+            /**
+             * This method returns results of optimization passes applied to this Graph
+             */
+            OptimizationStats getOptimizationStats();
+
+            /**
+             * This method executes single session of this Graph, with placeholders filled with zeros of declared shapes
+             * (unknown dimensions are set to 1), so graph build and shape functions are resolved before first real request.
+             * Memory plan and workspace footprint are recorded only if all placeholder dimensions are known, otherwise
+             * first real request records them.
+             *
+             * @return warm-up time in microseconds, or -1 if warm-up failed
+             */
+            Nd4jLong warmUp();
+
+            /**
+             * This method returns time spent in last warm-up, in microseconds, or -1 if there was no successful warm-up
+             */
+            Nd4jLong getWarmUpTime();
+
+            /**
+             * These methods mark session which placeholders have made up shapes. Such sessions don't build memory plan
+             * and don't record memory footprint
+             */
+            void markSyntheticInputs(bool reallySynthetic);
+            bool hasSyntheticInputs();
+
+            /**
+             * This method removes given node from the Graph structure. Variables produced by this node are kept in VariableSpace
+             */
+            void removeNode(int nodeId);
+
+            /**
+             * This method passes ownership of memory-mapped file to this Graph, so file is unmapped only after all arrays are released
+             */
+            void attachMappedFile(MappedFile *file);
+
             /**
              * This method removes reference to VariableSpace from this Graph
              */
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_GRAPHBATCHER_H
+#define LIBND4J_GRAPHBATCHER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <graph/Graph.h>
+#include <graph/generated/request_generated.h>
+#include <graph/generated/result_generated.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Per-graph batching statistics
+         */
+        class ND4J_EXPORT BatchingStats {
+        public:
+            // total number of inference requests received
+            Nd4jLong requests = 0L;
+
+            // number of batched graph executions
+            Nd4jLong batches = 0L;
+
+            // number of requests served within batches
+            Nd4jLong batchedRequests = 0L;
+
+            // number of requests executed on their own
+            Nd4jLong singleRequests = 0L;
+
+            // largest batch executed so far
+            Nd4jLong largestBatch = 0L;
+
+            BatchingStats() = default;
+            ~BatchingStats() = default;
+
+            /**
+             * This method returns average number of requests per batched execution
+             */
+            double averageBatchSize() const;
+        };
+
+        /**
+         * This class provides dynamic batching of inference requests for graphs stored in GraphHolder.
+         *
+         * Concurrent requests to the same graph are queued for up to maxDelay microseconds (or until maxBatchSize requests
+         * are queued), their inputs get concatenated along dimension 0, graph is executed once, and outputs are split
+         * back to callers. Requests with inputs not compatible with the rest of the batch are executed on their own.
+         *
+         * PLEASE NOTE: batching is disabled by default, so execute() just calls GraphHolder::execute() until maxBatchSize > 1 is set
+         */
+        class ND4J_EXPORT GraphBatcher {
+        private:
+            static GraphBatcher* _INSTANCE;
+
+            class PendingRequest;
+
+            std::atomic<int> _maxBatchSize{1};
+            std::atomic<Nd4jLong> _maxDelay{1000L};
+
+            std::mutex _mutex;
+            std::condition_variable _condition;
+
+            std::map<Nd4jLong, std::deque<PendingRequest*>> _queues;
+            std::map<Nd4jLong, BatchingStats> _stats;
+
+            GraphBatcher() = default;
+            ~GraphBatcher() = default;
+
+            void executeBatch(Nd4jLong graphId, std::vector<PendingRequest*> &batch);
+        public:
+            static GraphBatcher* getInstance();
+
+            /**
+             * This method sets max number of requests executed at once. Values < 2 disable batching
+             */
+            void setMaxBatchSize(int numRequests);
+            int maxBatchSize();
+
+            /**
+             * This method sets max time (in microseconds) request can wait in queue for other requests
+             */
+            void setMaxDelay(Nd4jLong microseconds);
+            Nd4jLong maxDelay();
+
+            bool isEnabled();
+
+            /**
+             * This method executes given request, optionally batched with other concurrent requests to the same graph.
+             * Results are always stored into given builder, in the caller thread.
+             *
+             * @param graphId
+             * @param builder
+             * @param request
+             * @return
+             */
+            flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+
+            /**
+             * This method returns batching statistics for given graph
+             */
+            BatchingStats getStats(Nd4jLong graphId);
+
+            /**
+             * This method resets batching statistics for all graphs
+             */
+            void resetStats();
+        };
+    }
+}
+
+
+#endif //LIBND4J_GRAPHBATCHER_H
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_GRAPHCOMPILER_H
+#define LIBND4J_GRAPHCOMPILER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nd4j {
+    class NDArray;
+
+    namespace graph {
+        class Graph;
+        class Node;
+
+        /**
+         * This class compiles fixed-shape Graph ahead-of-time into standalone C++ translation unit.
+         *
+         * Generated code has no Graph, VariableSpace or OpRegistrator involved: each node becomes op instance
+         * with its own fastpath Context, all arrays are statically allocated (intermediates share single arena
+         * laid out by MemoryPlan), and all shapes are baked in as constants.
+         *
+         * PLEASE NOTE: Graph is executed once during compilation, and shapes of that round are final.
+         */
+        class ND4J_EXPORT GraphCompiler {
+        private:
+            static std::string symbolOf(const std::pair<int, int> &pair);
+            static std::string sanitize(const std::string &name);
+
+            // returns C++ class name of the op used by given node
+            static std::string classOf(Node *node);
+
+            static void emitShape(std::ostream &out, const std::string &symbol, Nd4jLong *shapeInfo);
+            static void emitBuffer(std::ostream &out, const std::string &symbol, NDArray *array);
+
+        public:
+            /**
+             * This method returns C++ source executing given Graph.
+             * Generated namespace provides execute(), input(index) and output(index) functions.
+             *
+             * @param graph
+             * @param name - namespace for generated code
+             * @param withMain - if TRUE, main() benchmarking generated code against GraphExecutioner is added
+             * @return
+             */
+            static std::string compile(Graph *graph, const std::string &name, bool withMain = false);
+        };
+    }
+}
+
+
+#endif //LIBND4J_GRAPHCOMPILER_H
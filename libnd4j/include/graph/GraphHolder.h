@@ -20,33 +20,91 @@
 
 #include <helpers/logger.h>
 #include <pointercast.h>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <graph/Graph.h>
-#include <helpers/SimpleReadWriteLock.h>
 #include <exceptions/unknown_graph_exception.h>
 
 namespace nd4j {
     namespace graph {
+        /**
+         * Registry of graphs available for execution.
+         *
+         * Registered graphs are kept in immutable snapshot, which is replaced as a whole on every change,
+         * so lookups never wait for registration, replacement or removal of graphs to complete. Lookups aren't lock-free though:
+         * std::atomic_load/std::atomic_store on shared_ptr use internal lock, held only while the pointer is copied or swapped.
+         * Each request holds reference to the graph it was started with, and replaced or dropped graph is released after its last request finishes.
+         */
         class ND4J_EXPORT GraphHolder {
         private:
+            typedef std::map<Nd4jLong, std::shared_ptr<Graph>> GraphMap;
+
+            /**
+             * Deleter of stored graphs, which can be told to leave graph intact (see forgetGraph)
+             */
+            class GraphDeleter {
+            private:
+                std::shared_ptr<std::atomic<bool>> _owned = std::make_shared<std::atomic<bool>>(true);
+            public:
+                void release() { _owned->store(false); }
+                void operator()(Graph *graph) const { if (_owned->load()) delete graph; }
+            };
+
             static GraphHolder *_INSTANCE;
-            std::map<Nd4jLong, Graph *> _graphF;
 
-            std::map<Nd4jLong, SimpleReadWriteLock> _locks;
+            // current snapshot, always accessed via std::atomic_load/std::atomic_store, which lock internally for the pointer swap only
+            std::shared_ptr<const GraphMap> _graphs = std::shared_ptr<const GraphMap>(new GraphMap());
+
+            // writers are serialized between themselves, readers don't take this lock, so they never wait for graph optimization or warm-up
+            std::mutex _writeLock;
 
             GraphHolder() = default;
             ~GraphHolder() = default;
+
+            std::shared_ptr<const GraphMap> snapshot();
+
+            // should be called under _writeLock
+            void publish(GraphMap *graphs);
+
+            // executes graph once before it's published
+            void warmUp(Nd4jLong graphId, Graph *graph);
         public:
             static GraphHolder* getInstance();
 
+            /**
+             * This method stores given graph under given id. Optimization passes are applied to the graph here, once,
+             * and graph is warmed up (see Graph::warmUp) before it becomes available for requests.
+             * GraphHolder takes ownership of the graph.
+             */
             void registerGraph(Nd4jLong graphId, Graph *graph);
-            
+
+            /**
+             * This method returns reference-counted handle of the graph with given id, or nullptr if there's no such graph.
+             * Graph stays valid as long as handle exists, even if it was replaced or dropped meanwhile.
+             */
+            std::shared_ptr<Graph> acquireGraph(Nd4jLong graphId);
+
+            /**
+             * This method returns new session of the graph with given id. Graph structure is shared with the original one,
+             * so session is cheap to create, and must be deleted after execution.
+             */
             Graph* cloneGraph(Nd4jLong graphId);
 
+            /**
+             * PLEASE NOTE: returned pointer is valid only until graph is replaced or dropped, use acquireGraph() if that's a concern
+             */
             Graph* pullGraph(Nd4jLong graphId);
 
+            /**
+             * This method removes graph from registry, without releasing it
+             */
             void forgetGraph(Nd4jLong graphId);
 
+            /**
+             * This method removes graph from registry. Graph is released once all requests using it are finished
+             */
             void dropGraph(Nd4jLong graphId);
 
             void dropGraphAny(Nd4jLong graphId);
@@ -57,37 +115,11 @@ namespace nd4j {
 
             flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+            /**
+             * This method atomically replaces graph with given id, once new graph is optimized and warmed up.
+             * Requests started before keep using previous graph, and previous graph is released once they're finished.
+             */
             void replaceGraph(Nd4jLong graphId, Graph *graph);
-
-            /////////////////////////////
-
-            FORCEINLINE void lockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockWrite();
-            }
-
-            FORCEINLINE void unlockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockWrite();
-            }
-
-            FORCEINLINE void lockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockRead();
-            }
-
-            FORCEINLINE void unlockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockRead();
-            }
         };
     }
 }
\ No newline at end of file
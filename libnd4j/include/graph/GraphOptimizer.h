@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_GRAPHOPTIMIZER_H
+#define LIBND4J_GRAPHOPTIMIZER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <utility>
+#include <vector>
+
+namespace nd4j {
+    class NDArray;
+
+    namespace ops {
+        class DeclarableOp;
+    }
+
+    namespace graph {
+        class Graph;
+        class Node;
+
+        /**
+         * Results of graph optimization
+         */
+        class ND4J_EXPORT OptimizationStats {
+        public:
+            // number of nodes before & after optimization
+            Nd4jLong nodesBefore = 0L;
+            Nd4jLong nodesAfter = 0L;
+
+            // number of nodes replaced with precomputed constants
+            Nd4jLong foldedNodes = 0L;
+
+            // number of Identity nodes bypassed
+            Nd4jLong collapsedNodes = 0L;
+
+            // number of nodes replaced with equivalent nodes
+            Nd4jLong mergedNodes = 0L;
+
+            // number of nodes absorbed by fused ops, or folded into conv2d weights
+            Nd4jLong fusedNodes = 0L;
+
+            // number of nodes not contributing to graph outputs
+            Nd4jLong deadNodes = 0L;
+
+            OptimizationStats() = default;
+            ~OptimizationStats() = default;
+        };
+
+        /**
+         * This class holds optimization passes applied to Graph before execution:
+         * constant folding, Identity collapsing, common subexpression elimination, operator fusion and dead nodes elimination.
+         *
+         * Graph outputs are never removed, and graphs with LOGIC ops or scopes are left as is.
+         */
+        class ND4J_EXPORT GraphOptimizer {
+        private:
+            static bool isRewritable(Node *node);
+            static bool isRandom(Node *node);
+            static bool isIdentity(Node *node);
+            static bool isOutput(Graph *graph, int nodeId);
+            static bool isEquivalent(Node *first, Node *second);
+
+            // replaces all references to given node output with other node output (or variable)
+            static void replaceInput(Graph *graph, std::pair<int, int> from, std::pair<int, int> to);
+
+            static bool isOp(Node *node, const char *name);
+
+            // returns FusedActivation matching given node, or -1 if it's not an activation
+            static int activationOf(Node *node, double &alpha);
+
+            // returns the only node consuming output of given node, or nullptr
+            static Node* singleConsumer(Graph *graph, Node *node);
+
+            // returns array of CONSTANT variable, or nullptr
+            static NDArray* constantArray(Graph *graph, std::pair<int, int> &pair);
+
+            // stores array as new CONSTANT variable, and returns its id
+            static int putConstant(Graph *graph, NDArray *array);
+
+            // turns consumer into given op over given inputs, and removes producer
+            static void absorb(Graph *graph, Node *producer, Node *consumer, nd4j::ops::DeclarableOp *op, const std::vector<std::pair<int, int>> &inputs, const std::vector<int> &iArgs, const std::vector<double> &tArgs);
+
+            static bool foldBatchNorm(Graph *graph, Node *conv, Node *batchnorm);
+
+        public:
+            /**
+             * This method applies all passes to given Graph
+             */
+            static OptimizationStats optimize(Graph *graph);
+
+            /**
+             * This method executes nodes that depend only on CONSTANT variables, and replaces them with their results
+             * @return number of folded nodes
+             */
+            static int foldConstants(Graph *graph);
+
+            /**
+             * This method connects consumers of Identity nodes directly to Identity inputs
+             * @return number of removed nodes
+             */
+            static int collapseIdentities(Graph *graph);
+
+            /**
+             * This method removes nodes doing exactly the same op over the same inputs as some other node
+             * @return number of removed nodes
+             */
+            static int eliminateCommonSubexpressions(Graph *graph);
+
+            /**
+             * This method merges conv2d/matmul with following biasadd and activation into fused ops, applying them in GEMM epilogue,
+             * and folds inference batchnorm following conv2d into conv2d weights and bias
+             * @return number of removed nodes
+             */
+            static int fuseOperations(Graph *graph);
+
+            /**
+             * This method removes nodes not reachable from explicitly defined graph outputs
+             * @return number of removed nodes
+             */
+            static int eliminateDeadNodes(Graph *graph);
+        };
+    }
+}
+
+
+#endif //LIBND4J_GRAPHOPTIMIZER_H
@@ -31,6 +31,9 @@ namespace nd4j {
         class ND4J_EXPORT InferenceRequest {
         private:
             Nd4jLong _id;
+
+            // streaming session id, 0 for stateless requests
+            Nd4jLong _session = 0L;
             std::vector<Variable*> _variables;
             std::vector<Variable*> _deletables;
 
@@ -48,6 +51,12 @@ namespace nd4j {
             void appendVariable(std::string &name, int id, int index, NDArray *array);
             void appendVariable(Variable *variable);
 
+            /**
+             * This method binds request to streaming session, see StreamingSessions
+             */
+            void setSession(Nd4jLong sessionId);
+            Nd4jLong session();
+
 #ifndef __JAVACPP_HACK__
             flatbuffers::Offset<FlatInferenceRequest> asFlatInferenceRequest(flatbuffers::FlatBufferBuilder &builder);
 #endif
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class provides file contents as memory-mapped region, so FlatBuffers graph can be used without reading it into heap.
+         * Mapping is private & copy-on-write: pages are shared between processes unless some array is modified in place.
+         *
+         * PLEASE NOTE: if mmap isn't available (i.e. on Windows), file is just read into heap
+         */
+        class ND4J_EXPORT MappedFile {
+        private:
+            uint8_t* _data = nullptr;
+            Nd4jLong _length = 0L;
+            bool _mapped = false;
+
+        public:
+            explicit MappedFile(const char *filename);
+            ~MappedFile();
+
+            MappedFile(const MappedFile& other) = delete;
+            MappedFile& operator=(const MappedFile& other) = delete;
+
+            /**
+             * This method returns pointer to the beginning of the file
+             */
+            uint8_t* data();
+
+            /**
+             * This method returns file length, in bytes
+             */
+            Nd4jLong length();
+
+            /**
+             * This method returns TRUE if file is memory-mapped, and FALSE if it was read into heap
+             */
+            bool isMapped();
+        };
+    }
+}
+
+
+#endif //LIBND4J_MAPPEDFILE_H
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <map>
+#include <utility>
+#include <pointercast.h>
+#include <dll.h>
+#include <memory/MemoryReport.h>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+        class VariableSpace;
+
+        /**
+         * This class holds static memory plan for intermediate arrays of a Graph.
+         *
+         * Lifetime of each intermediate array is defined by onion layers: from the layer of the producer node,
+         * to the layer of the last consumer node. Arrays with non-overlapping lifetimes share the same region
+         * of a single arena, so all intermediates of one execution round fit into getPeakBytes() bytes.
+         *
+         * PLEASE NOTE: sizes are taken from arrays produced by the executed round, so arrays that don't fit
+         * into planned regions later on are allocated as usual
+         */
+        class ND4J_EXPORT MemoryPlan {
+        protected:
+            // offset & size of each planned array, in bytes
+            std::map<std::pair<int, int>, std::pair<Nd4jLong, Nd4jLong>> _regions;
+
+            Nd4jLong _peak = 0L;
+            Nd4jLong _total = 0L;
+
+        public:
+            static const Nd4jLong ALIGNMENT = 64;
+
+            MemoryPlan() = default;
+            ~MemoryPlan() = default;
+
+            /**
+             * This method builds plan for given Graph, using arrays stored in given VariableSpace after execution.
+             * Graphs with LOGIC ops or scopes get empty plan, since their execution order isn't defined by onion.
+             *
+             * @param graph
+             * @param variableSpace
+             * @return
+             */
+            static MemoryPlan* build(Graph *graph, VariableSpace *variableSpace);
+
+            /**
+             * This method returns TRUE if array with given ID has region assigned
+             */
+            bool isPlanned(const std::pair<int, int> &pair) const;
+
+            /**
+             * This method returns offset of planned array within arena, or -1 if array isn't planned
+             */
+            Nd4jLong offset(const std::pair<int, int> &pair) const;
+
+            /**
+             * This method returns number of bytes reserved for planned array, or 0 if array isn't planned
+             */
+            Nd4jLong size(const std::pair<int, int> &pair) const;
+
+            /**
+             * This method returns number of arrays with regions assigned
+             */
+            int numberOfArrays() const;
+
+            /**
+             * This method returns arena size required for this plan
+             */
+            Nd4jLong getPeakBytes() const;
+
+            /**
+             * This method returns number of bytes planned arrays would take without memory reuse
+             */
+            Nd4jLong getTotalBytes() const;
+
+            /**
+             * This method stores planner estimates in given MemoryReport
+             */
+            void report(nd4j::memory::MemoryReport &report) const;
+        };
+    }
+}
+
+
+#endif //LIBND4J_MEMORYPLAN_H
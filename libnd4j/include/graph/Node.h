@@ -166,6 +166,12 @@ namespace nd4j {
             bool hasBlockAttached();
 
             void setCustomOp(nd4j::ops::DeclarableOp *customOp = nullptr);
+
+            /**
+             * This method swaps op executed by this node, i.e. for its fused equivalent. Inputs and arguments are kept as is.
+             * @param customOp - registered op, it won't be deleted by this node
+             */
+            void replaceCustomOp(nd4j::ops::DeclarableOp *customOp);
             nd4j::ops::DeclarableOp* getCustomOp();
             bool hasCustomOp();
 
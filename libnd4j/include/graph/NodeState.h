@@ -42,6 +42,9 @@ namespace nd4j {
             // active divergence branch
             int _branch = 0;
 
+            // frame this node was executed within, if it wasn't defined by graph itself
+            Nd4jLong _frameId = -1;
+
             int _id = 0;
         public:
             NodeState(int id = 0);
@@ -61,6 +64,9 @@ namespace nd4j {
 
             bool wasExecuted();
             void markExecuted(bool wasExecuted);
+
+            Nd4jLong frameId();
+            void setFrameId(Nd4jLong frameId);
         };
     }
 }
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_STREAMINGSESSIONS_H
+#define LIBND4J_STREAMINGSESSIONS_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <NDArray.h>
+#include <graph/generated/graph_generated.h>
+#include <graph/generated/request_generated.h>
+#include <graph/generated/result_generated.h>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+
+        /**
+         * This class keeps state of streaming inference sessions for graphs stored in GraphHolder.
+         *
+         * For each graph, state is defined as a set of node outputs (i.e. LSTM/GRU hidden state) which are fed back into
+         * given input variables on the next request of the same session. So client sends only new chunk of the sequence
+         * with each request, instead of full context. Requests with FlatInferenceRequest.session != 0 are routed here.
+         *
+         * Requests within single session are executed one by one, and sessions idle for longer than time-to-live are evicted.
+         * Sessions are created only for graphs with state defined, and number of live sessions is limited.
+         * If request provides state input explicitly - it overrides stored state.
+         */
+        class ND4J_EXPORT StreamingSessions {
+        private:
+            static StreamingSessions* _INSTANCE;
+
+            class Session;
+
+            std::mutex _mutex;
+
+            // for each graph: node output -> input variable it's fed into on next request
+            std::map<Nd4jLong, std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>>> _states;
+
+            // (graph id, session id) -> session
+            std::map<std::pair<Nd4jLong, Nd4jLong>, std::shared_ptr<Session>> _sessions;
+
+            // time to live, in microseconds
+            std::atomic<Nd4jLong> _ttl{60000000L};
+            std::atomic<Nd4jLong> _lastSweep{0L};
+
+            // max number of live sessions, across all graphs
+            std::atomic<int> _maxSessions{4096};
+
+            StreamingSessions() = default;
+            ~StreamingSessions() = default;
+
+            static Nd4jLong currentTime();
+
+            // evicts expired sessions, if enough time has passed since previous sweep
+            void sweep();
+
+            // moves idle sessions last accessed before threshold out of map, _mutex must be held by caller
+            void collectExpired(Nd4jLong threshold, std::vector<std::shared_ptr<Session>> &released);
+
+            // waits for requests still executing within given sessions, and releases their state
+            static void retire(std::vector<std::shared_ptr<Session>> &released);
+
+            // executes request within session locked by caller
+            flatbuffers::Offset<FlatResult> execute(Session *session, const std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> &states, Graph *run, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+        public:
+            static StreamingSessions* getInstance();
+
+            /**
+             * This method defines state variable for given graph: output of some node, which will be fed into given
+             * input variable on next request of the same session
+             *
+             * @param graphId
+             * @param output - node output, i.e. {nodeId, 1}
+             * @param input - variable to be replaced with stored state, i.e. {-2, 0}
+             */
+            void defineState(Nd4jLong graphId, const std::pair<int, int> &output, const std::pair<int, int> &input);
+
+            /**
+             * This method defines state variables declared in FlatGraph.stateOutputs/stateInputs, replacing previous definitions
+             * for given graph. Graphs without state declared keep their current definitions.
+             *
+             * @param graphId
+             * @param flatGraph
+             */
+            void defineStates(Nd4jLong graphId, const FlatGraph *flatGraph);
+
+            /**
+             * This method removes state definitions, and ends all sessions of given graph
+             */
+            void forgetGraph(Nd4jLong graphId);
+
+            /**
+             * This method sets time (in microseconds) idle session is kept alive
+             */
+            void setTimeToLive(Nd4jLong microseconds);
+            Nd4jLong timeToLive();
+
+            /**
+             * This method sets max number of live sessions. Request opening new session beyond this limit
+             * throws session_limit_exception, after expired sessions were evicted
+             */
+            void setMaxSessions(int numberOfSessions);
+            int maxSessions();
+
+            /**
+             * This method executes given request within given session: stored state is injected as inputs,
+             * and state outputs are stored after execution.
+             *
+             * @param graphId
+             * @param sessionId - non-zero session id
+             * @param builder
+             * @param request
+             * @return
+             */
+            flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, Nd4jLong sessionId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+
+            /**
+             * This method releases state of given session, once requests still executing within it are finished
+             */
+            void endSession(Nd4jLong graphId, Nd4jLong sessionId);
+            bool hasSession(Nd4jLong graphId, Nd4jLong sessionId);
+            int numberOfSessions();
+
+            /**
+             * This method returns copy of stored state for given input of given session, or nullptr if there's none
+             */
+            NDArray* state(Nd4jLong graphId, Nd4jLong sessionId, const std::pair<int, int> &input);
+
+            /**
+             * This method evicts all sessions idle for longer than time-to-live. Sessions with requests in flight are never idle.
+             * @return number of evicted sessions
+             */
+            int evictExpired();
+        };
+    }
+}
+
+
+#endif //LIBND4J_STREAMINGSESSIONS_H
@@ -40,11 +40,17 @@ namespace nd4j {
 
             std::vector<Nd4jLong> _shape;
 
+            // declared data type of placeholder, INHERIT if unknown
+            nd4j::DataType _dtype = nd4j::DataType::INHERIT;
+
             bool _external = false;
             bool _readOnly = false;
             bool _placeholder = false;
             bool _removable = true;
 
+            // constants can't be changed by InferenceRequest, so ops depending only on them can be precomputed
+            bool _constant = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -58,7 +64,10 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            /**
+             * @param zeroCopy - if TRUE, NDArray will point directly to FlatVariable buffer whenever possible
+             */
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
             Variable* clone();
@@ -80,6 +89,7 @@ namespace nd4j {
             bool isRemovable();
 
             bool isPlaceholder();
+            bool isConstant();
 
             VariableType variableType();
             void setVariableType(VariableType variableType);
@@ -94,6 +104,7 @@ namespace nd4j {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markConstant(bool reallyConstant);
 
             int id();
             int index();
@@ -106,6 +117,11 @@ namespace nd4j {
 
             std::vector<Nd4jLong>& shape();
 
+            /**
+             * This method returns data type of the array, or declared data type if there's no array yet
+             */
+            nd4j::DataType dataType();
+
 #ifndef __JAVACPP_HACK__
             /**
              * This method returns offset to this Variable in FlatBuffer
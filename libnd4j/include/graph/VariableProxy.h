@@ -52,6 +52,7 @@ namespace nd4j {
             virtual nd4j::graph::Variable *getVariable(std::string *symbol);
 
             virtual std::vector<Variable*> getVariables();
+            virtual int nextExternalId();
 
             virtual void putVariable(std::pair<int,int>& pair, NDArray *array);
             virtual void putVariable(std::pair<int,int>& pair, Variable *variable);
@@ -80,6 +81,9 @@ namespace nd4j {
 
             virtual nd4j::graph::VariableSpace *clone();
 
+            virtual void attachSlots(const std::map<std::pair<int, int>, int>* slots);
+            virtual nd4j::graph::Variable* slotVariable(int slot);
+
             virtual nd4j::graph::Stash* getStash();
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
@@ -34,6 +34,7 @@
 #include <memory/Workspace.h>
 #include <graph/Stash.h>
 #include <graph/FlowPath.h>
+#include <graph/MemoryPlan.h>
 
 
 namespace nd4j {
@@ -67,6 +68,18 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // dense slots assigned by Graph to node inputs, and Variables currently stored in them
+            const std::map<std::pair<int, int>, int>* _slots = nullptr;
+            std::vector<Variable*> _slotted;
+
+            // should be called under _varmap lock
+            void updateSlots(std::pair<int,int>& pair, Variable *variable);
+
+            // arena for arrays with offsets assigned by MemoryPlan
+            MemoryPlan* _memoryPlan = nullptr;
+            int8_t* _arena = nullptr;
+            Nd4jLong _arenaSize = 0L;
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -95,6 +108,16 @@ namespace nd4j {
 
             virtual std::vector<Variable*> getVariables();
 
+            /**
+             * This method returns next free id for external variable, i.e. one below the lowest id in use
+             */
+            virtual int nextExternalId();
+
+            /**
+             * This method returns Variables produced by graph nodes, which have no value assigned yet
+             */
+            virtual std::vector<Variable*> getPendingVariables();
+
             virtual void putVariable(std::pair<int,int>& pair, NDArray *array);
             virtual void putVariable(std::pair<int,int>& pair, Variable *variable);
             virtual void putVariable(int id, Variable *variable);
@@ -134,6 +157,39 @@ namespace nd4j {
 
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            /**
+             * This method attaches dense slots assigned by Graph, so node inputs can be resolved without map lookups.
+             * Slots map is owned by Graph, and has to outlive this VariableSpace
+             */
+            virtual void attachSlots(const std::map<std::pair<int, int>, int>* slots);
+
+            /**
+             * This method returns Variable stored in given slot, or nullptr if there's none
+             */
+            virtual nd4j::graph::Variable* slotVariable(int slot);
+
+            /**
+             * This method attaches MemoryPlan to this VariableSpace, and allocates arena for planned arrays
+             */
+            void attachMemoryPlan(MemoryPlan* plan);
+            MemoryPlan* memoryPlan();
+
+            /**
+             * This method returns number of bytes available for planned arrays within arena, or 0 if there's no arena
+             */
+            Nd4jLong arenaSize();
+
+            /**
+             * This method returns NDArray placed within arena, if given output has region assigned by MemoryPlan
+             * and given shape fits into that region. Otherwise nullptr is returned.
+             *
+             * @param pair
+             * @param shapeInfo
+             * @param context
+             * @return
+             */
+            NDArray* plannedArray(std::pair<int,int>& pair, Nd4jLong *shapeInfo, nd4j::LaunchContext *context);
         };
     }
 }
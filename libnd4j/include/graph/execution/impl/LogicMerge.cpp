@@ -52,8 +52,9 @@ namespace nd4j {
             // FIXME: we don't need this check. Just last input should survive, IF it exists
             if (isWhile){
 
-                if (node->getFrameId() >= 0)
-                    __flowPath->markFrameActive(node->getFrameId(), true);
+                auto frameId = node->getFrameId() >= 0 ? node->getFrameId() : __flowPath->frameId(node->id());
+                if (frameId >= 0)
+                    __flowPath->markFrameActive(frameId, true);
 
                 bool hasVar = __variableSpace->hasVariable(inputAddr1);
                 if ( hasVar && __flowPath->wasExecuted(inputAddr1.first)) {
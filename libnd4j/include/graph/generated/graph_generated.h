@@ -113,7 +113,9 @@ struct FlatGraph FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_PLACEHOLDERS = 14,
     VT_LOSSVARIABLES = 16,
     VT_TRAININGCONFIG = 18,
-    VT_UPDATERSTATE = 20
+    VT_UPDATERSTATE = 20,
+    VT_STATEOUTPUTS = 22,
+    VT_STATEINPUTS = 24
   };
   int64_t id() const {
     return GetField<int64_t>(VT_ID, 0);
@@ -142,6 +144,12 @@ struct FlatGraph FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<UpdaterState>> *updaterState() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<UpdaterState>> *>(VT_UPDATERSTATE);
   }
+  const flatbuffers::Vector<flatbuffers::Offset<IntPair>> *stateOutputs() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<IntPair>> *>(VT_STATEOUTPUTS);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<IntPair>> *stateInputs() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<IntPair>> *>(VT_STATEINPUTS);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int64_t>(verifier, VT_ID) &&
@@ -167,6 +175,12 @@ struct FlatGraph FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_UPDATERSTATE) &&
            verifier.VerifyVector(updaterState()) &&
            verifier.VerifyVectorOfTables(updaterState()) &&
+           VerifyOffset(verifier, VT_STATEOUTPUTS) &&
+           verifier.VerifyVector(stateOutputs()) &&
+           verifier.VerifyVectorOfTables(stateOutputs()) &&
+           VerifyOffset(verifier, VT_STATEINPUTS) &&
+           verifier.VerifyVector(stateInputs()) &&
+           verifier.VerifyVectorOfTables(stateInputs()) &&
            verifier.EndTable();
   }
 };
@@ -201,6 +215,12 @@ struct FlatGraphBuilder {
   void add_updaterState(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<UpdaterState>>> updaterState) {
     fbb_.AddOffset(FlatGraph::VT_UPDATERSTATE, updaterState);
   }
+  void add_stateOutputs(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<IntPair>>> stateOutputs) {
+    fbb_.AddOffset(FlatGraph::VT_STATEOUTPUTS, stateOutputs);
+  }
+  void add_stateInputs(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<IntPair>>> stateInputs) {
+    fbb_.AddOffset(FlatGraph::VT_STATEINPUTS, stateInputs);
+  }
   explicit FlatGraphBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -223,9 +243,13 @@ inline flatbuffers::Offset<FlatGraph> CreateFlatGraph(
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> placeholders = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> lossVariables = 0,
     flatbuffers::Offset<flatbuffers::String> trainingConfig = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<UpdaterState>>> updaterState = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<UpdaterState>>> updaterState = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<IntPair>>> stateOutputs = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<IntPair>>> stateInputs = 0) {
   FlatGraphBuilder builder_(_fbb);
   builder_.add_id(id);
+  builder_.add_stateInputs(stateInputs);
+  builder_.add_stateOutputs(stateOutputs);
   builder_.add_updaterState(updaterState);
   builder_.add_trainingConfig(trainingConfig);
   builder_.add_lossVariables(lossVariables);
@@ -247,7 +271,9 @@ inline flatbuffers::Offset<FlatGraph> CreateFlatGraphDirect(
     const std::vector<flatbuffers::Offset<flatbuffers::String>> *placeholders = nullptr,
     const std::vector<flatbuffers::Offset<flatbuffers::String>> *lossVariables = nullptr,
     const char *trainingConfig = nullptr,
-    const std::vector<flatbuffers::Offset<UpdaterState>> *updaterState = nullptr) {
+    const std::vector<flatbuffers::Offset<UpdaterState>> *updaterState = nullptr,
+    const std::vector<flatbuffers::Offset<IntPair>> *stateOutputs = nullptr,
+    const std::vector<flatbuffers::Offset<IntPair>> *stateInputs = nullptr) {
   return nd4j::graph::CreateFlatGraph(
       _fbb,
       id,
@@ -258,19 +284,26 @@ inline flatbuffers::Offset<FlatGraph> CreateFlatGraphDirect(
       placeholders ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*placeholders) : 0,
       lossVariables ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*lossVariables) : 0,
       trainingConfig ? _fbb.CreateString(trainingConfig) : 0,
-      updaterState ? _fbb.CreateVector<flatbuffers::Offset<UpdaterState>>(*updaterState) : 0);
+      updaterState ? _fbb.CreateVector<flatbuffers::Offset<UpdaterState>>(*updaterState) : 0,
+      stateOutputs ? _fbb.CreateVector<flatbuffers::Offset<IntPair>>(*stateOutputs) : 0,
+      stateInputs ? _fbb.CreateVector<flatbuffers::Offset<IntPair>>(*stateInputs) : 0);
 }
 
 struct FlatDropRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum {
-    VT_ID = 4
+    VT_ID = 4,
+    VT_SESSION = 6
   };
   int64_t id() const {
     return GetField<int64_t>(VT_ID, 0);
   }
+  int64_t session() const {
+    return GetField<int64_t>(VT_SESSION, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int64_t>(verifier, VT_ID) &&
+           VerifyField<int64_t>(verifier, VT_SESSION) &&
            verifier.EndTable();
   }
 };
@@ -281,6 +314,9 @@ struct FlatDropRequestBuilder {
   void add_id(int64_t id) {
     fbb_.AddElement<int64_t>(FlatDropRequest::VT_ID, id, 0);
   }
+  void add_session(int64_t session) {
+    fbb_.AddElement<int64_t>(FlatDropRequest::VT_SESSION, session, 0);
+  }
   explicit FlatDropRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -295,8 +331,10 @@ struct FlatDropRequestBuilder {
 
 inline flatbuffers::Offset<FlatDropRequest> CreateFlatDropRequest(
     flatbuffers::FlatBufferBuilder &_fbb,
-    int64_t id = 0) {
+    int64_t id = 0,
+    int64_t session = 0) {
   FlatDropRequestBuilder builder_(_fbb);
+  builder_.add_session(session);
   builder_.add_id(id);
   return builder_.Finish();
 }
@@ -343,11 +343,47 @@ nd4j.graph.FlatGraph.prototype.updaterStateLength = function() {
   return offset ? this.bb.__vector_len(this.bb_pos + offset) : 0;
 };
 
+/**
+ * @param {number} index
+ * @param {nd4j.graph.IntPair=} obj
+ * @returns {nd4j.graph.IntPair}
+ */
+nd4j.graph.FlatGraph.prototype.stateOutputs = function(index, obj) {
+  var offset = this.bb.__offset(this.bb_pos, 22);
+  return offset ? (obj || new nd4j.graph.IntPair).__init(this.bb.__indirect(this.bb.__vector(this.bb_pos + offset) + index * 4), this.bb) : null;
+};
+
+/**
+ * @returns {number}
+ */
+nd4j.graph.FlatGraph.prototype.stateOutputsLength = function() {
+  var offset = this.bb.__offset(this.bb_pos, 22);
+  return offset ? this.bb.__vector_len(this.bb_pos + offset) : 0;
+};
+
+/**
+ * @param {number} index
+ * @param {nd4j.graph.IntPair=} obj
+ * @returns {nd4j.graph.IntPair}
+ */
+nd4j.graph.FlatGraph.prototype.stateInputs = function(index, obj) {
+  var offset = this.bb.__offset(this.bb_pos, 24);
+  return offset ? (obj || new nd4j.graph.IntPair).__init(this.bb.__indirect(this.bb.__vector(this.bb_pos + offset) + index * 4), this.bb) : null;
+};
+
+/**
+ * @returns {number}
+ */
+nd4j.graph.FlatGraph.prototype.stateInputsLength = function() {
+  var offset = this.bb.__offset(this.bb_pos, 24);
+  return offset ? this.bb.__vector_len(this.bb_pos + offset) : 0;
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  */
 nd4j.graph.FlatGraph.startFlatGraph = function(builder) {
-  builder.startObject(9);
+  builder.startObject(11);
 };
 
 /**
@@ -548,6 +584,64 @@ nd4j.graph.FlatGraph.startUpdaterStateVector = function(builder, numElems) {
   builder.startVector(4, numElems, 4);
 };
 
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {flatbuffers.Offset} stateOutputsOffset
+ */
+nd4j.graph.FlatGraph.addStateOutputs = function(builder, stateOutputsOffset) {
+  builder.addFieldOffset(9, stateOutputsOffset, 0);
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {Array.<flatbuffers.Offset>} data
+ * @returns {flatbuffers.Offset}
+ */
+nd4j.graph.FlatGraph.createStateOutputsVector = function(builder, data) {
+  builder.startVector(4, data.length, 4);
+  for (var i = data.length - 1; i >= 0; i--) {
+    builder.addOffset(data[i]);
+  }
+  return builder.endVector();
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {number} numElems
+ */
+nd4j.graph.FlatGraph.startStateOutputsVector = function(builder, numElems) {
+  builder.startVector(4, numElems, 4);
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {flatbuffers.Offset} stateInputsOffset
+ */
+nd4j.graph.FlatGraph.addStateInputs = function(builder, stateInputsOffset) {
+  builder.addFieldOffset(10, stateInputsOffset, 0);
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {Array.<flatbuffers.Offset>} data
+ * @returns {flatbuffers.Offset}
+ */
+nd4j.graph.FlatGraph.createStateInputsVector = function(builder, data) {
+  builder.startVector(4, data.length, 4);
+  for (var i = data.length - 1; i >= 0; i--) {
+    builder.addOffset(data[i]);
+  }
+  return builder.endVector();
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {number} numElems
+ */
+nd4j.graph.FlatGraph.startStateInputsVector = function(builder, numElems) {
+  builder.startVector(4, numElems, 4);
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  * @returns {flatbuffers.Offset}
@@ -608,11 +702,19 @@ nd4j.graph.FlatDropRequest.prototype.id = function() {
   return offset ? this.bb.readInt64(this.bb_pos + offset) : this.bb.createLong(0, 0);
 };
 
+/**
+ * @returns {flatbuffers.Long}
+ */
+nd4j.graph.FlatDropRequest.prototype.session = function() {
+  var offset = this.bb.__offset(this.bb_pos, 6);
+  return offset ? this.bb.readInt64(this.bb_pos + offset) : this.bb.createLong(0, 0);
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  */
 nd4j.graph.FlatDropRequest.startFlatDropRequest = function(builder) {
-  builder.startObject(1);
+  builder.startObject(2);
 };
 
 /**
@@ -623,6 +725,14 @@ nd4j.graph.FlatDropRequest.addId = function(builder, id) {
   builder.addFieldInt64(0, id, builder.createLong(0, 0));
 };
 
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {flatbuffers.Long} session
+ */
+nd4j.graph.FlatDropRequest.addSession = function(builder, session) {
+  builder.addFieldInt64(1, session, builder.createLong(0, 0));
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  * @returns {flatbuffers.Offset}
@@ -18,16 +18,20 @@ public struct FlatDropRequest : IFlatbufferObject
   public FlatDropRequest __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
 
   public long Id { get { int o = __p.__offset(4); return o != 0 ? __p.bb.GetLong(o + __p.bb_pos) : (long)0; } }
+  public long Session { get { int o = __p.__offset(6); return o != 0 ? __p.bb.GetLong(o + __p.bb_pos) : (long)0; } }
 
   public static Offset<FlatDropRequest> CreateFlatDropRequest(FlatBufferBuilder builder,
-      long id = 0) {
-    builder.StartObject(1);
+      long id = 0,
+      long session = 0) {
+    builder.StartObject(2);
+    FlatDropRequest.AddSession(builder, session);
     FlatDropRequest.AddId(builder, id);
     return FlatDropRequest.EndFlatDropRequest(builder);
   }
 
-  public static void StartFlatDropRequest(FlatBufferBuilder builder) { builder.StartObject(1); }
+  public static void StartFlatDropRequest(FlatBufferBuilder builder) { builder.StartObject(2); }
   public static void AddId(FlatBufferBuilder builder, long id) { builder.AddLong(0, id, 0); }
+  public static void AddSession(FlatBufferBuilder builder, long session) { builder.AddLong(1, session, 0); }
   public static Offset<FlatDropRequest> EndFlatDropRequest(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<FlatDropRequest>(o);
@@ -15,16 +15,20 @@ public final class FlatDropRequest extends Table {
   public FlatDropRequest __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
 
   public long id() { int o = __offset(4); return o != 0 ? bb.getLong(o + bb_pos) : 0L; }
+  public long session() { int o = __offset(6); return o != 0 ? bb.getLong(o + bb_pos) : 0L; }
 
   public static int createFlatDropRequest(FlatBufferBuilder builder,
-      long id) {
-    builder.startObject(1);
+      long id,
+      long session) {
+    builder.startObject(2);
+    FlatDropRequest.addSession(builder, session);
     FlatDropRequest.addId(builder, id);
     return FlatDropRequest.endFlatDropRequest(builder);
   }
 
-  public static void startFlatDropRequest(FlatBufferBuilder builder) { builder.startObject(1); }
+  public static void startFlatDropRequest(FlatBufferBuilder builder) { builder.startObject(2); }
   public static void addId(FlatBufferBuilder builder, long id) { builder.addLong(0, id, 0L); }
+  public static void addSession(FlatBufferBuilder builder, long session) { builder.addLong(1, session, 0L); }
   public static int endFlatDropRequest(FlatBufferBuilder builder) {
     int o = builder.endObject();
     return o;
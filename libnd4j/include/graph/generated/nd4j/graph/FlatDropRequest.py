@@ -25,6 +25,14 @@ class FlatDropRequest(object):
             return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
         return 0
 
-def FlatDropRequestStart(builder): builder.StartObject(1)
+    # FlatDropRequest
+    def Session(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
+        return 0
+
+def FlatDropRequestStart(builder): builder.StartObject(2)
 def FlatDropRequestAddId(builder, id): builder.PrependInt64Slot(0, id, 0)
+def FlatDropRequestAddSession(builder, session): builder.PrependInt64Slot(1, session, 0)
 def FlatDropRequestEnd(builder): return builder.EndObject()
@@ -38,6 +38,10 @@ public struct FlatGraph : IFlatbufferObject
   public byte[] GetTrainingConfigArray() { return __p.__vector_as_array<byte>(18); }
   public UpdaterState? UpdaterState(int j) { int o = __p.__offset(20); return o != 0 ? (UpdaterState?)(new UpdaterState()).__assign(__p.__indirect(__p.__vector(o) + j * 4), __p.bb) : null; }
   public int UpdaterStateLength { get { int o = __p.__offset(20); return o != 0 ? __p.__vector_len(o) : 0; } }
+  public IntPair? StateOutputs(int j) { int o = __p.__offset(22); return o != 0 ? (IntPair?)(new IntPair()).__assign(__p.__indirect(__p.__vector(o) + j * 4), __p.bb) : null; }
+  public int StateOutputsLength { get { int o = __p.__offset(22); return o != 0 ? __p.__vector_len(o) : 0; } }
+  public IntPair? StateInputs(int j) { int o = __p.__offset(24); return o != 0 ? (IntPair?)(new IntPair()).__assign(__p.__indirect(__p.__vector(o) + j * 4), __p.bb) : null; }
+  public int StateInputsLength { get { int o = __p.__offset(24); return o != 0 ? __p.__vector_len(o) : 0; } }
 
   public static Offset<FlatGraph> CreateFlatGraph(FlatBufferBuilder builder,
       long id = 0,
@@ -48,9 +52,13 @@ public struct FlatGraph : IFlatbufferObject
       VectorOffset placeholdersOffset = default(VectorOffset),
       VectorOffset lossVariablesOffset = default(VectorOffset),
       StringOffset trainingConfigOffset = default(StringOffset),
-      VectorOffset updaterStateOffset = default(VectorOffset)) {
-    builder.StartObject(9);
+      VectorOffset updaterStateOffset = default(VectorOffset),
+      VectorOffset stateOutputsOffset = default(VectorOffset),
+      VectorOffset stateInputsOffset = default(VectorOffset)) {
+    builder.StartObject(11);
     FlatGraph.AddId(builder, id);
+    FlatGraph.AddStateInputs(builder, stateInputsOffset);
+    FlatGraph.AddStateOutputs(builder, stateOutputsOffset);
     FlatGraph.AddUpdaterState(builder, updaterStateOffset);
     FlatGraph.AddTrainingConfig(builder, trainingConfigOffset);
     FlatGraph.AddLossVariables(builder, lossVariablesOffset);
@@ -62,7 +70,7 @@ public struct FlatGraph : IFlatbufferObject
     return FlatGraph.EndFlatGraph(builder);
   }
 
-  public static void StartFlatGraph(FlatBufferBuilder builder) { builder.StartObject(9); }
+  public static void StartFlatGraph(FlatBufferBuilder builder) { builder.StartObject(11); }
   public static void AddId(FlatBufferBuilder builder, long id) { builder.AddLong(0, id, 0); }
   public static void AddVariables(FlatBufferBuilder builder, VectorOffset variablesOffset) { builder.AddOffset(1, variablesOffset.Value, 0); }
   public static VectorOffset CreateVariablesVector(FlatBufferBuilder builder, Offset<FlatVariable>[] data) { builder.StartVector(4, data.Length, 4); for (int i = data.Length - 1; i >= 0; i--) builder.AddOffset(data[i].Value); return builder.EndVector(); }
@@ -90,6 +98,14 @@ public struct FlatGraph : IFlatbufferObject
   public static VectorOffset CreateUpdaterStateVector(FlatBufferBuilder builder, Offset<UpdaterState>[] data) { builder.StartVector(4, data.Length, 4); for (int i = data.Length - 1; i >= 0; i--) builder.AddOffset(data[i].Value); return builder.EndVector(); }
   public static VectorOffset CreateUpdaterStateVectorBlock(FlatBufferBuilder builder, Offset<UpdaterState>[] data) { builder.StartVector(4, data.Length, 4); builder.Add(data); return builder.EndVector(); }
   public static void StartUpdaterStateVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(4, numElems, 4); }
+  public static void AddStateOutputs(FlatBufferBuilder builder, VectorOffset stateOutputsOffset) { builder.AddOffset(9, stateOutputsOffset.Value, 0); }
+  public static VectorOffset CreateStateOutputsVector(FlatBufferBuilder builder, Offset<IntPair>[] data) { builder.StartVector(4, data.Length, 4); for (int i = data.Length - 1; i >= 0; i--) builder.AddOffset(data[i].Value); return builder.EndVector(); }
+  public static VectorOffset CreateStateOutputsVectorBlock(FlatBufferBuilder builder, Offset<IntPair>[] data) { builder.StartVector(4, data.Length, 4); builder.Add(data); return builder.EndVector(); }
+  public static void StartStateOutputsVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(4, numElems, 4); }
+  public static void AddStateInputs(FlatBufferBuilder builder, VectorOffset stateInputsOffset) { builder.AddOffset(10, stateInputsOffset.Value, 0); }
+  public static VectorOffset CreateStateInputsVector(FlatBufferBuilder builder, Offset<IntPair>[] data) { builder.StartVector(4, data.Length, 4); for (int i = data.Length - 1; i >= 0; i--) builder.AddOffset(data[i].Value); return builder.EndVector(); }
+  public static VectorOffset CreateStateInputsVectorBlock(FlatBufferBuilder builder, Offset<IntPair>[] data) { builder.StartVector(4, data.Length, 4); builder.Add(data); return builder.EndVector(); }
+  public static void StartStateInputsVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(4, numElems, 4); }
   public static Offset<FlatGraph> EndFlatGraph(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<FlatGraph>(o);
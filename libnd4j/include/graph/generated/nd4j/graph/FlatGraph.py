@@ -153,7 +153,47 @@ class FlatGraph(object):
             return self._tab.VectorLen(o)
         return 0
 
-def FlatGraphStart(builder): builder.StartObject(9)
+    # FlatGraph
+    def StateOutputs(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(22))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from .IntPair import IntPair
+            obj = IntPair()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # FlatGraph
+    def StateOutputsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(22))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # FlatGraph
+    def StateInputs(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from .IntPair import IntPair
+            obj = IntPair()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # FlatGraph
+    def StateInputsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(24))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+def FlatGraphStart(builder): builder.StartObject(11)
 def FlatGraphAddId(builder, id): builder.PrependInt64Slot(0, id, 0)
 def FlatGraphAddVariables(builder, variables): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(variables), 0)
 def FlatGraphStartVariablesVector(builder, numElems): return builder.StartVector(4, numElems, 4)
@@ -169,4 +209,8 @@ def FlatGraphStartLossVariablesVector(builder, numElems): return builder.StartVe
 def FlatGraphAddTrainingConfig(builder, trainingConfig): builder.PrependUOffsetTRelativeSlot(7, flatbuffers.number_types.UOffsetTFlags.py_type(trainingConfig), 0)
 def FlatGraphAddUpdaterState(builder, updaterState): builder.PrependUOffsetTRelativeSlot(8, flatbuffers.number_types.UOffsetTFlags.py_type(updaterState), 0)
 def FlatGraphStartUpdaterStateVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def FlatGraphAddStateOutputs(builder, stateOutputs): builder.PrependUOffsetTRelativeSlot(9, flatbuffers.number_types.UOffsetTFlags.py_type(stateOutputs), 0)
+def FlatGraphStartStateOutputsVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def FlatGraphAddStateInputs(builder, stateInputs): builder.PrependUOffsetTRelativeSlot(10, flatbuffers.number_types.UOffsetTFlags.py_type(stateInputs), 0)
+def FlatGraphStartStateInputsVector(builder, numElems): return builder.StartVector(4, numElems, 4)
 def FlatGraphEnd(builder): return builder.EndObject()
@@ -21,25 +21,29 @@ public struct FlatInferenceRequest : IFlatbufferObject
   public FlatVariable? Variables(int j) { int o = __p.__offset(6); return o != 0 ? (FlatVariable?)(new FlatVariable()).__assign(__p.__indirect(__p.__vector(o) + j * 4), __p.bb) : null; }
   public int VariablesLength { get { int o = __p.__offset(6); return o != 0 ? __p.__vector_len(o) : 0; } }
   public FlatConfiguration? Configuration { get { int o = __p.__offset(8); return o != 0 ? (FlatConfiguration?)(new FlatConfiguration()).__assign(__p.__indirect(o + __p.bb_pos), __p.bb) : null; } }
+  public long Session { get { int o = __p.__offset(10); return o != 0 ? __p.bb.GetLong(o + __p.bb_pos) : (long)0; } }
 
   public static Offset<FlatInferenceRequest> CreateFlatInferenceRequest(FlatBufferBuilder builder,
       long id = 0,
       VectorOffset variablesOffset = default(VectorOffset),
-      Offset<FlatConfiguration> configurationOffset = default(Offset<FlatConfiguration>)) {
-    builder.StartObject(3);
+      Offset<FlatConfiguration> configurationOffset = default(Offset<FlatConfiguration>),
+      long session = 0) {
+    builder.StartObject(4);
+    FlatInferenceRequest.AddSession(builder, session);
     FlatInferenceRequest.AddId(builder, id);
     FlatInferenceRequest.AddConfiguration(builder, configurationOffset);
     FlatInferenceRequest.AddVariables(builder, variablesOffset);
     return FlatInferenceRequest.EndFlatInferenceRequest(builder);
   }
 
-  public static void StartFlatInferenceRequest(FlatBufferBuilder builder) { builder.StartObject(3); }
+  public static void StartFlatInferenceRequest(FlatBufferBuilder builder) { builder.StartObject(4); }
   public static void AddId(FlatBufferBuilder builder, long id) { builder.AddLong(0, id, 0); }
   public static void AddVariables(FlatBufferBuilder builder, VectorOffset variablesOffset) { builder.AddOffset(1, variablesOffset.Value, 0); }
   public static VectorOffset CreateVariablesVector(FlatBufferBuilder builder, Offset<FlatVariable>[] data) { builder.StartVector(4, data.Length, 4); for (int i = data.Length - 1; i >= 0; i--) builder.AddOffset(data[i].Value); return builder.EndVector(); }
   public static VectorOffset CreateVariablesVectorBlock(FlatBufferBuilder builder, Offset<FlatVariable>[] data) { builder.StartVector(4, data.Length, 4); builder.Add(data); return builder.EndVector(); }
   public static void StartVariablesVector(FlatBufferBuilder builder, int numElems) { builder.StartVector(4, numElems, 4); }
   public static void AddConfiguration(FlatBufferBuilder builder, Offset<FlatConfiguration> configurationOffset) { builder.AddOffset(2, configurationOffset.Value, 0); }
+  public static void AddSession(FlatBufferBuilder builder, long session) { builder.AddLong(3, session, 0); }
   public static Offset<FlatInferenceRequest> EndFlatInferenceRequest(FlatBufferBuilder builder) {
     int o = builder.EndObject();
     return new Offset<FlatInferenceRequest>(o);
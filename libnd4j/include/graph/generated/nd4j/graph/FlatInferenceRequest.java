@@ -20,24 +20,28 @@ public final class FlatInferenceRequest extends Table {
   public int variablesLength() { int o = __offset(6); return o != 0 ? __vector_len(o) : 0; }
   public FlatConfiguration configuration() { return configuration(new FlatConfiguration()); }
   public FlatConfiguration configuration(FlatConfiguration obj) { int o = __offset(8); return o != 0 ? obj.__assign(__indirect(o + bb_pos), bb) : null; }
+  public long session() { int o = __offset(10); return o != 0 ? bb.getLong(o + bb_pos) : 0L; }
 
   public static int createFlatInferenceRequest(FlatBufferBuilder builder,
       long id,
       int variablesOffset,
-      int configurationOffset) {
-    builder.startObject(3);
+      int configurationOffset,
+      long session) {
+    builder.startObject(4);
+    FlatInferenceRequest.addSession(builder, session);
     FlatInferenceRequest.addId(builder, id);
     FlatInferenceRequest.addConfiguration(builder, configurationOffset);
     FlatInferenceRequest.addVariables(builder, variablesOffset);
     return FlatInferenceRequest.endFlatInferenceRequest(builder);
   }
 
-  public static void startFlatInferenceRequest(FlatBufferBuilder builder) { builder.startObject(3); }
+  public static void startFlatInferenceRequest(FlatBufferBuilder builder) { builder.startObject(4); }
   public static void addId(FlatBufferBuilder builder, long id) { builder.addLong(0, id, 0L); }
   public static void addVariables(FlatBufferBuilder builder, int variablesOffset) { builder.addOffset(1, variablesOffset, 0); }
   public static int createVariablesVector(FlatBufferBuilder builder, int[] data) { builder.startVector(4, data.length, 4); for (int i = data.length - 1; i >= 0; i--) builder.addOffset(data[i]); return builder.endVector(); }
   public static void startVariablesVector(FlatBufferBuilder builder, int numElems) { builder.startVector(4, numElems, 4); }
   public static void addConfiguration(FlatBufferBuilder builder, int configurationOffset) { builder.addOffset(2, configurationOffset, 0); }
+  public static void addSession(FlatBufferBuilder builder, long session) { builder.addLong(3, session, 0L); }
   public static int endFlatInferenceRequest(FlatBufferBuilder builder) {
     int o = builder.endObject();
     return o;
@@ -56,9 +56,17 @@ class FlatInferenceRequest(object):
             return obj
         return None
 
-def FlatInferenceRequestStart(builder): builder.StartObject(3)
+    # FlatInferenceRequest
+    def Session(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
+        return 0
+
+def FlatInferenceRequestStart(builder): builder.StartObject(4)
 def FlatInferenceRequestAddId(builder, id): builder.PrependInt64Slot(0, id, 0)
 def FlatInferenceRequestAddVariables(builder, variables): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(variables), 0)
 def FlatInferenceRequestStartVariablesVector(builder, numElems): return builder.StartVector(4, numElems, 4)
 def FlatInferenceRequestAddConfiguration(builder, configuration): builder.PrependUOffsetTRelativeSlot(2, flatbuffers.number_types.UOffsetTFlags.py_type(configuration), 0)
+def FlatInferenceRequestAddSession(builder, session): builder.PrependInt64Slot(3, session, 0)
 def FlatInferenceRequestEnd(builder): return builder.EndObject()
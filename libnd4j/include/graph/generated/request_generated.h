@@ -20,7 +20,8 @@ struct FlatInferenceRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   enum {
     VT_ID = 4,
     VT_VARIABLES = 6,
-    VT_CONFIGURATION = 8
+    VT_CONFIGURATION = 8,
+    VT_SESSION = 10
   };
   int64_t id() const {
     return GetField<int64_t>(VT_ID, 0);
@@ -31,6 +32,9 @@ struct FlatInferenceRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   const FlatConfiguration *configuration() const {
     return GetPointer<const FlatConfiguration *>(VT_CONFIGURATION);
   }
+  int64_t session() const {
+    return GetField<int64_t>(VT_SESSION, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int64_t>(verifier, VT_ID) &&
@@ -39,6 +43,7 @@ struct FlatInferenceRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
            verifier.VerifyVectorOfTables(variables()) &&
            VerifyOffset(verifier, VT_CONFIGURATION) &&
            verifier.VerifyTable(configuration()) &&
+           VerifyField<int64_t>(verifier, VT_SESSION) &&
            verifier.EndTable();
   }
 };
@@ -55,6 +60,9 @@ struct FlatInferenceRequestBuilder {
   void add_configuration(flatbuffers::Offset<FlatConfiguration> configuration) {
     fbb_.AddOffset(FlatInferenceRequest::VT_CONFIGURATION, configuration);
   }
+  void add_session(int64_t session) {
+    fbb_.AddElement<int64_t>(FlatInferenceRequest::VT_SESSION, session, 0);
+  }
   explicit FlatInferenceRequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -71,8 +79,10 @@ inline flatbuffers::Offset<FlatInferenceRequest> CreateFlatInferenceRequest(
     flatbuffers::FlatBufferBuilder &_fbb,
     int64_t id = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<FlatVariable>>> variables = 0,
-    flatbuffers::Offset<FlatConfiguration> configuration = 0) {
+    flatbuffers::Offset<FlatConfiguration> configuration = 0,
+    int64_t session = 0) {
   FlatInferenceRequestBuilder builder_(_fbb);
+  builder_.add_session(session);
   builder_.add_id(id);
   builder_.add_configuration(configuration);
   builder_.add_variables(variables);
@@ -83,12 +93,14 @@ inline flatbuffers::Offset<FlatInferenceRequest> CreateFlatInferenceRequestDirec
     flatbuffers::FlatBufferBuilder &_fbb,
     int64_t id = 0,
     const std::vector<flatbuffers::Offset<FlatVariable>> *variables = nullptr,
-    flatbuffers::Offset<FlatConfiguration> configuration = 0) {
+    flatbuffers::Offset<FlatConfiguration> configuration = 0,
+    int64_t session = 0) {
   return nd4j::graph::CreateFlatInferenceRequest(
       _fbb,
       id,
       variables ? _fbb.CreateVector<flatbuffers::Offset<FlatVariable>>(*variables) : 0,
-      configuration);
+      configuration,
+      session);
 }
 
 inline const nd4j::graph::FlatInferenceRequest *GetFlatInferenceRequest(const void *buf) {
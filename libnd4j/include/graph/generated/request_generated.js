@@ -82,11 +82,19 @@ nd4j.graph.FlatInferenceRequest.prototype.configuration = function(obj) {
   return offset ? (obj || new nd4j.graph.FlatConfiguration).__init(this.bb.__indirect(this.bb_pos + offset), this.bb) : null;
 };
 
+/**
+ * @returns {flatbuffers.Long}
+ */
+nd4j.graph.FlatInferenceRequest.prototype.session = function() {
+  var offset = this.bb.__offset(this.bb_pos, 10);
+  return offset ? this.bb.readInt64(this.bb_pos + offset) : this.bb.createLong(0, 0);
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  */
 nd4j.graph.FlatInferenceRequest.startFlatInferenceRequest = function(builder) {
-  builder.startObject(3);
+  builder.startObject(4);
 };
 
 /**
@@ -134,6 +142,14 @@ nd4j.graph.FlatInferenceRequest.addConfiguration = function(builder, configurati
   builder.addFieldOffset(2, configurationOffset, 0);
 };
 
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {flatbuffers.Long} session
+ */
+nd4j.graph.FlatInferenceRequest.addSession = function(builder, session) {
+  builder.addFieldInt64(3, session, builder.createLong(0, 0));
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  * @returns {flatbuffers.Offset}
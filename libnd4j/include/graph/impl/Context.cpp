@@ -34,6 +34,8 @@ namespace nd4j {
                     this->_inputs.push_back(v);
                 }
 
+                this->_inputSlots = *(prototype->inputSlots());
+
                 for (const auto &v: *(prototype->getTArguments())) {
                     this->_tArgs.push_back(v);
                 }
@@ -212,15 +214,25 @@ namespace nd4j {
         }
 
 
-        Variable* Context::getVariable(int idx) {
+        Variable* Context::inputVariable(int idx) {
             if (idx >= this->_inputs.size()) {
                 nd4j_printf("Node %i; Variable [%i] requested, but only %i inputs available\n", this->_nodeId, idx, this->_inputs.size());
                 throw std::runtime_error("Context: bad Variable index");
             }
 
-            auto p = this->_inputs[idx];
+            // slots are ignored if inputs were changed after Graph assigned them
+            if (_variableSpace != nullptr && _inputSlots.size() == _inputs.size()) {
+                auto v = _variableSpace->slotVariable(_inputSlots[idx]);
+                if (v != nullptr)
+                    return v;
+            }
+
+            return variable(this->_inputs[idx]);
+        }
 
-            auto v = variable(p);
+        Variable* Context::getVariable(int idx) {
+            _inputAccesses++;
+            auto v = inputVariable(idx);
 
             if (Environment::getInstance()->isDebugAndVerbose() && v != nullptr &&  v->getNDArray() != nullptr) {
                 auto array = v->getNDArray();
@@ -349,6 +361,7 @@ namespace nd4j {
         NDArray* Context::array(int idx) {
             // we check for fastpath first
             if (!_fastpath_in.empty() && _fastpath_in.size() > idx) {
+                _inputAccesses++;
                 return _fastpath_in[idx];
             }
 
@@ -356,6 +369,14 @@ namespace nd4j {
             return getVariable(idx)->getNDArray();
         }
 
+        Nd4jLong Context::inputAccesses() {
+            return _inputAccesses;
+        }
+
+        void Context::resetInputAccesses() {
+            _inputAccesses = 0L;
+        }
+
         nd4j::memory::Workspace *Context::fWorkspace() {
             return workspace();
         }
@@ -52,6 +52,14 @@ namespace nd4j {
             return &_inputs;
         }
 
+        void ContextPrototype::setInputSlots(const std::vector<int>& slots) {
+            _inputSlots = slots;
+        }
+
+        std::vector<int>* ContextPrototype::inputSlots() {
+            return &_inputSlots;
+        }
+
         void ContextPrototype::fillInputs(std::vector<int>& inputs) {
             for (int e = 0; e < inputs.size(); e++) {
                 auto v = inputs.at(e);
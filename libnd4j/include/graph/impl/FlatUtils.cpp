@@ -24,6 +24,8 @@
 #include <array/DataTypeUtils.h>
 #include <array/ByteOrderUtils.h>
 #include <NDArrayFactory.h>
+#include <helpers/BitwiseUtils.h>
+#include <helpers/ConstantShapeHelper.h>
 
 
 namespace nd4j {
@@ -102,5 +104,66 @@ namespace nd4j {
             delete[] newShape;
             return array;
         }
+
+        NDArray* FlatUtils::fromFlatArrayView(const nd4j::graph::FlatArray *flatArray) {
+            auto dtype = DataTypeUtils::fromFlatDataType(flatArray->dtype());
+            auto shapeInfo = const_cast<Nd4jLong *>(reinterpret_cast<const Nd4jLong *>(flatArray->shape()->data()));
+
+            // strings & empty arrays are always restored via copy
+            if (dtype == UTF8 || shape::isEmpty(shapeInfo) || flatArray->buffer() == nullptr)
+                return fromFlatArray(flatArray);
+
+            // data must be stored in native byte order, and properly aligned
+            auto buffer = flatArray->buffer()->data();
+            auto sizeOfT = DataTypeUtils::sizeOf(dtype);
+            auto length = shape::length(shapeInfo);
+            if (BitwiseUtils::asByteOrder() != ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder())
+                || reinterpret_cast<Nd4jLong>(buffer) % sizeOfT != 0
+                || (Nd4jLong) flatArray->buffer()->size() < length * (Nd4jLong) sizeOfT)
+                return fromFlatArray(flatArray);
+
+            // NDArray keeps its own copy of shapeInfo, so only data buffer is shared with FlatBuffer
+            return new NDArray((void *) buffer, shapeInfo, nd4j::LaunchContext::defaultContext(), false);
+        }
+    
+        flatbuffers::Offset<FlatArray> FlatUtils::toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array) {
+            auto byteOrder = static_cast<nd4j::graph::ByteOrder>(BitwiseUtils::asByteOrder());
+            auto dtype = static_cast<nd4j::graph::DataType>(array.dataType());
+
+            // strings carry offsets header within their buffer, so they're serialized as is
+            if (array.isS()) {
+                auto fShape = builder.CreateVector(array.getShapeInfoAsFlatVector());
+                auto fBuffer = builder.CreateVector(array.asByteVector());
+                return CreateFlatArray(builder, fShape, fBuffer, dtype, byteOrder);
+            }
+
+            array.syncToHost();
+
+            auto sizeOfT = array.sizeOfT();
+            auto length = array.isEmpty() ? 0 : array.lengthOf();
+            auto bytes = length * sizeOfT;
+            auto dense = array.isEmpty() || array.ews() == 1;
+
+            // views are gathered into 'c' order, so their shapeInfo is replaced with dense one
+            auto shapeInfo = dense ? array.shapeInfo() : ConstantShapeHelper::getInstance()->createShapeInfo(array.dataType(), 'c', array.getShapeAsVector());
+            auto fShape = builder.CreateVector(reinterpret_cast<const int64_t *>(shapeInfo), shape::shapeInfoLength(shapeInfo));
+
+            uint8_t *buffer = nullptr;
+            builder.PreAlign(bytes, sizeOfT);
+            auto fBuffer = flatbuffers::Offset<flatbuffers::Vector<int8_t>>(builder.CreateUninitializedVector(bytes, 1, &buffer));
+
+            if (dense) {
+                if (bytes > 0)
+                    memcpy(buffer, array.getBuffer(), bytes);
+            } else {
+                auto source = reinterpret_cast<int8_t *>(array.getBuffer());
+                auto xShapeInfo = array.shapeInfo();
+
+                for (Nd4jLong e = 0; e < length; e++)
+                    memcpy(buffer + e * sizeOfT, source + shape::getIndexOffset(e, xShapeInfo, length) * sizeOfT, sizeOfT);
+            }
+
+            return CreateFlatArray(builder, fShape, fBuffer, dtype, byteOrder);
+        }
     }
-}
\ No newline at end of file
+}
@@ -23,11 +23,20 @@
 namespace nd4j {
     namespace graph {
 
-        void FlowPath::ensureNode(int nodeId) {
-            if (_states.count(nodeId) == 0) {
+        NodeState& FlowPath::ensureNode(int nodeId) {
+            if (nodeId >= 0 && nodeId < MAX_DENSE_ID) {
+                for (int e = static_cast<int>(_states.size()); e <= nodeId; e++)
+                    _states.emplace_back(e);
+
+                return _states[nodeId];
+            }
+
+            if (_sparse.count(nodeId) == 0) {
                 NodeState state(nodeId);
-                _states[nodeId] = state;
+                _sparse[nodeId] = state;
             }
+
+            return _sparse[nodeId];
         }
 
         void FlowPath::ensureFrame(int frameId) {
@@ -37,52 +46,48 @@ namespace nd4j {
             }
         }
 
-        void FlowPath::setInnerTime(int nodeId, Nd4jLong time) {
+        void FlowPath::registerNode(int nodeId) {
             ensureNode(nodeId);
+        }
 
-            _states[nodeId].setInnerTime(time);
+        void FlowPath::setInnerTime(int nodeId, Nd4jLong time) {
+            ensureNode(nodeId).setInnerTime(time);
         }
 
         void FlowPath::setOuterTime(int nodeId, Nd4jLong time) {
-            ensureNode(nodeId);
-
-            _states[nodeId].setOuterTime(time);
+            ensureNode(nodeId).setOuterTime(time);
         }
 
         Nd4jLong FlowPath::innerTime(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].innerTime();
+            return ensureNode(nodeId).innerTime();
         }
 
         Nd4jLong FlowPath::outerTime(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].outerTime();
+            return ensureNode(nodeId).outerTime();
         }
 
         bool FlowPath::isNodeActive(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].isActive();
+            return ensureNode(nodeId).isActive();
         }
             
         void FlowPath::markNodeActive(int nodeId, bool isActive) {
-            ensureNode(nodeId);
-
-            _states[nodeId].markActive(isActive);
+            ensureNode(nodeId).markActive(isActive);
         }
 
         int FlowPath::branch(int nodeId){
-            ensureNode(nodeId);
-
-            return _states[nodeId].branch();
+            return ensureNode(nodeId).branch();
         }
 
         void FlowPath::markBranch(int nodeId, int index) {
-            ensureNode(nodeId);
+            ensureNode(nodeId).markBranch(index);
+        }
+
+        Nd4jLong FlowPath::frameId(int nodeId) {
+            return ensureNode(nodeId).frameId();
+        }
 
-            _states[nodeId].markBranch(index);
+        void FlowPath::setFrameId(int nodeId, Nd4jLong frameId) {
+            ensureNode(nodeId).setFrameId(frameId);
         }
 
         bool FlowPath::isFrameActive(Nd4jLong frameId) {
@@ -137,11 +142,11 @@ namespace nd4j {
 
 
         bool FlowPath::wasExecuted(int nodeId) {
-            return _states[nodeId].wasExecuted();
+            return ensureNode(nodeId).wasExecuted();
         }
 
         void FlowPath::markExecuted(int nodeId, bool wasExecuted) {
-            _states[nodeId].markExecuted(wasExecuted);
+            ensureNode(nodeId).markExecuted(wasExecuted);
         }
 
         GraphProfile* FlowPath::profile() {
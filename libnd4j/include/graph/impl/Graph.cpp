@@ -23,9 +23,14 @@
 #include <graph/FlatUtils.h>
 #include <NativeOps.h>
 #include <vector>
+#include <algorithm>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/VariableProxy.h>
+#include <GraphExecutioner.h>
+#include <chrono>
+#include <memory>
+#include <helpers/NumaHelper.h>
 #include <exceptions/graph_exception.h>
 #include <exceptions/unresolved_input_exception.h>
 #include <exceptions/unresolved_output_exception.h>
@@ -285,27 +290,41 @@ namespace nd4j {
         }
 
         Graph::~Graph() {
-            for (auto &v: *_mapped)
-                delete v.second;
+            // sessions don't own graph structure, it belongs to the original Graph
+            if (_origin == nullptr) {
+                for (auto &v: *_mapped)
+                    delete v.second;
 
-            for (auto &v: _unmapped)
-                delete v.second;
+                for (auto &v: _unmapped)
+                    delete v.second;
+
+                for (auto &v: *_onion)
+                    delete v.second;
 
-            for (auto &v: *_onion)
-                delete v.second;
 
+                for (auto v: _scopes)
+                    delete v;
 
-            for (auto v: _scopes)
-                delete v;
+                delete _mapped;
+                delete _nodes;
+                delete _onion;
+                delete _memoryPlan.load();
+
+                for (auto &v: _replicas)
+                    delete v.second;
+            }
 
-            delete _mapped;
-            delete _nodes;
             delete _variableSpace;
-            delete _onion;
             delete _configuration;
+
+            // arrays might point into mapped file, so it's released last
+            delete _mappedFile;
         }
 
         void Graph::addNode(Node *node) {
+            if (_frozen.load() || _origin != nullptr)
+                throw std::runtime_error("Graph::addNode - nodes can't be added to the Graph used by sessions");
+
             _built.store(false);
 
             if (node->opType() == OpType_LOGIC) {
@@ -513,7 +532,10 @@ namespace nd4j {
 
         Nd4jStatus Graph::buildGraph() {
             if (_built.load()) {
-                prepareOutputs();
+                // session outputs were prepared by the original graph
+                if (_origin == nullptr)
+                    prepareOutputs();
+
                 return ND4J_STATUS_OK;
             }
 
@@ -696,14 +718,40 @@ namespace nd4j {
                 }
             }
 
-            if (_unmapped.size() == 0)
+            if (_unmapped.size() == 0) {
                 _built.store(true);
+                assignSlots();
+            }
 
             prepareOutputs();
 
             return nd4j::Status::OK();
         }
 
+        void Graph::assignSlots() {
+            _slots.clear();
+
+            for (auto &v: *_mapped) {
+                auto block = v.second->getContextPrototype();
+                if (block == nullptr)
+                    continue;
+
+                std::vector<int> slots;
+                for (auto &p: *block->inputs()) {
+                    auto it = _slots.find(p);
+                    if (it == _slots.end())
+                        it = _slots.emplace(p, static_cast<int>(_slots.size())).first;
+
+                    slots.emplace_back(it->second);
+                }
+
+                block->setInputSlots(slots);
+            }
+
+            if (_variableSpace != nullptr)
+                _variableSpace->attachSlots(&_slots);
+        }
+
         void Graph::tagInplaceNodes() {
             // just calling, in case it wasn't built before
             if (!_built.load())
@@ -864,7 +912,7 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, bool zeroCopy) {
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -891,7 +939,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, zeroCopy);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -1274,6 +1322,257 @@ namespace nd4j {
 
             _variableSpace = state;
             _configuration = configuration;
+
+            if (_variableSpace != nullptr && !_slots.empty())
+                _variableSpace->attachSlots(&_slots);
+        }
+
+        Graph* Graph::createSession(int numaNode) {
+            // sessions of session are sessions of the original graph
+            if (_origin != nullptr)
+                return _origin->createSession(numaNode);
+
+            // graph is built only once, all sessions share the same structure afterwards
+            if (!_frozen.load()) {
+                _mutexPreprocessing.lock();
+                if (!_frozen.load()) {
+                    this->buildGraph();
+                    _frozen.store(true);
+                }
+                _mutexPreprocessing.unlock();
+            }
+
+            auto backed = _variableSpace;
+            if (numaNode >= 0 && Environment::getInstance()->isNumaReplication() && NumaHelper::getInstance()->isAvailable())
+                backed = replicaOf(numaNode);
+
+            auto session = new Graph();
+            session->replaceState(new VariableProxy(backed), _configuration->clone());
+            session->_numaNode = numaNode;
+
+            for (auto &v: *session->_onion)
+                delete v.second;
+
+            delete session->_onion;
+            delete session->_mapped;
+            delete session->_nodes;
+
+            session->_onion = _onion;
+            session->_mapped = _mapped;
+            session->_nodes = _nodes;
+            session->_mappedScopes = _mappedScopes;
+            session->_output = _output;
+            session->_autos = _autos;
+            session->_origin = this;
+            session->_built.store(true);
+
+            // node outputs get own slots within session, so concurrent sessions never share them
+            auto proxy = session->_variableSpace;
+            proxy->attachSlots(&_slots);
+
+            for (auto v: _variableSpace->getPendingVariables()) {
+                auto slot = new Variable(nullptr, nullptr, v->id(), v->index());
+                if (v->getName() != nullptr && !v->getName()->empty())
+                    slot->setName(v->getName());
+
+                std::pair<int, int> pair(v->id(), v->index());
+                proxy->putVariable(pair, slot);
+            }
+
+            return session;
+        }
+
+        VariableSpace* Graph::replicaOf(int node) {
+            if (_origin != nullptr)
+                return _origin->replicaOf(node);
+
+            std::lock_guard<std::mutex> lock(_mutexReplicas);
+            auto it = _replicas.find(node);
+            if (it != _replicas.end())
+                return it->second;
+
+            // arrays are copied by thread pinned to given node, so their pages are first touched there
+            NumaBinding binding(node);
+            auto replica = _variableSpace->clone();
+            if (!_slots.empty())
+                replica->attachSlots(&_slots);
+
+            _replicas[node] = replica;
+
+            return replica;
+        }
+
+        int Graph::numaNode() {
+            return _numaNode;
+        }
+
+        bool Graph::isSession() {
+            return _origin != nullptr;
+        }
+
+        void Graph::retainOrigin(std::shared_ptr<Graph> origin) {
+            if (origin.get() != _origin)
+                throw std::runtime_error("Graph::retainOrigin: session belongs to another Graph");
+
+            _originHandle = origin;
+        }
+
+        void Graph::setMemoryPlanning(bool reallyPlan) {
+            if (_origin != nullptr) {
+                _origin->setMemoryPlanning(reallyPlan);
+                return;
+            }
+
+            _memoryPlanning.store(reallyPlan);
+        }
+
+        bool Graph::isMemoryPlanning() {
+            return _origin != nullptr ? _origin->isMemoryPlanning() : _memoryPlanning.load();
+        }
+
+        MemoryPlan* Graph::getMemoryPlan() {
+            return _origin != nullptr ? _origin->getMemoryPlan() : _memoryPlan.load();
+        }
+
+        MemoryPlan* Graph::buildMemoryPlan(VariableSpace *variableSpace) {
+            if (_origin != nullptr)
+                return _origin->buildMemoryPlan(variableSpace);
+
+            if (_memoryPlan.load() == nullptr) {
+                std::lock_guard<std::mutex> lock(_mutexPreprocessing);
+                if (_memoryPlan.load() == nullptr)
+                    _memoryPlan.store(MemoryPlan::build(this, variableSpace));
+            }
+
+            return _memoryPlan.load();
+        }
+
+        bool Graph::reportMemoryPlan(nd4j::memory::MemoryReport &report) {
+            auto plan = getMemoryPlan();
+            if (plan == nullptr)
+                return false;
+
+            plan->report(report);
+            return true;
+        }
+
+        std::vector<int>* Graph::getOutputIds() {
+            return &_output;
+        }
+
+        OptimizationStats Graph::optimize() {
+            if (_origin != nullptr)
+                return _origin->getOptimizationStats();
+
+            std::lock_guard<std::mutex> lock(_mutexPreprocessing);
+
+            // sessions share nodes with this graph, so it can't be changed anymore
+            if (_optimized.load() || _frozen.load())
+                return _optimizationStats;
+
+            _optimizationStats = GraphOptimizer::optimize(this);
+            _optimized.store(true);
+
+            // optimization passes rewire node inputs, so slots have to be reassigned
+            if (_built.load())
+                assignSlots();
+
+            return _optimizationStats;
+        }
+
+        bool Graph::isOptimized() {
+            return _origin != nullptr ? _origin->isOptimized() : _optimized.load();
+        }
+
+        OptimizationStats Graph::getOptimizationStats() {
+            return _origin != nullptr ? _origin->getOptimizationStats() : _optimizationStats;
+        }
+
+        Nd4jLong Graph::warmUp() {
+            if (_origin != nullptr)
+                return _origin->warmUp();
+
+            auto timeStart = std::chrono::system_clock::now();
+
+            std::unique_ptr<Graph> session(createSession());
+            auto vs = session->getVariableSpace();
+
+            // synthetic placeholders live within session only
+            for (auto v: _variableSpace->getVariables()) {
+                if (v->hasNDArray() || (!v->isPlaceholder() && v->variableType() != VariableType::PLACEHOLDER))
+                    continue;
+
+                std::vector<Nd4jLong> shape;
+                for (auto d: v->shape()) {
+                    shape.emplace_back(d > 0 ? d : 1);
+
+                    if (d <= 0)
+                        session->markSyntheticInputs(true);
+                }
+
+                auto dtype = v->dataType() == nd4j::DataType::INHERIT ? nd4j::DataType::FLOAT32 : v->dataType();
+                auto array = new NDArray('c', shape, dtype);
+                array->nullify();
+
+                vs->putVariable(v->id(), v->index(), array);
+            }
+
+            Nd4jStatus status;
+            try {
+                status = GraphExecutioner::execute(session.get());
+            } catch (std::exception &e) {
+                nd4j_printf("Graph warm-up failed: %s\n", e.what());
+                return -1L;
+            }
+
+            if (status != Status::OK()) {
+                nd4j_printf("Graph warm-up failed with status [%i]\n", status);
+                return -1L;
+            }
+
+            auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - timeStart).count();
+            _warmUpTime.store(time);
+
+            return time;
+        }
+
+        Nd4jLong Graph::getWarmUpTime() {
+            return _origin != nullptr ? _origin->getWarmUpTime() : _warmUpTime.load();
+        }
+
+        void Graph::markSyntheticInputs(bool reallySynthetic) {
+            _syntheticInputs = reallySynthetic;
+        }
+
+        bool Graph::hasSyntheticInputs() {
+            return _syntheticInputs;
+        }
+
+        void Graph::removeNode(int nodeId) {
+            if (_frozen.load() || _origin != nullptr)
+                throw std::runtime_error("Graph::removeNode - nodes can't be removed from the Graph used by sessions");
+
+            if (_mapped->count(nodeId) == 0)
+                return;
+
+            auto node = _mapped->at(nodeId);
+            _mapped->erase(nodeId);
+
+            // empty layers are kept, executioner just skips them
+            for (auto &v: *_onion)
+                v.second->erase(std::remove(v.second->begin(), v.second->end(), node), v.second->end());
+
+            _nodes->erase(std::remove(_nodes->begin(), _nodes->end(), nodeId), _nodes->end());
+            _handles.erase(std::remove(_handles.begin(), _handles.end(), node), _handles.end());
+
+            delete node;
+        }
+
+        void Graph::attachMappedFile(MappedFile *file) {
+            if (_mappedFile != nullptr && _mappedFile != file)
+                delete _mappedFile;
+
+            _mappedFile = file;
         }
 
         Graph* Graph::cloneWithProxy() {
@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/GraphBatcher.h>
+#include <graph/GraphHolder.h>
+#include <graph/ExecutionResult.h>
+#include <GraphExecutioner.h>
+#include <templatemath.h>
+#include <chrono>
+
+namespace nd4j {
+    namespace graph {
+        class GraphBatcher::PendingRequest {
+        public:
+            enum RequestState {
+                QUEUED,
+                BATCHED,
+                SINGLE,
+            };
+
+            RequestState state = QUEUED;
+            std::chrono::steady_clock::time_point deadline;
+
+            std::vector<Variable*> inputs;
+            std::vector<Variable*> outputs;
+
+            // set by batch leader, before state is changed
+            bool batched = false;
+
+            PendingRequest() = default;
+
+            ~PendingRequest() {
+                for (auto v: inputs)
+                    delete v;
+
+                for (auto v: outputs)
+                    delete v;
+            }
+        };
+
+        namespace {
+            // all inputs must be arrays with the same number of rows
+            bool isBatchable(std::vector<Variable*> &inputs) {
+                if (inputs.empty())
+                    return false;
+
+                Nd4jLong rows = -1;
+                for (auto v: inputs) {
+                    if (!v->hasNDArray())
+                        return false;
+
+                    auto array = v->getNDArray();
+                    if (array->isEmpty() || array->isS() || array->rankOf() < 1)
+                        return false;
+
+                    if (rows >= 0 && array->sizeAt(0) != rows)
+                        return false;
+
+                    rows = array->sizeAt(0);
+                }
+
+                return true;
+            }
+
+            // inputs must match each other everywhere except of dimension 0
+            bool isCompatible(std::vector<Variable*> &first, std::vector<Variable*> &second) {
+                if (first.size() != second.size())
+                    return false;
+
+                for (int e = 0; e < (int) first.size(); e++) {
+                    auto x = first[e];
+                    auto y = second[e];
+
+                    if (x->id() != y->id() || x->index() != y->index() || *x->getName() != *y->getName())
+                        return false;
+
+                    auto xa = x->getNDArray();
+                    auto ya = y->getNDArray();
+                    if (xa->dataType() != ya->dataType() || xa->rankOf() != ya->rankOf())
+                        return false;
+
+                    for (int d = 1; d < xa->rankOf(); d++)
+                        if (xa->sizeAt(d) != ya->sizeAt(d))
+                            return false;
+                }
+
+                return true;
+            }
+
+            // returns interval of rows [from, to) along dimension 0
+            std::vector<Nd4jLong> rowsInterval(int rank, Nd4jLong from, Nd4jLong to) {
+                std::vector<Nd4jLong> idx(2 * rank, 0);
+                idx[0] = from;
+                idx[1] = to;
+
+                return idx;
+            }
+        }
+
+        double BatchingStats::averageBatchSize() const {
+            return batches == 0 ? 0.0 : static_cast<double>(batchedRequests) / static_cast<double>(batches);
+        }
+
+        GraphBatcher* GraphBatcher::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new GraphBatcher();
+
+            return _INSTANCE;
+        }
+
+        void GraphBatcher::setMaxBatchSize(int numRequests) {
+            _maxBatchSize.store(numRequests);
+        }
+
+        int GraphBatcher::maxBatchSize() {
+            return _maxBatchSize.load();
+        }
+
+        void GraphBatcher::setMaxDelay(Nd4jLong microseconds) {
+            _maxDelay.store(microseconds);
+        }
+
+        Nd4jLong GraphBatcher::maxDelay() {
+            return _maxDelay.load();
+        }
+
+        bool GraphBatcher::isEnabled() {
+            return _maxBatchSize.load() > 1;
+        }
+
+        BatchingStats GraphBatcher::getStats(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _stats[graphId];
+        }
+
+        void GraphBatcher::resetStats() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.clear();
+        }
+
+        flatbuffers::Offset<FlatResult> GraphBatcher::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            // streaming session requests depend on each other, so they're never batched
+            if (!isEnabled() || (request != nullptr && request->session() != 0))
+                return GraphHolder::getInstance()->execute(graphId, builder, request);
+
+            // inputs are views of request buffer, which outlives pending request. data is copied only if request gets batched
+            PendingRequest pending;
+            if (request != nullptr && request->variables() != nullptr) {
+                auto vars = request->variables();
+                for (int e = 0; e < (int) vars->size(); e++)
+                    pending.inputs.emplace_back(new Variable(vars->Get(e), true));
+            }
+
+            if (!isBatchable(pending.inputs)) {
+                _mutex.lock();
+                _stats[graphId].requests++;
+                _stats[graphId].singleRequests++;
+                _mutex.unlock();
+
+                return GraphHolder::getInstance()->execute(graphId, builder, request);
+            }
+
+            auto maxBatch = maxBatchSize();
+            pending.deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(maxDelay());
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stats[graphId].requests++;
+
+            auto &queue = _queues[graphId];
+            queue.push_back(&pending);
+            _condition.notify_all();
+
+            while (pending.state == PendingRequest::QUEUED) {
+                // only first request in queue can start the batch
+                if (queue.front() != &pending) {
+                    _condition.wait(lock);
+                    continue;
+                }
+
+                if ((int) queue.size() < maxBatch && std::chrono::steady_clock::now() < pending.deadline) {
+                    _condition.wait_until(lock, pending.deadline);
+                    continue;
+                }
+
+                std::vector<PendingRequest*> batch;
+                while (!queue.empty() && (int) batch.size() < maxBatch) {
+                    batch.emplace_back(queue.front());
+                    queue.pop_front();
+                }
+
+                // next request in queue becomes leader of the next batch
+                _condition.notify_all();
+
+                lock.unlock();
+                executeBatch(graphId, batch);
+                lock.lock();
+
+                auto &stats = _stats[graphId];
+                Nd4jLong numBatched = 0;
+                for (auto p: batch) {
+                    p->state = p->batched ? PendingRequest::BATCHED : PendingRequest::SINGLE;
+                    if (p->batched)
+                        numBatched++;
+                }
+
+                if (numBatched > 0) {
+                    stats.batches++;
+                    stats.batchedRequests += numBatched;
+                    stats.largestBatch = nd4j::math::nd4j_max<Nd4jLong>(stats.largestBatch, numBatched);
+                }
+                stats.singleRequests += (Nd4jLong) batch.size() - numBatched;
+
+                _condition.notify_all();
+            }
+
+            lock.unlock();
+
+            // this request wasn't batched, so caller executes it on its own
+            if (pending.state == PendingRequest::SINGLE)
+                return GraphHolder::getInstance()->execute(graphId, builder, request);
+
+            ExecutionResult result;
+            for (auto v: pending.outputs)
+                result.emplace_back(v);
+
+            return result.asFlatResult(builder);
+        }
+
+        void GraphBatcher::executeBatch(Nd4jLong graphId, std::vector<PendingRequest*> &batch) {
+            std::vector<PendingRequest*> compatible;
+            for (auto p: batch)
+                if (isCompatible(batch[0]->inputs, p->inputs))
+                    compatible.emplace_back(p);
+
+            // nothing to batch here
+            if (compatible.size() < 2)
+                return;
+
+            auto holder = GraphHolder::getInstance();
+            if (!holder->hasGraph(graphId))
+                return;
+
+            Graph* session = nullptr;
+            std::vector<Variable*>* outputs = nullptr;
+
+            try {
+                // session keeps its graph alive, even if graph gets replaced meanwhile
+                session = holder->cloneGraph(graphId);
+
+                Nd4jLong numRows = 0;
+                for (auto p: compatible)
+                    numRows += p->inputs[0]->getNDArray()->sizeAt(0);
+
+                // concatenating inputs along dimension 0
+                auto first = compatible[0];
+                for (int e = 0; e < (int) first->inputs.size(); e++) {
+                    auto proto = first->inputs[e];
+                    auto shape = proto->getNDArray()->getShapeAsVector();
+                    shape[0] = numRows;
+
+                    auto array = new NDArray('c', shape, proto->getNDArray()->dataType());
+
+                    Nd4jLong from = 0;
+                    for (auto p: compatible) {
+                        auto source = p->inputs[e]->getNDArray();
+                        auto rows = (*array)(rowsInterval(array->rankOf(), from, from + source->sizeAt(0)), true);
+                        rows.assign(source);
+
+                        from += source->sizeAt(0);
+                    }
+
+                    auto name = proto->getName()->empty() ? nullptr : proto->getName()->c_str();
+                    session->getVariableSpace()->replaceVariable(new Variable(array, name, proto->id(), proto->index()));
+                }
+
+                if (GraphExecutioner::execute(session) == Status::OK()) {
+                    outputs = session->fetchOutputs();
+
+                    // outputs must be batched along dimension 0 as well, otherwise requests are executed one by one
+                    bool splittable = !outputs->empty();
+                    for (auto v: *outputs)
+                        if (!v->hasNDArray() || v->getNDArray()->rankOf() < 1 || v->getNDArray()->sizeAt(0) != numRows)
+                            splittable = false;
+
+                    if (splittable) {
+                        Nd4jLong from = 0;
+                        for (auto p: compatible) {
+                            auto numOwn = p->inputs[0]->getNDArray()->sizeAt(0);
+                            for (auto v: *outputs) {
+                                auto array = v->getNDArray();
+                                auto rows = (*array)(rowsInterval(array->rankOf(), from, from + numOwn), true);
+                                auto name = v->getName()->empty() ? nullptr : v->getName()->c_str();
+
+                                p->outputs.emplace_back(new Variable(rows.dup(), name, v->id(), v->index()));
+                            }
+
+                            p->batched = true;
+                            from += numOwn;
+                        }
+                    }
+                }
+            } catch (std::exception &e) {
+                // failed requests are executed one by one, so each caller gets its own error
+                nd4j_printf("Batched execution of graph [%lld] failed: %s\n", graphId, e.what());
+                for (auto p: compatible) {
+                    for (auto v: p->outputs)
+                        delete v;
+
+                    p->outputs.clear();
+                    p->batched = false;
+                }
+            }
+
+            delete outputs;
+            delete session;
+        }
+
+        GraphBatcher* GraphBatcher::_INSTANCE = 0;
+    }
+}
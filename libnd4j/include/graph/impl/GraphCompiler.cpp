@@ -0,0 +1,419 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/GraphCompiler.h>
+#include <graph/Graph.h>
+#include <graph/MemoryPlan.h>
+#include <GraphExecutioner.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <array/DataTypeUtils.h>
+#include <cctype>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace nd4j {
+    namespace graph {
+        std::string GraphCompiler::symbolOf(const std::pair<int, int> &pair) {
+            auto id = pair.first < 0 ? "m" + std::to_string(-pair.first) : std::to_string(pair.first);
+            return id + "_" + std::to_string(pair.second);
+        }
+
+        std::string GraphCompiler::sanitize(const std::string &name) {
+            std::string result;
+            for (auto c: name)
+                result += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+
+            if (result.empty() || std::isdigit(static_cast<unsigned char>(result[0])))
+                result = "graph_" + result;
+
+            return result;
+        }
+
+        std::string GraphCompiler::classOf(Node *node) {
+            switch (node->opType()) {
+                case OpType_CUSTOM:
+                    return *node->getCustomOp()->getOpName();
+                case OpType_PAIRWISE:
+                    return "LegacyPairwiseTransformOp";
+                case OpType_PAIRWISE_BOOL:
+                    return "LegacyPairwiseTransformBoolOp";
+                case OpType_TRANSFORM_STRICT:
+                    return "LegacyTransformStrictOp";
+                case OpType_TRANSFORM_SAME:
+                    return "LegacyTransformSameOp";
+                case OpType_TRANSFORM_FLOAT:
+                    return "LegacyTransformFloatOp";
+                case OpType_TRANSFORM_BOOL:
+                    return "LegacyTransformBoolOp";
+                case OpType_SCALAR:
+                    return "LegacyScalarOp";
+                case OpType_SCALAR_BOOL:
+                    return "LegacyScalarBoolOp";
+                case OpType_REDUCE_3:
+                    return "LegacyReduce3Op";
+                case OpType_REDUCE_SAME:
+                    return "LegacyReduceSameOp";
+                case OpType_REDUCE_FLOAT:
+                    return "LegacyReduceFloatOp";
+                case OpType_REDUCE_LONG:
+                    return "LegacyReduceLongOp";
+                case OpType_REDUCE_BOOL:
+                    return "LegacyReduceBoolOp";
+                case OpType_INDEX_REDUCE:
+                    return "LegacyIndexReduceOp";
+                case OpType_SUMMARYSTATS:
+                    return "LegacyStatsOp";
+                case OpType_RANDOM:
+                    return "LegacyRandomOp";
+                case OpType_BROADCAST:
+                    return "LegacyBroadcastOp";
+                case OpType_BROADCAST_BOOL:
+                    return "LegacyBroadcastBoolOp";
+                default:
+                    throw std::runtime_error("GraphCompiler: node [" + std::to_string(node->id()) + "] has op type that can't be compiled");
+            }
+        }
+
+        void GraphCompiler::emitShape(std::ostream &out, const std::string &symbol, Nd4jLong *shapeInfo) {
+            out << "    static Nd4jLong shape_" << symbol << "[] = {";
+            for (int e = 0; e < shape::shapeInfoLength(shapeInfo); e++)
+                out << (e > 0 ? ", " : "") << shapeInfo[e];
+
+            out << "};\n";
+        }
+
+        void GraphCompiler::emitBuffer(std::ostream &out, const std::string &symbol, NDArray *array) {
+            array->syncToHost();
+
+            auto bytes = array->lengthOf() * array->sizeOfT();
+            auto data = reinterpret_cast<int8_t *>(array->getBuffer());
+
+            out << "    alignas(64) static int8_t buffer_" << symbol << "[" << bytes << "] = {";
+            for (Nd4jLong e = 0; e < bytes; e++) {
+                if (e % 32 == 0)
+                    out << "\n        ";
+
+                out << (int) data[e] << ",";
+            }
+
+            out << "\n    };\n";
+        }
+
+        std::string GraphCompiler::compile(Graph *graph, const std::string &name, bool withMain) {
+            auto ns = sanitize(name);
+
+            if (!graph->isOptimized())
+                graph->optimize();
+
+            std::unique_ptr<Graph> session(graph->createSession());
+
+            // execution order of these nodes isn't defined by onion, so they can't be unrolled
+            std::vector<Node*> nodes;
+            for (auto &layer: *session->getOnion()) {
+                for (auto node: *layer.second) {
+                    if (node->opType() == OpType_LOGIC || node->isScoped() || node->hasGraphEmbedded())
+                        throw std::runtime_error("GraphCompiler: graphs with LOGIC ops or scopes can't be compiled");
+
+                    nodes.emplace_back(node);
+                }
+            }
+
+            std::stringstream arrays;
+            std::stringstream ops;
+            std::stringstream prepare;
+            std::stringstream execute;
+            std::set<std::string> headers;
+
+            // without explicit outputs, nodes of the last layer are considered outputs
+            std::vector<int> outputIds(*session->getOutputIds());
+            if (outputIds.empty() && !session->getOnion()->empty())
+                for (auto node: *session->getOnion()->rbegin()->second)
+                    outputIds.emplace_back(node->id());
+
+            // external variables are stored before execution, since inplace ops might modify them
+            std::set<std::pair<int, int>> externals;
+            std::vector<std::pair<int, int>> inputs;
+            auto variableSpace = graph->getVariableSpace();
+
+            // anything that isn't a node is taken from VariableSpace, including results of folded nodes
+            std::vector<std::pair<int, int>> variables;
+            for (auto node: nodes)
+                for (auto &in: *node->input())
+                    if (!graph->hasNode(in.first))
+                        variables.emplace_back(in);
+
+            for (auto id: outputIds)
+                if (!graph->hasNode(id))
+                    for (int e = 0; variableSpace->hasVariable(id, e); e++)
+                        variables.emplace_back(id, e);
+
+            arrays << "    // graph variables\n";
+            for (auto &in: variables) {
+                if (externals.count(in) > 0)
+                    continue;
+
+                if (!variableSpace->hasVariable(in) || !variableSpace->getVariable(in)->hasNDArray())
+                    throw std::runtime_error("GraphCompiler: variable [" + std::to_string(in.first) + ":" + std::to_string(in.second) + "] has no array");
+
+                auto var = variableSpace->getVariable(in);
+                if (var->getNDArray()->isS())
+                    throw std::runtime_error("GraphCompiler: string arrays can't be compiled");
+
+                std::unique_ptr<NDArray> array(var->getNDArray()->dup(var->getNDArray()->ordering()));
+                auto symbol = symbolOf(in);
+
+                emitShape(arrays, symbol, array->shapeInfo());
+                if (array->isEmpty()) {
+                    arrays << "    static nd4j::NDArray array_" << symbol << "(nullptr, shape_" << symbol << ");\n";
+                } else {
+                    emitBuffer(arrays, symbol, array.get());
+                    arrays << "    static nd4j::NDArray array_" << symbol << "(buffer_" << symbol << ", shape_" << symbol << ");\n";
+                }
+
+                externals.insert(in);
+                if (!var->isConstant())
+                    inputs.emplace_back(in);
+            }
+
+            // single round gives us shapes of all intermediate arrays
+            auto status = GraphExecutioner::execute(session.get());
+            if (status != ND4J_STATUS_OK)
+                throw std::runtime_error("GraphCompiler: graph execution failed with status [" + std::to_string(status) + "]");
+
+            auto sessionSpace = session->getVariableSpace();
+            std::unique_ptr<MemoryPlan> plan(MemoryPlan::build(session.get(), sessionSpace));
+
+            arrays << "\n    // intermediate arrays\n";
+            for (auto node: nodes) {
+                auto cls = classOf(node);
+                auto id = std::to_string(node->id());
+                auto proto = node->protoContext();
+
+                for (int e = 0; sessionSpace->hasVariable(node->id(), e); e++) {
+                    std::pair<int, int> pair(node->id(), e);
+                    auto var = sessionSpace->getVariable(pair);
+                    if (!var->hasNDArray() || var->getNDArray()->isS())
+                        throw std::runtime_error("GraphCompiler: node [" + id + "] produces output that can't be compiled");
+
+                    auto array = var->getNDArray();
+                    auto symbol = symbolOf(pair);
+
+                    // all intermediates are dense, even if interpreter produced views
+                    auto shapeInfo = array->isEmpty() ? array->shapeInfo() : ConstantShapeHelper::getInstance()->createShapeInfo(array->dataType(), array->ordering(), array->getShapeAsVector());
+                    emitShape(arrays, symbol, shapeInfo);
+
+                    if (array->isEmpty()) {
+                        arrays << "    static nd4j::NDArray array_" << symbol << "(nullptr, shape_" << symbol << ");\n";
+                    } else if (plan->isPlanned(pair)) {
+                        arrays << "    static nd4j::NDArray array_" << symbol << "(arena + " << plan->offset(pair) << ", shape_" << symbol << ");\n";
+                    } else {
+                        arrays << "    alignas(64) static int8_t buffer_" << symbol << "[" << array->lengthOf() * array->sizeOfT() << "];\n";
+                        arrays << "    static nd4j::NDArray array_" << symbol << "(buffer_" << symbol << ", shape_" << symbol << ");\n";
+                    }
+
+                    prepare << "        context_" << id << ".setOutputArray(" << e << ", &array_" << symbol << ");\n";
+                }
+
+                // op instances are created directly, no OpRegistrator lookups involved
+                if (node->opType() == OpType_CUSTOM) {
+                    ops << "    static nd4j::ops::" << cls << " op_" << id << ";\n";
+                } else if (node->opType() == OpType_SCALAR || node->opType() == OpType_SCALAR_BOOL) {
+                    auto x = sessionSpace->getVariable(node->input()->at(0))->getNDArray();
+                    headers.insert(cls);
+                    ops << "    static auto scalar_" << id << " = nd4j::NDArrayFactory::create(static_cast<nd4j::DataType>(" << (int) x->dataType() << "), " << std::setprecision(17) << node->scalar() << ");\n";
+                    ops << "    static nd4j::ops::" << cls << " op_" << id << "(" << node->opNum() << ", scalar_" << id << ");\n";
+                } else {
+                    headers.insert(cls);
+                    ops << "    static nd4j::ops::" << cls << " op_" << id << "(" << node->opNum() << ");\n";
+                }
+
+                ops << "    static nd4j::graph::Context context_" << id << "(" << id << ");\n";
+
+                int cnt = 0;
+                for (auto &in: *node->input())
+                    prepare << "        context_" << id << ".setInputArray(" << cnt++ << ", &array_" << symbolOf(in) << ");\n";
+
+                if (!proto->getIArguments()->empty()) {
+                    prepare << "        *context_" << id << ".getIArguments() = {";
+                    for (int e = 0; e < (int) proto->getIArguments()->size(); e++)
+                        prepare << (e > 0 ? ", " : "") << proto->getIArguments()->at(e);
+                    prepare << "};\n";
+                }
+
+                if (!proto->getTArguments()->empty()) {
+                    prepare << "        *context_" << id << ".getTArguments() = {";
+                    for (int e = 0; e < (int) proto->getTArguments()->size(); e++)
+                        prepare << (e > 0 ? ", " : "") << std::setprecision(17) << proto->getTArguments()->at(e);
+                    prepare << "};\n";
+                }
+
+                if (!proto->getBArguments()->empty()) {
+                    prepare << "        *context_" << id << ".getBArguments() = {";
+                    for (int e = 0; e < (int) proto->getBArguments()->size(); e++)
+                        prepare << (e > 0 ? ", " : "") << (proto->getBArguments()->at(e) ? "true" : "false");
+                    prepare << "};\n";
+                }
+
+                if (!proto->getAxis()->empty()) {
+                    prepare << "        *context_" << id << ".getAxis() = {";
+                    for (int e = 0; e < (int) proto->getAxis()->size(); e++)
+                        prepare << (e > 0 ? ", " : "") << proto->getAxis()->at(e);
+                    prepare << "};\n";
+                }
+
+                prepare << "        context_" << id << ".setDataType(0, static_cast<nd4j::DataType>(" << (int) proto->dataType() << "));\n";
+
+                execute << "        if ((status = op_" << id << ".execute(&context_" << id << ")) != ND4J_STATUS_OK)\n";
+                execute << "            return status;\n";
+            }
+
+            std::vector<std::pair<int, int>> outputs;
+            for (auto id: outputIds) {
+                for (int e = 0; sessionSpace->hasVariable(id, e); e++) {
+                    std::pair<int, int> pair(id, e);
+                    if (graph->hasNode(id) || externals.count(pair) > 0)
+                        outputs.emplace_back(pair);
+                }
+            }
+
+            std::stringstream source;
+            source << "//\n";
+            source << "// This file was generated by GraphCompiler, please don't edit it manually.\n";
+            source << "// Graph has " << nodes.size() << " nodes, " << inputs.size() << " inputs and " << outputs.size() << " outputs; intermediates arena takes " << plan->getPeakBytes() << " bytes\n";
+            source << "//\n\n";
+            source << "#include <NDArray.h>\n";
+            source << "#include <NDArrayFactory.h>\n";
+            source << "#include <graph/Context.h>\n";
+            source << "#include <ops/declarable/CustomOperations.h>\n";
+            for (auto &h: headers)
+                source << "#include <ops/declarable/" << h << ".h>\n";
+
+            source << "#include <mutex>\n";
+            if (withMain) {
+                source << "#include <GraphExecutioner.h>\n";
+                source << "#include <chrono>\n";
+                source << "#include <iostream>\n";
+            }
+
+            source << "\nnamespace " << ns << " {\n";
+            source << "    // intermediate arrays with non-overlapping lifetimes share the same regions of this arena\n";
+            source << "    alignas(" << MemoryPlan::ALIGNMENT << ") static int8_t arena[" << nd4j::math::nd4j_max<Nd4jLong>(plan->getPeakBytes(), MemoryPlan::ALIGNMENT) << "];\n\n";
+            source << arrays.str() << "\n";
+            source << "    // ops\n" << ops.str() << "\n";
+            source << "    static std::once_flag prepared;\n\n";
+            source << "    static void prepare() {\n" << prepare.str() << "    }\n\n";
+
+            source << "    /**\n";
+            source << "     * This method executes graph. Input arrays should be filled before the call, output arrays are valid until next call.\n";
+            source << "     *\n";
+            source << "     * PLEASE NOTE: all callers share the same buffers, so this method isn't thread-safe\n";
+            source << "     */\n";
+            source << "    Nd4jStatus execute() {\n";
+            source << "        std::call_once(prepared, prepare);\n\n";
+            source << "        Nd4jStatus status;\n";
+            source << execute.str();
+            source << "\n        return ND4J_STATUS_OK;\n";
+            source << "    }\n\n";
+
+            source << "    int numberOfInputs() {\n        return " << inputs.size() << ";\n    }\n\n";
+            source << "    nd4j::NDArray* input(int index) {\n";
+            if (inputs.empty()) {
+                source << "        return nullptr;\n";
+            } else {
+                source << "        static nd4j::NDArray* inputs[] = {";
+                for (int e = 0; e < (int) inputs.size(); e++)
+                    source << (e > 0 ? ", " : "") << "&array_" << symbolOf(inputs[e]);
+                source << "};\n";
+                source << "        return index >= 0 && index < " << inputs.size() << " ? inputs[index] : nullptr;\n";
+            }
+            source << "    }\n\n";
+
+            source << "    int numberOfOutputs() {\n        return " << outputs.size() << ";\n    }\n\n";
+            source << "    nd4j::NDArray* output(int index) {\n";
+            if (outputs.empty()) {
+                source << "        return nullptr;\n";
+            } else {
+                source << "        static nd4j::NDArray* outputs[] = {";
+                for (int e = 0; e < (int) outputs.size(); e++)
+                    source << (e > 0 ? ", " : "") << "&array_" << symbolOf(outputs[e]);
+                source << "};\n";
+                source << "        return index >= 0 && index < " << outputs.size() << " ? outputs[index] : nullptr;\n";
+            }
+            source << "    }\n";
+            source << "}\n";
+
+            if (withMain) {
+                source << "\n";
+                source << "/**\n";
+                source << " * Usage: binary [iterations] [graph.fb]\n";
+                source << " * If FlatGraph file is provided, the same graph is executed via GraphExecutioner, and results are compared\n";
+                source << " */\n";
+                source << "int main(int argc, char *argv[]) {\n";
+                source << "    int iterations = argc > 1 ? atoi(argv[1]) : 100;\n\n";
+                source << "    if (" << ns << "::execute() != ND4J_STATUS_OK) {\n";
+                source << "        std::cerr << \"Compiled graph execution failed\" << std::endl;\n";
+                source << "        return 1;\n";
+                source << "    }\n\n";
+                source << "    auto timeStart = std::chrono::system_clock::now();\n";
+                source << "    for (int e = 0; e < iterations; e++)\n";
+                source << "        " << ns << "::execute();\n\n";
+                source << "    auto compiledTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - timeStart).count() / (double) iterations;\n";
+                source << "    std::cout << \"Compiled graph: \" << compiledTime << \" us per execution\" << std::endl;\n\n";
+                source << "    if (argc < 3)\n";
+                source << "        return 0;\n\n";
+                source << "    auto graph = nd4j::graph::GraphExecutioner::importFromFlatBuffers(argv[2]);\n";
+                source << "    graph->optimize();\n\n";
+                source << "    // first round is warm-up, it's used for results comparison only\n";
+                source << "    Nd4jLong interpretedTime = 0L;\n";
+                source << "    for (int e = 0; e <= iterations; e++) {\n";
+                source << "        auto t0 = std::chrono::system_clock::now();\n";
+                source << "        auto session = graph->createSession();\n";
+                source << "        auto status = nd4j::graph::GraphExecutioner::execute(session);\n";
+                source << "        auto t1 = std::chrono::system_clock::now();\n\n";
+                source << "        if (status != ND4J_STATUS_OK) {\n";
+                source << "            std::cerr << \"GraphExecutioner execution failed\" << std::endl;\n";
+                source << "            return 1;\n";
+                source << "        }\n\n";
+                source << "        if (e > 0) {\n";
+                source << "            interpretedTime += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();\n";
+                source << "        } else {\n";
+                source << "            auto results = session->fetchOutputs();\n";
+                source << "            for (int o = 0; o < (int) results->size() && o < " << ns << "::numberOfOutputs(); o++)\n";
+                source << "                if (!results->at(o)->getNDArray()->equalsTo(" << ns << "::output(o)))\n";
+                source << "                    std::cerr << \"Output \" << o << \" differs from GraphExecutioner result\" << std::endl;\n\n";
+                source << "            delete results;\n";
+                source << "        }\n\n";
+                source << "        delete session;\n";
+                source << "    }\n\n";
+                source << "    std::cout << \"GraphExecutioner: \" << interpretedTime / (double) iterations << \" us per execution\" << std::endl;\n";
+                source << "    std::cout << \"Speedup: \" << (interpretedTime / (double) iterations) / compiledTime << \"x\" << std::endl;\n\n";
+                source << "    delete graph;\n";
+                source << "    return 0;\n";
+                source << "}\n";
+            }
+
+            return source.str();
+        }
+    }
+}
@@ -20,6 +20,8 @@
 
 #include <graph/GraphHolder.h>
 #include <GraphExecutioner.h>
+#include <graph/StreamingSessions.h>
+#include <helpers/NumaHelper.h>
 #include <exceptions/graph_exists_exception.h>
 #include <exceptions/graph_execution_exception.h>
 
@@ -32,60 +34,115 @@ namespace nd4j {
             return _INSTANCE;
         };
 
+        std::shared_ptr<const GraphHolder::GraphMap> GraphHolder::snapshot() {
+            return std::atomic_load(&_graphs);
+        }
+
+        void GraphHolder::publish(GraphMap *graphs) {
+            std::atomic_store(&_graphs, std::shared_ptr<const GraphMap>(graphs));
+        }
+
         void GraphHolder::registerGraph(Nd4jLong graphId, Graph* graph) {
             if (hasGraphAny(graphId))
                 throw graph_exists_exception(graphId);
 
-            _graphF[graphId] = graph;
+            // graph is optimized once here, so every request benefits from that
+            graph->optimize();
+
+            // first requests shouldn't pay for graph build, shape functions and workspace growth
+            warmUp(graphId, graph);
+
+            std::lock_guard<std::mutex> lock(_writeLock);
+
+            auto current = snapshot();
+            if (current->count(graphId) > 0)
+                throw graph_exists_exception(graphId);
+
+            auto updated = new GraphMap(*current);
+            (*updated)[graphId] = std::shared_ptr<Graph>(graph, GraphDeleter());
 
-            nd4j::SimpleReadWriteLock lock;
-            _locks[graphId] = lock;
+            publish(updated);
+        }
+
+        void GraphHolder::warmUp(Nd4jLong graphId, Graph *graph) {
+            auto time = graph->warmUp();
+            if (time >= 0) {
+                nd4j_debug("Graph [%lld] warm-up took %lld us\n", graphId, time);
+            } else {
+                nd4j_printf("Graph [%lld] warm-up failed, first request will do it\n", graphId);
+            }
+        }
+
+        std::shared_ptr<Graph> GraphHolder::acquireGraph(Nd4jLong graphId) {
+            auto graphs = snapshot();
+
+            auto it = graphs->find(graphId);
+            if (it == graphs->end())
+                return nullptr;
+
+            return it->second;
         }
 
         Graph* GraphHolder::cloneGraph(Nd4jLong graphId) {
-            if (!this->hasGraph(graphId)) {
+            auto graph = acquireGraph(graphId);
+            if (graph == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId]->cloneWithProxy();
+            // session keeps original graph alive, even if it gets replaced meanwhile
+            auto session = graph->createSession(NumaHelper::getInstance()->sessionNode());
+            session->retainOrigin(graph);
 
-            return graph;
+            return session;
         }
 
         Graph* GraphHolder::pullGraph(Nd4jLong graphId) {
-            if (!this->hasGraph(graphId)) {
+            auto graph = acquireGraph(graphId);
+            if (graph == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId];
-
-            return graph;
+            return graph.get();
         }
 
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId))
-                _graphF.erase(graphId);
+            std::lock_guard<std::mutex> lock(_writeLock);
+
+            auto current = snapshot();
+            auto it = current->find(graphId);
+            if (it == current->end())
+                return;
+
+            std::get_deleter<GraphDeleter>(it->second)->release();
+
+            auto updated = new GraphMap(*current);
+            updated->erase(graphId);
+
+            publish(updated);
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId)) {
-                auto g = _graphF[graphId];
-                forgetGraph(graphId);
-                delete g;
-            }
-        }
+            {
+                std::lock_guard<std::mutex> lock(_writeLock);
 
-        void GraphHolder::dropGraphAny(Nd4jLong graphId) {
-            if (!hasGraphAny(graphId))
-                return;
+                auto current = snapshot();
+                if (current->count(graphId) == 0)
+                    return;
 
-            this->lockWrite(graphId);
+                auto updated = new GraphMap(*current);
+                updated->erase(graphId);
 
-            this->dropGraph(graphId);
+                publish(updated);
+            }
 
-            this->unlockWrite(graphId);
+            // streaming sessions of dropped graph are released as well
+            StreamingSessions::getInstance()->forgetGraph(graphId);
+        }
+
+        void GraphHolder::dropGraphAny(Nd4jLong graphId) {
+            dropGraph(graphId);
         }
 
         bool GraphHolder::hasGraphAny(Nd4jLong graphId) {
@@ -93,7 +150,7 @@ namespace nd4j {
         }
 
         bool GraphHolder::hasGraph(Nd4jLong graphId) {
-                return _graphF.count(graphId) > 0;
+            return snapshot()->count(graphId) > 0;
         }
 
         void GraphHolder::replaceGraph(Nd4jLong graphId, Graph* graph) {
@@ -102,29 +159,29 @@ namespace nd4j {
                 return;
             }
 
-            this->lockWrite(graphId);
-
-            _graphF[graphId] = graph;
-
-            this->unlockWrite(graphId);
-        }
+            graph->optimize();
+            warmUp(graphId, graph);
 
+            std::lock_guard<std::mutex> lock(_writeLock);
 
+            auto updated = new GraphMap(*snapshot());
+            (*updated)[graphId] = std::shared_ptr<Graph>(graph, GraphDeleter());
 
+            publish(updated);
+        }
 
         flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
-            if (!hasGraph(graphId))
-                throw unknown_graph_exception(graphId);
-
-            lockRead(graphId);
+            // requests bound to streaming session carry state between calls
+            if (request != nullptr && request->session() != 0)
+                return StreamingSessions::getInstance()->execute(graphId, request->session(), builder, request);
 
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
-
-            unlockRead(graphId);
+            // this reference keeps graph alive till the end of this request
+            auto graph = acquireGraph(graphId);
+            if (graph == nullptr)
+                throw unknown_graph_exception(graphId);
 
-            return res;
+            std::unique_ptr<Graph> session(graph->createSession(NumaHelper::getInstance()->sessionNode()));
+            return GraphExecutioner::execute(session.get(), builder, request);
         }
 
         GraphHolder* GraphHolder::_INSTANCE = 0;
@@ -0,0 +1,527 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/GraphOptimizer.h>
+#include <graph/Graph.h>
+#include <GraphExecutioner.h>
+#include <helpers/logger.h>
+#include <op_enums.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <ops/declarable/LegacyRandomOp.h>
+#include <ops/declarable/helpers/biasActivation.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <tuple>
+
+namespace nd4j {
+    namespace graph {
+        bool GraphOptimizer::isRandom(Node *node) {
+            if (node->opType() == OpType_RANDOM)
+                return true;
+
+            auto op = node->getCustomOp();
+            if (dynamic_cast<nd4j::ops::LegacyRandomOp*>(op) != nullptr)
+                return true;
+
+            // custom ops consuming RNG declare that in their descriptor
+            return op->isRandom();
+        }
+
+        bool GraphOptimizer::isRewritable(Node *node) {
+            if (!node->hasCustomOp() || node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->isScoped())
+                return false;
+
+            // ops propagating results to external variables have side effects
+            if (node->isDivergencePoint() || node->hasExternalOutputs())
+                return false;
+
+            return !isRandom(node);
+        }
+
+        bool GraphOptimizer::isIdentity(Node *node) {
+            if (node->input()->size() != 1)
+                return false;
+
+            if (node->opType() == OpType_TRANSFORM_SAME && node->opNum() == nd4j::transform::Identity)
+                return true;
+
+            return node->opType() == OpType_CUSTOM && *node->getCustomOp()->getOpName() == "identity";
+        }
+
+        bool GraphOptimizer::isOutput(Graph *graph, int nodeId) {
+            auto outputs = graph->getOutputIds();
+            return std::find(outputs->begin(), outputs->end(), nodeId) != outputs->end();
+        }
+
+        bool GraphOptimizer::isEquivalent(Node *first, Node *second) {
+            if (first->opType() != second->opType() || first->opNum() != second->opNum() || first->dataType() != second->dataType())
+                return false;
+
+            if (first->getCustomOp()->getOpDescriptor()->getHash() != second->getCustomOp()->getOpDescriptor()->getHash())
+                return false;
+
+            if (*first->input() != *second->input() || *first->getDimensions() != *second->getDimensions() || first->scalar() != second->scalar())
+                return false;
+
+            auto x = first->getContextPrototype();
+            auto y = second->getContextPrototype();
+            if (x == nullptr || y == nullptr)
+                return x == y;
+
+            return *x->getTArguments() == *y->getTArguments() && *x->getIArguments() == *y->getIArguments()
+                   && *x->getBArguments() == *y->getBArguments() && *x->getAxis() == *y->getAxis();
+        }
+
+        void GraphOptimizer::replaceInput(Graph *graph, std::pair<int, int> from, std::pair<int, int> to) {
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                bool found = false;
+
+                for (auto &in: *node->input())
+                    if (in == from) {
+                        in = to;
+                        found = true;
+                    }
+
+                if (!found)
+                    continue;
+
+                if (node->getContextPrototype() != nullptr)
+                    for (auto &in: *node->getContextPrototype()->inputs())
+                        if (in == from)
+                            in = to;
+
+                // new input might be shared with other nodes now, so it can't be overwritten
+                node->markInplace(false);
+            }
+        }
+
+        int GraphOptimizer::foldConstants(Graph *graph) {
+            auto variableSpace = graph->getVariableSpace();
+            std::vector<int> folded;
+
+            for (auto &layer: *graph->getOnion()) {
+                for (auto node: *layer.second) {
+                    // graph outputs must stay addressable by their ids, so they are always executed
+                    if (!isRewritable(node) || node->input()->empty() || isOutput(graph, node->id()))
+                        continue;
+
+                    bool constant = true;
+                    for (auto &in: *node->input()) {
+                        if (std::find(folded.begin(), folded.end(), in.first) != folded.end())
+                            continue;
+
+                        if (graph->hasNode(in.first) || !variableSpace->hasVariable(in)) {
+                            constant = false;
+                            break;
+                        }
+
+                        auto var = variableSpace->getVariable(in);
+                        if (!var->isConstant() || !var->hasNDArray()) {
+                            constant = false;
+                            break;
+                        }
+                    }
+
+                    if (!constant)
+                        continue;
+
+                    // constant inputs must stay intact
+                    node->markInplace(false);
+
+                    Nd4jStatus status;
+                    try {
+                        status = GraphExecutioner::executeFlatNode(graph, node, variableSpace);
+                    } catch (std::exception &e) {
+                        nd4j_debug("Constant folding of node [%i] failed: %s\n", node->id(), e.what());
+                        continue;
+                    }
+
+                    if (status != Status::OK() || !variableSpace->hasVariable(node->id()) || !variableSpace->getVariable(node->id())->hasNDArray())
+                        continue;
+
+                    for (int e = 0; variableSpace->hasVariable(node->id(), e); e++)
+                        variableSpace->getVariable(node->id(), e)->markConstant(true);
+
+                    folded.emplace_back(node->id());
+                }
+            }
+
+            for (auto id: folded) {
+                graph->removeNode(id);
+
+                // consumers must not overwrite precomputed results
+                for (auto &v: *graph->getMapped())
+                    for (auto &in: *v.second->input())
+                        if (in.first == id)
+                            v.second->markInplace(false);
+            }
+
+            return static_cast<int>(folded.size());
+        }
+
+        int GraphOptimizer::collapseIdentities(Graph *graph) {
+            std::vector<int> collapsed;
+
+            for (auto &layer: *graph->getOnion()) {
+                for (auto node: *layer.second) {
+                    if (!isRewritable(node) || !isIdentity(node) || isOutput(graph, node->id()))
+                        continue;
+
+                    replaceInput(graph, std::pair<int, int>(node->id(), 0), node->input()->at(0));
+                    collapsed.emplace_back(node->id());
+                }
+            }
+
+            for (auto id: collapsed)
+                graph->removeNode(id);
+
+            return static_cast<int>(collapsed.size());
+        }
+
+        int GraphOptimizer::eliminateCommonSubexpressions(Graph *graph) {
+            auto variableSpace = graph->getVariableSpace();
+
+            // candidates are grouped by op & inputs, full comparison is done within group only
+            std::map<std::tuple<int, Nd4jLong, std::vector<std::pair<int, int>>>, std::vector<Node*>> candidates;
+            std::vector<int> merged;
+
+            // layers are visited in execution order, so consumers are already rewired when they are checked
+            for (auto &layer: *graph->getOnion()) {
+                for (auto node: *layer.second) {
+                    if (!isRewritable(node))
+                        continue;
+
+                    auto &group = candidates[std::make_tuple(static_cast<int>(node->opType()), node->opNum(), *node->input())];
+
+                    Node *original = nullptr;
+                    for (auto c: group)
+                        if (isEquivalent(c, node)) {
+                            original = c;
+                            break;
+                        }
+
+                    if (original == nullptr || node->isInplace() || original->isInplace() || isOutput(graph, node->id())) {
+                        group.emplace_back(node);
+                        continue;
+                    }
+
+                    for (int e = 0; variableSpace->hasVariable(node->id(), e); e++)
+                        replaceInput(graph, std::pair<int, int>(node->id(), e), std::pair<int, int>(original->id(), e));
+
+                    merged.emplace_back(node->id());
+                }
+            }
+
+            for (auto id: merged)
+                graph->removeNode(id);
+
+            return static_cast<int>(merged.size());
+        }
+
+        int GraphOptimizer::eliminateDeadNodes(Graph *graph) {
+            // without explicit outputs every node without consumers is an output
+            if (graph->getExecutorConfiguration()->_outputMode != OutputMode_EXPLICIT)
+                return 0;
+
+            std::set<int> alive;
+            std::vector<int> queue;
+            for (auto id: *graph->getOutputIds())
+                if (graph->hasNode(id))
+                    queue.emplace_back(id);
+
+            if (queue.empty())
+                return 0;
+
+            while (!queue.empty()) {
+                auto id = queue.back();
+                queue.pop_back();
+
+                if (!alive.insert(id).second)
+                    continue;
+
+                for (auto &in: *graph->nodeById(id)->input())
+                    if (graph->hasNode(in.first))
+                        queue.emplace_back(in.first);
+            }
+
+            std::vector<int> dead;
+            for (auto &v: *graph->getMapped())
+                if (alive.count(v.first) == 0 && isRewritable(v.second))
+                    dead.emplace_back(v.first);
+
+            for (auto id: dead)
+                graph->removeNode(id);
+
+            return static_cast<int>(dead.size());
+        }
+
+        bool GraphOptimizer::isOp(Node *node, const char *name) {
+            return node->opType() == OpType_CUSTOM && node->hasCustomOp() && *node->getCustomOp()->getOpName() == name;
+        }
+
+        int GraphOptimizer::activationOf(Node *node, double &alpha) {
+            alpha = 0.;
+            if (node->input()->size() != 1)
+                return -1;
+
+            auto tArgs = node->getContextPrototype()->getTArguments();
+            if (isOp(node, "relu")) {
+                alpha = tArgs->empty() ? 0. : tArgs->at(0);
+                return nd4j::ops::helpers::FUSED_RELU;
+            } else if (isOp(node, "relu6")) {
+                alpha = tArgs->empty() ? 0. : tArgs->at(0);
+                return nd4j::ops::helpers::FUSED_RELU6;
+            } else if (isOp(node, "sigmoid") || (node->opType() == OpType_TRANSFORM_STRICT && node->opNum() == nd4j::transform::Sigmoid)) {
+                return nd4j::ops::helpers::FUSED_SIGMOID;
+            } else if (isOp(node, "tanh") || (node->opType() == OpType_TRANSFORM_STRICT && node->opNum() == nd4j::transform::Tanh)) {
+                return nd4j::ops::helpers::FUSED_TANH;
+            }
+
+            return -1;
+        }
+
+        Node* GraphOptimizer::singleConsumer(Graph *graph, Node *node) {
+            if (!isRewritable(node) || isOutput(graph, node->id()))
+                return nullptr;
+
+            Node *consumer = nullptr;
+            for (auto &v: *graph->getMapped()) {
+                for (auto &in: *v.second->input()) {
+                    if (in.first != node->id())
+                        continue;
+
+                    // producer must be referenced exactly once, as first input
+                    if (consumer != nullptr || in != v.second->input()->at(0) || in.second != 0)
+                        return nullptr;
+
+                    consumer = v.second;
+                }
+            }
+
+            return consumer != nullptr && isRewritable(consumer) ? consumer : nullptr;
+        }
+
+        NDArray* GraphOptimizer::constantArray(Graph *graph, std::pair<int, int> &pair) {
+            auto variableSpace = graph->getVariableSpace();
+            if (graph->hasNode(pair.first) || !variableSpace->hasVariable(pair))
+                return nullptr;
+
+            auto var = variableSpace->getVariable(pair);
+            return var->isConstant() && var->hasNDArray() ? var->getNDArray() : nullptr;
+        }
+
+        int GraphOptimizer::putConstant(Graph *graph, NDArray *array) {
+            auto variableSpace = graph->getVariableSpace();
+
+            // external variables have negative ids, so we just take next free one
+            auto id = variableSpace->nextExternalId();
+            variableSpace->putVariable(id, array);
+            variableSpace->getVariable(id)->markConstant(true);
+
+            return id;
+        }
+
+        void GraphOptimizer::absorb(Graph *graph, Node *producer, Node *consumer, nd4j::ops::DeclarableOp *op, const std::vector<std::pair<int, int>> &inputs, const std::vector<int> &iArgs, const std::vector<double> &tArgs) {
+            // consumer keeps its id & layer, so neither graph outputs nor its own consumers are affected
+            *consumer->input() = inputs;
+
+            auto block = consumer->getContextPrototype();
+            *block->inputs() = inputs;
+            *block->getIArguments() = iArgs;
+            *block->getTArguments() = tArgs;
+            block->getBArguments()->clear();
+            block->getAxis()->clear();
+
+            consumer->replaceCustomOp(op);
+            consumer->markInplace(false);
+
+            graph->removeNode(producer->id());
+        }
+
+        bool GraphOptimizer::foldBatchNorm(Graph *graph, Node *conv, Node *batchnorm) {
+            auto block = batchnorm->getContextPrototype();
+            auto iArgs = block->getIArguments();
+            if (iArgs->size() < 2 || block->getTArguments()->empty())
+                return false;
+
+            const bool applyScale = iArgs->at(0) != 0;
+            const bool applyOffset = iArgs->at(1) != 0;
+            const double epsilon = block->getTArguments()->at(0);
+
+            auto bnInputs = batchnorm->input();
+            if (bnInputs->size() != 3 + (applyScale ? 1 : 0) + (applyOffset ? 1 : 0))
+                return false;
+
+            auto convInputs = conv->input();
+            auto weights = constantArray(graph, convInputs->at(1));
+            NDArray *bias = nullptr;
+            if (weights == nullptr || weights->rankOf() != 4 || !weights->isR())
+                return false;
+
+            if (convInputs->size() > 2 && (bias = constantArray(graph, convInputs->at(2))) == nullptr)
+                return false;
+
+            auto convArgs = conv->getContextPrototype()->getIArguments();
+            const bool isNHWC = convArgs->size() > 9 && convArgs->at(9) == 1;
+            const Nd4jLong oC = weights->sizeAt(3);
+
+            // each of mean, variance, gamma & beta must be constant, and must be broadcasted along channels only
+            std::vector<NDArray*> params;
+            for (int e = 1; e < (int) bnInputs->size(); e++) {
+                auto array = constantArray(graph, bnInputs->at(e));
+                if (array == nullptr || array->lengthOf() != oC)
+                    return false;
+
+                if (isNHWC ? array->sizeAt(-1) != oC : (array->rankOf() < 3 || array->sizeAt(-3) != oC))
+                    return false;
+
+                params.emplace_back(array);
+            }
+
+            auto mean = params[0];
+            auto variance = params[1];
+            auto gamma = applyScale ? params[2] : nullptr;
+            auto beta = applyOffset ? params[applyScale ? 3 : 2] : nullptr;
+
+            // gamma * (conv(x, W) + b - mean) / sqrt(variance + epsilon) + beta = conv(x, W * scale) + (b - mean) * scale + beta
+            NDArray scale('c', {oC}, weights->dataType());
+            auto shift = new NDArray('c', {oC}, weights->dataType());
+            for (Nd4jLong c = 0; c < oC; c++) {
+                double s = (gamma != nullptr ? gamma->e<double>(c) : 1.) / std::sqrt(variance->e<double>(c) + epsilon);
+                double b = bias != nullptr ? bias->e<double>(c) : 0.;
+                scale.p(c, s);
+                shift->p(c, (b - mean->e<double>(c)) * s + (beta != nullptr ? beta->e<double>(c) : 0.));
+            }
+
+            // original weights might be shared with other nodes, so we create new ones
+            auto folded = weights->dup('c');
+            folded->applyTrueBroadcast(nd4j::BroadcastOpsTuple::Multiply(), &scale, folded);
+
+            std::vector<std::pair<int, int>> inputs({convInputs->at(0), {putConstant(graph, folded), 0}, {putConstant(graph, shift), 0}});
+            auto convBlock = conv->getContextPrototype();
+            absorb(graph, conv, batchnorm, conv->getCustomOp(), inputs, *convBlock->getIArguments(), *convBlock->getTArguments());
+
+            return true;
+        }
+
+        int GraphOptimizer::fuseOperations(Graph *graph) {
+            auto registrator = nd4j::ops::OpRegistrator::getInstance();
+            auto fusedConv = registrator->getOperation("fused_conv2d");
+            auto fusedMatmul = registrator->getOperation("fused_matmul");
+
+            std::vector<int> producers;
+            for (auto &layer: *graph->getOnion())
+                for (auto node: *layer.second)
+                    if (isOp(node, "conv2d") || isOp(node, "fused_conv2d") || isOp(node, "matmul") || isOp(node, "fused_matmul"))
+                        producers.emplace_back(node->id());
+
+            int fused = 0;
+
+            // consumer that absorbed its producer is a producer itself, so chains like conv2d -> batchnorm -> biasadd -> relu collapse into single node
+            for (int p = 0; p < (int) producers.size(); p++) {
+                if (!graph->hasNode(producers[p]))
+                    continue;
+
+                auto producer = graph->nodeById(producers[p]);
+                auto consumer = singleConsumer(graph, producer);
+                if (consumer == nullptr)
+                    continue;
+
+                const bool isConv = isOp(producer, "conv2d") || isOp(producer, "fused_conv2d");
+                const bool isFused = isOp(producer, "fused_conv2d") || isOp(producer, "fused_matmul");
+                auto fusedOp = isConv ? fusedConv : fusedMatmul;
+
+                // activation is the last iArg of fused ops, and it's preceded by arguments of original op
+                const int activationArg = isConv ? 10 : 3;
+                auto block = producer->getContextPrototype();
+                std::vector<int> iArgs(*block->getIArguments());
+                iArgs.resize(activationArg + 1, 0);
+                const int activation = isFused ? iArgs[activationArg] : nd4j::ops::helpers::FUSED_NONE;
+                const bool hasBias = producer->input()->size() > 2;
+                const bool isNHWC = isConv && iArgs[9] == 1;
+
+                bool done = false;
+                double alpha = 0.;
+                int consumerActivation;
+
+                if (isOp(consumer, "biasadd")) {
+                    // biasadd always works along last dimension
+                    if (hasBias || activation != nd4j::ops::helpers::FUSED_NONE || consumer->input()->size() != 2 || (isConv && !isNHWC) || (!isConv && fusedOp == nullptr))
+                        continue;
+
+                    std::vector<std::pair<int, int>> inputs(*producer->input());
+                    inputs.emplace_back(consumer->input()->at(1));
+
+                    // conv2d takes bias natively, so it stays conv2d
+                    if (isConv && !isFused)
+                        absorb(graph, producer, consumer, producer->getCustomOp(), inputs, *block->getIArguments(), *block->getTArguments());
+                    else
+                        absorb(graph, producer, consumer, isFused ? producer->getCustomOp() : fusedOp, inputs, iArgs, *block->getTArguments());
+
+                    done = true;
+                } else if ((consumerActivation = activationOf(consumer, alpha)) >= 0) {
+                    if (activation != nd4j::ops::helpers::FUSED_NONE || fusedOp == nullptr)
+                        continue;
+
+                    std::vector<std::pair<int, int>> inputs(*producer->input());
+                    iArgs[activationArg] = consumerActivation;
+                    absorb(graph, producer, consumer, fusedOp, inputs, iArgs, std::vector<double>({alpha}));
+                    done = true;
+                } else if (isConv && isOp(consumer, "batchnorm") && activation == nd4j::ops::helpers::FUSED_NONE) {
+                    done = foldBatchNorm(graph, producer, consumer);
+                }
+
+                if (done) {
+                    fused++;
+                    producers.emplace_back(consumer->id());
+                }
+            }
+
+            return fused;
+        }
+
+        OptimizationStats GraphOptimizer::optimize(Graph *graph) {
+            OptimizationStats stats;
+
+            graph->buildGraph();
+            stats.nodesBefore = graph->getMapped()->size();
+            stats.nodesAfter = stats.nodesBefore;
+
+            // execution order of LOGIC ops isn't defined by onion, so such graphs are left as is
+            for (auto &v: *graph->getMapped())
+                if (v.second->opType() == OpType_LOGIC || v.second->isScoped() || v.second->hasGraphEmbedded())
+                    return stats;
+
+            stats.foldedNodes = foldConstants(graph);
+            stats.collapsedNodes = collapseIdentities(graph);
+            stats.mergedNodes = eliminateCommonSubexpressions(graph);
+            stats.fusedNodes = fuseOperations(graph);
+            stats.deadNodes = eliminateDeadNodes(graph);
+            stats.nodesAfter = graph->getMapped()->size();
+
+            nd4j_verbose("Graph optimized: %lld nodes -> %lld nodes; folded: %lld; collapsed: %lld; merged: %lld; fused: %lld; dead: %lld\n", stats.nodesBefore, stats.nodesAfter, stats.foldedNodes, stats.collapsedNodes, stats.mergedNodes, stats.fusedNodes, stats.deadNodes);
+
+            return stats;
+        }
+    }
+}
@@ -63,6 +63,14 @@ namespace nd4j {
             _variables.emplace_back(variable);
         }
 
+        void InferenceRequest::setSession(Nd4jLong sessionId) {
+            _session = sessionId;
+        }
+
+        Nd4jLong InferenceRequest::session() {
+            return _session;
+        }
+
         flatbuffers::Offset<FlatInferenceRequest> InferenceRequest::asFlatInferenceRequest(flatbuffers::FlatBufferBuilder &builder) {
             std::vector<flatbuffers::Offset<FlatVariable>> vec;
             for (Variable* v : _variables) {
@@ -73,7 +81,7 @@ namespace nd4j {
 
             auto vecOffset = builder.CreateVector(vec);
 
-            return CreateFlatInferenceRequest(builder, _id, vecOffset, confOffset);
+            return CreateFlatInferenceRequest(builder, _id, vecOffset, confOffset, _session);
         }
     }
 }
\ No newline at end of file
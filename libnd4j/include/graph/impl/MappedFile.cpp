@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MappedFile.h>
+#include <helpers/logger.h>
+#include <stdexcept>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace nd4j {
+    namespace graph {
+        MappedFile::MappedFile(const char *filename) {
+            struct stat stat_buf;
+            if (stat(filename, &stat_buf) != 0) {
+                nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", filename);
+                throw std::runtime_error("File not found");
+            }
+
+            _length = stat_buf.st_size;
+            if (_length == 0)
+                throw std::runtime_error("Can't map empty file");
+
+#ifndef _WIN32
+            int fd = open(filename, O_RDONLY);
+            if (fd >= 0) {
+                // private writable mapping: in-place modifications are never written back to the file
+                auto ptr = mmap(nullptr, (size_t) _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                close(fd);
+
+                if (ptr != MAP_FAILED) {
+                    _data = reinterpret_cast<uint8_t *>(ptr);
+                    _mapped = true;
+                    return;
+                }
+            }
+
+            nd4j_debug("mmap failed for [%s], falling back to read\n", filename);
+#endif
+
+            FILE *in = fopen(filename, "rb");
+            if (in == nullptr)
+                throw std::runtime_error("Can't open file");
+
+            _data = new uint8_t[_length];
+            auto cnt = fread(_data, 1, (size_t) _length, in);
+            fclose(in);
+
+            if ((Nd4jLong) cnt != _length) {
+                delete[] _data;
+                throw std::runtime_error("Failed to read file");
+            }
+        }
+
+        MappedFile::~MappedFile() {
+#ifndef _WIN32
+            if (_mapped) {
+                munmap(_data, (size_t) _length);
+                return;
+            }
+#endif
+            delete[] _data;
+        }
+
+        uint8_t* MappedFile::data() {
+            return _data;
+        }
+
+        Nd4jLong MappedFile::length() {
+            return _length;
+        }
+
+        bool MappedFile::isMapped() {
+            return _mapped;
+        }
+    }
+}
@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MemoryPlan.h>
+#include <graph/Graph.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        namespace {
+            struct ArrayLifetime {
+                std::pair<int, int> id;
+                int first;
+                int last;
+                Nd4jLong bytes;
+                Nd4jLong offset;
+            };
+
+            struct ArrayRange {
+                Nd4jLong start;
+                Nd4jLong end;
+                std::pair<int, int> id;
+            };
+        }
+
+        MemoryPlan* MemoryPlan::build(Graph *graph, VariableSpace *variableSpace) {
+            auto plan = new MemoryPlan();
+
+            // layer of the producer node for each array, and layer of its last consumer
+            std::map<std::pair<int, int>, int> producers;
+            std::map<std::pair<int, int>, int> consumers;
+
+            // outputs of inplace nodes live in memory of their inputs, so consumers of such outputs are consumers of original array
+            std::map<std::pair<int, int>, std::pair<int, int>> owners;
+            auto ownerOf = [&owners](const std::pair<int, int> &pair) -> std::pair<int, int> {
+                auto o = owners.find(pair);
+                return o == owners.end() ? pair : o->second;
+            };
+
+            for (auto &layer: *graph->getOnion()) {
+                for (auto node: *layer.second) {
+                    // execution order of these nodes isn't defined by onion, so we just don't plan such graphs
+                    if (node->opType() == OpType_LOGIC || node->isScoped() || node->hasGraphEmbedded())
+                        return plan;
+
+                    for (auto &in: *node->input()) {
+                        auto owner = ownerOf(in);
+
+                        // external variables aren't planned
+                        if (owner.first <= 0)
+                            continue;
+
+                        auto c = consumers.find(owner);
+                        if (c == consumers.end() || c->second < layer.first)
+                            consumers[owner] = layer.first;
+                    }
+
+                    // inplace nodes have no own memory: e-th output overwrites e-th input
+                    if (node->isInplace()) {
+                        auto inputs = node->input();
+                        for (int e = 0; e < (int) inputs->size() && variableSpace->hasVariable(node->id(), e); e++)
+                            owners[std::pair<int, int>(node->id(), e)] = ownerOf(inputs->at(e));
+
+                        continue;
+                    }
+
+                    for (int e = 0; variableSpace->hasVariable(node->id(), e); e++)
+                        producers[std::pair<int, int>(node->id(), e)] = layer.first;
+                }
+            }
+
+            // graph outputs must survive execution
+            for (auto id: *graph->getOutputIds())
+                for (int e = 0; variableSpace->hasVariable(id, e); e++)
+                    producers.erase(ownerOf(std::pair<int, int>(id, e)));
+
+            std::vector<ArrayRange> ranges;
+            std::vector<ArrayLifetime> arrays;
+            for (auto &p: producers) {
+                auto pair = p.first;
+                auto var = variableSpace->getVariable(pair);
+                if (!var->hasNDArray())
+                    continue;
+
+                auto array = var->getNDArray();
+                if (array->isEmpty() || array->isS() || array->lengthOf() == 0)
+                    continue;
+
+                Nd4jLong bytes = array->lengthOf() * array->sizeOfT();
+                auto start = reinterpret_cast<Nd4jLong>(array->getBuffer());
+                ranges.push_back({start, start + bytes, pair});
+
+                if (consumers.count(pair) == 0 || array->isView() || array->ews() != 1)
+                    continue;
+
+                arrays.push_back({pair, p.second, consumers[pair], bytes, 0L});
+            }
+
+            // ops might return views of their inputs, memory of such arrays can't be reused
+            std::map<std::pair<int, int>, bool> aliased;
+            std::sort(ranges.begin(), ranges.end(), [](const ArrayRange &a, const ArrayRange &b) -> bool {
+                return a.start < b.start;
+            });
+
+            for (int e = 1, owner = 0; e < (int) ranges.size(); e++) {
+                if (ranges[e].start < ranges[owner].end) {
+                    aliased[ranges[e].id] = true;
+                    aliased[ranges[owner].id] = true;
+                }
+
+                if (ranges[e].end > ranges[owner].end)
+                    owner = e;
+            }
+
+            // greedy assignment: largest arrays go first, each one gets lowest offset not used by arrays alive at the same time
+            std::sort(arrays.begin(), arrays.end(), [](const ArrayLifetime &a, const ArrayLifetime &b) -> bool {
+                return a.bytes != b.bytes ? a.bytes > b.bytes : a.id < b.id;
+            });
+
+            std::vector<ArrayLifetime> placed;
+            for (auto &a: arrays) {
+                if (aliased.count(a.id) > 0)
+                    continue;
+
+                a.bytes = (a.bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+                std::vector<ArrayLifetime> conflicts;
+                for (auto &p: placed)
+                    if (p.first <= a.last && a.first <= p.last)
+                        conflicts.push_back(p);
+
+                std::sort(conflicts.begin(), conflicts.end(), [](const ArrayLifetime &x, const ArrayLifetime &y) -> bool {
+                    return x.offset < y.offset;
+                });
+
+                Nd4jLong offset = 0L;
+                for (auto &c: conflicts) {
+                    if (offset + a.bytes <= c.offset)
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jLong>(offset, c.offset + c.bytes);
+                }
+
+                a.offset = offset;
+                placed.push_back(a);
+
+                plan->_regions[a.id] = std::pair<Nd4jLong, Nd4jLong>(offset, a.bytes);
+                plan->_peak = nd4j::math::nd4j_max<Nd4jLong>(plan->_peak, offset + a.bytes);
+                plan->_total += a.bytes;
+            }
+
+            return plan;
+        }
+
+        bool MemoryPlan::isPlanned(const std::pair<int, int> &pair) const {
+            return _regions.count(pair) > 0;
+        }
+
+        Nd4jLong MemoryPlan::offset(const std::pair<int, int> &pair) const {
+            auto r = _regions.find(pair);
+            return r == _regions.end() ? -1L : r->second.first;
+        }
+
+        Nd4jLong MemoryPlan::size(const std::pair<int, int> &pair) const {
+            auto r = _regions.find(pair);
+            return r == _regions.end() ? 0L : r->second.second;
+        }
+
+        int MemoryPlan::numberOfArrays() const {
+            return (int) _regions.size();
+        }
+
+        Nd4jLong MemoryPlan::getPeakBytes() const {
+            return _peak;
+        }
+
+        Nd4jLong MemoryPlan::getTotalBytes() const {
+            return _total;
+        }
+
+        void MemoryPlan::report(nd4j::memory::MemoryReport &report) const {
+            report.setPlannedPeak(_peak);
+            report.setPlannedTotal(_total);
+        }
+    }
+}
@@ -144,6 +144,20 @@ namespace nd4j {
                 _isInplace = true;
         }
 
+        void nd4j::graph::Node::replaceCustomOp(nd4j::ops::DeclarableOp *customOp) {
+            // legacy ops are wrapped into ops owned by node
+            if (_isDeductable && _customOp != nullptr)
+                delete _customOp;
+
+            _isDeductable = false;
+            _opType = OpType_CUSTOM;
+            _opNum = customOp->getOpHash();
+            setCustomOp(customOp);
+
+            if (_protoContext != nullptr)
+                _protoContext->setOpDescriptor(customOp->getOpDescriptor());
+        }
+
         bool nd4j::graph::Node::hasCustomOp() {
             return _customOp != nullptr;
         }
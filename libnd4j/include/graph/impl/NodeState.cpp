@@ -65,5 +65,13 @@ namespace nd4j {
         void NodeState::markExecuted(bool wasExecuted) {
             _executed = wasExecuted;
         }
+
+        Nd4jLong NodeState::frameId() {
+            return _frameId;
+        }
+
+        void NodeState::setFrameId(Nd4jLong frameId) {
+            _frameId = frameId;
+        }
     }
 }
\ No newline at end of file
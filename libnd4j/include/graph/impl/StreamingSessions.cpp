@@ -0,0 +1,359 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/StreamingSessions.h>
+#include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <helpers/NumaHelper.h>
+#include <exceptions/unknown_graph_exception.h>
+#include <exceptions/session_limit_exception.h>
+#include <chrono>
+
+namespace nd4j {
+    namespace graph {
+        class StreamingSessions::Session {
+        public:
+            // requests within session are executed one by one
+            std::mutex mutex;
+
+            // stored state, keyed by input it's fed into
+            std::map<std::pair<int, int>, NDArray*> states;
+
+            std::atomic<Nd4jLong> lastAccess{0L};
+
+            // number of requests using this session, sessions in use are never evicted as idle
+            std::atomic<int> users{0};
+
+            // set once session was evicted, guarded by mutex
+            bool ended = false;
+
+            Session() = default;
+
+            // called by request executed within this session, once it's finished
+            void leave() {
+                lastAccess.store(StreamingSessions::currentTime());
+                users--;
+                mutex.unlock();
+            }
+
+            ~Session() {
+                for (auto &v: states)
+                    delete v.second;
+            }
+        };
+
+        StreamingSessions* StreamingSessions::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new StreamingSessions();
+
+            return _INSTANCE;
+        }
+
+        Nd4jLong StreamingSessions::currentTime() {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void StreamingSessions::defineState(Nd4jLong graphId, const std::pair<int, int> &output, const std::pair<int, int> &input) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _states[graphId].emplace_back(output, input);
+        }
+
+        void StreamingSessions::defineStates(Nd4jLong graphId, const FlatGraph *flatGraph) {
+            if (flatGraph == nullptr || flatGraph->stateOutputs() == nullptr || flatGraph->stateInputs() == nullptr)
+                return;
+
+            auto outputs = flatGraph->stateOutputs();
+            auto inputs = flatGraph->stateInputs();
+            if (outputs->size() != inputs->size())
+                throw std::runtime_error("FlatGraph.stateOutputs and FlatGraph.stateInputs must have the same length");
+
+            std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> states;
+            for (int e = 0; e < (int) outputs->size(); e++) {
+                auto o = outputs->Get(e);
+                auto i = inputs->Get(e);
+                states.emplace_back(std::pair<int, int>(o->first(), o->second()), std::pair<int, int>(i->first(), i->second()));
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _states[graphId] = states;
+        }
+
+        void StreamingSessions::forgetGraph(Nd4jLong graphId) {
+            std::vector<std::shared_ptr<Session>> released;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _states.erase(graphId);
+
+                for (auto it = _sessions.begin(); it != _sessions.end(); ) {
+                    if (it->first.first == graphId) {
+                        released.emplace_back(it->second);
+                        it = _sessions.erase(it);
+                    } else
+                        ++it;
+                }
+            }
+
+            // state arrays are released outside of the lock
+            retire(released);
+        }
+
+        void StreamingSessions::setTimeToLive(Nd4jLong microseconds) {
+            _ttl.store(microseconds);
+        }
+
+        Nd4jLong StreamingSessions::timeToLive() {
+            return _ttl.load();
+        }
+
+        void StreamingSessions::setMaxSessions(int numberOfSessions) {
+            _maxSessions.store(numberOfSessions);
+        }
+
+        int StreamingSessions::maxSessions() {
+            return _maxSessions.load();
+        }
+
+        void StreamingSessions::sweep() {
+            auto now = currentTime();
+            auto last = _lastSweep.load();
+
+            // there's no reason to check sessions more often than 1/10 of their time-to-live
+            if (now - last < _ttl.load() / 10 || !_lastSweep.compare_exchange_strong(last, now))
+                return;
+
+            evictExpired();
+        }
+
+        void StreamingSessions::collectExpired(Nd4jLong threshold, std::vector<std::shared_ptr<Session>> &released) {
+            for (auto it = _sessions.begin(); it != _sessions.end(); ) {
+                // users are only added under _mutex, so session can't be picked up by new request once it's out of map
+                if (it->second->users.load() == 0 && it->second->lastAccess.load() < threshold) {
+                    released.emplace_back(it->second);
+                    it = _sessions.erase(it);
+                } else
+                    ++it;
+            }
+        }
+
+        void StreamingSessions::retire(std::vector<std::shared_ptr<Session>> &released) {
+            for (auto &session: released) {
+                // session lock is acquired only after request executing within this session is finished
+                std::lock_guard<std::mutex> sessionLock(session->mutex);
+                session->ended = true;
+
+                for (auto &v: session->states)
+                    delete v.second;
+
+                session->states.clear();
+            }
+
+            released.clear();
+        }
+
+        int StreamingSessions::evictExpired() {
+            auto threshold = currentTime() - _ttl.load();
+            std::vector<std::shared_ptr<Session>> released;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                collectExpired(threshold, released);
+            }
+
+            auto numEvicted = static_cast<int>(released.size());
+            retire(released);
+
+            return numEvicted;
+        }
+
+        flatbuffers::Offset<FlatResult> StreamingSessions::execute(Nd4jLong graphId, Nd4jLong sessionId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            sweep();
+
+            auto graph = GraphHolder::getInstance()->acquireGraph(graphId);
+            if (graph == nullptr)
+                throw unknown_graph_exception(graphId);
+
+            std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> states;
+            std::shared_ptr<Session> session;
+            while (true) {
+                std::vector<std::shared_ptr<Session>> released;
+                bool limitReached = false;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    // there's nothing to keep between requests, so graph without state defined doesn't get sessions
+                    auto sit = _states.find(graphId);
+                    if (sit == _states.end())
+                        break;
+
+                    states = sit->second;
+
+                    std::pair<Nd4jLong, Nd4jLong> key(graphId, sessionId);
+                    auto it = _sessions.find(key);
+                    if (it == _sessions.end() && (int) _sessions.size() >= _maxSessions.load()) {
+                        collectExpired(currentTime() - _ttl.load(), released);
+                        limitReached = (int) _sessions.size() >= _maxSessions.load();
+                    }
+
+                    if (!limitReached) {
+                        if (it == _sessions.end())
+                            it = _sessions.emplace(key, std::make_shared<Session>()).first;
+
+                        session = it->second;
+                        session->users++;
+                        session->lastAccess.store(currentTime());
+                    }
+                }
+
+                retire(released);
+
+                if (limitReached)
+                    throw session_limit_exception(graphId);
+
+                session->mutex.lock();
+                if (!session->ended)
+                    break;
+
+                // session was ended while this request was waiting for it, so request starts new one
+                session->mutex.unlock();
+                session->users--;
+                session.reset();
+            }
+
+            std::unique_ptr<Graph> run(graph->createSession(NumaHelper::getInstance()->sessionNode()));
+            if (session == nullptr)
+                return GraphExecutioner::execute(run.get(), builder, request);
+
+            try {
+                auto result = execute(session.get(), states, run.get(), builder, request);
+                session->leave();
+
+                return result;
+            } catch (...) {
+                session->leave();
+                throw;
+            }
+        }
+
+        flatbuffers::Offset<FlatResult> StreamingSessions::execute(Session *session, const std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> &states, Graph *run, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            auto varSpace = run->getVariableSpace();
+
+            // inputs provided explicitly by request override stored state
+            std::vector<std::pair<int, int>> provided;
+            if (request != nullptr && request->variables() != nullptr) {
+                for (int e = 0; e < (int) request->variables()->size(); e++) {
+                    auto fv = request->variables()->Get(e);
+                    if (fv->name() != nullptr && fv->name()->size() > 0) {
+                        std::string name = fv->name()->str();
+                        if (varSpace->hasVariable(&name)) {
+                            auto v = varSpace->getVariable(&name);
+                            provided.emplace_back(v->id(), v->index());
+                            continue;
+                        }
+                    }
+
+                    if (fv->id() != nullptr)
+                        provided.emplace_back(fv->id()->first(), fv->id()->second());
+                }
+            }
+
+            // state is copied into graph session, so stored state survives failed requests
+            for (auto &s: session->states) {
+                if (std::find(provided.begin(), provided.end(), s.first) != provided.end())
+                    continue;
+
+                varSpace->putVariable(s.first.first, s.first.second, s.second->dup());
+            }
+
+            auto result = GraphExecutioner::execute(run, builder, request);
+
+            // saving state for next request of this session
+            for (auto &s: states) {
+                auto output = s.first;
+                if (!varSpace->hasVariable(output))
+                    continue;
+
+                auto var = varSpace->getVariable(output);
+                if (!var->hasNDArray())
+                    continue;
+
+                auto &stored = session->states[s.second];
+                delete stored;
+                stored = var->getNDArray()->dup();
+            }
+
+            return result;
+        }
+
+        void StreamingSessions::endSession(Nd4jLong graphId, Nd4jLong sessionId) {
+            std::vector<std::shared_ptr<Session>> released;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                std::pair<Nd4jLong, Nd4jLong> key(graphId, sessionId);
+                auto it = _sessions.find(key);
+                if (it != _sessions.end()) {
+                    released.emplace_back(it->second);
+                    _sessions.erase(it);
+                }
+            }
+
+            // request still executing within this session finishes before its state is released
+            retire(released);
+        }
+
+        bool StreamingSessions::hasSession(Nd4jLong graphId, Nd4jLong sessionId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::pair<Nd4jLong, Nd4jLong> key(graphId, sessionId);
+
+            return _sessions.count(key) > 0;
+        }
+
+        int StreamingSessions::numberOfSessions() {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            return static_cast<int>(_sessions.size());
+        }
+
+        NDArray* StreamingSessions::state(Nd4jLong graphId, Nd4jLong sessionId, const std::pair<int, int> &input) {
+            std::shared_ptr<Session> session;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                std::pair<Nd4jLong, Nd4jLong> key(graphId, sessionId);
+                auto it = _sessions.find(key);
+                if (it == _sessions.end())
+                    return nullptr;
+
+                session = it->second;
+            }
+
+            std::lock_guard<std::mutex> sessionLock(session->mutex);
+            if (session->ended)
+                return nullptr;
+
+            auto it = session->states.find(input);
+
+            return it == session->states.end() ? nullptr : it->second->dup();
+        }
+
+        StreamingSessions* StreamingSessions::_INSTANCE = 0;
+    }
+}
@@ -57,8 +57,12 @@ namespace nd4j {
             result->_external = this->_external;
             result->_id = this->_id;
             result->_readOnly = this->_readOnly;
+            result->_constant = this->_constant;
             result->_name = this->_name;
             result->_index = this->_index;
+            result->_shape = this->_shape;
+            result->_dtype = this->_dtype;
+            result->_variableType = this->_variableType;
 
             if (this->_ndarray != nullptr)
                 result->_ndarray = this->_ndarray->dup(this->_ndarray->ordering());
@@ -140,6 +144,14 @@ namespace nd4j {
             this->_readOnly = reallyReadOnly;
         }
 
+        bool nd4j::graph::Variable::isConstant() {
+            return _constant;
+        }
+
+        void nd4j::graph::Variable::markConstant(bool reallyConstant) {
+            this->_constant = reallyConstant;
+        }
+
         nd4j::NDArray * nd4j::graph::Variable::getNDArray() {
             if (_variableType != VariableType::NDARRAY) {
                 nd4j_printf("Variable[%i:%i/<%s>] is has [%s] type, but NDArray was requested\n", this->_id, this->_index, this->_name.c_str(), EnumUtils::_VariableTypeToString(_variableType));
@@ -189,7 +201,7 @@ namespace nd4j {
         }
 
 
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -208,7 +220,7 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = zeroCopy ? nd4j::graph::FlatUtils::fromFlatArrayView(ar) : nd4j::graph::FlatUtils::fromFlatArray(ar);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -222,10 +234,11 @@ namespace nd4j {
                         if (ar->dtype() == DataType_UTF8) {
                             _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
                         } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = zeroCopy ? nd4j::graph::FlatUtils::fromFlatArrayView(ar) : nd4j::graph::FlatUtils::fromFlatArray(ar);
                         }
 
                         _variableType = VariableType::NDARRAY;
+                        _constant = true;
                     }
                     break;
                 case VarType_ARRAY: {
@@ -233,7 +246,7 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray = zeroCopy ? nd4j::graph::FlatUtils::fromFlatArrayView(ar) : nd4j::graph::FlatUtils::fromFlatArray(ar);
                             // _ndarray->triggerAllocationFlag(true);
                         }
 
@@ -257,6 +270,8 @@ namespace nd4j {
                             for (int i = 0; i < flatVariable->shape()->size(); i++)
                                 _shape.emplace_back(flatVariable->shape()->Get(i));
 
+                            _dtype = DataTypeUtils::fromFlatDataType(flatVariable->dtype());
+
                             if (_ndarray == nullptr)
                                 _variableType = VariableType::PLACEHOLDER;
                         }
@@ -271,6 +286,10 @@ namespace nd4j {
             return _shape;
         }
 
+        nd4j::DataType nd4j::graph::Variable::dataType() {
+            return _ndarray != nullptr ? _ndarray->dataType() : _dtype;
+        }
+
         nd4j::graph::Variable::Variable(bool placeholder) {
             _placeholder = placeholder;
         }
@@ -315,12 +334,9 @@ namespace nd4j {
         flatbuffers::Offset<FlatVariable> Variable::asFlatVariable(flatbuffers::FlatBufferBuilder &builder) {
             if (this->hasNDArray()) {
                 auto array = this->getNDArray();
-                auto fShape = builder.CreateVector(array->getShapeInfoAsFlatVector());
-
-                auto fBuffer = builder.CreateVector(array->asByteVector());
 
-                // packing array
-                auto fArray = CreateFlatArray(builder, fShape, fBuffer, (nd4j::graph::DataType) array->dataType());
+                // packing array, data goes directly into builder
+                auto fArray = FlatUtils::toFlatArray(builder, *array);
 
                 // packing id/index of this var
                 auto fVid = CreateIntPair(builder, this->_id, this->_index);
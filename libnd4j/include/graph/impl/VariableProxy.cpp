@@ -104,6 +104,10 @@ namespace nd4j {
             return result;
         }
 
+        int VariableProxy::nextExternalId() {
+            return nd4j::math::nd4j_min<int>(_backed->nextExternalId(), _current->nextExternalId());
+        }
+
         
         bool VariableProxy::hasVariable(std::string *symbol) {
             return _current->hasVariable(symbol) || _backed->hasVariable(symbol);
@@ -276,6 +280,18 @@ namespace nd4j {
         }  
 
         
+        void VariableProxy::attachSlots(const std::map<std::pair<int, int>, int>* slots) {
+            // backed VariableSpace has slots attached by its own Graph
+            _current->attachSlots(slots);
+        }
+
+
+        Variable* VariableProxy::slotVariable(int slot) {
+            auto v = _current->slotVariable(slot);
+            return v != nullptr ? v : _backed->slotVariable(slot);
+        }
+
+
         nd4j::memory::Workspace * nd4j::graph::VariableProxy::workspace() {
             return _workspace;
         }
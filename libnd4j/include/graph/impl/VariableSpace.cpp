@@ -20,6 +20,7 @@
 
 #include <graph/VariableSpace.h>
 #include <NativeOps.h>
+#include <limits>
 
 namespace nd4j {
     namespace graph {
@@ -197,6 +198,35 @@ namespace nd4j {
             return result;
         }
 
+        int VariableSpace::nextExternalId() {
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            // both maps are ordered, so lowest ids are in front
+            int id = -1;
+            if (!_variables.empty())
+                id = nd4j::math::nd4j_min<int>(id, _variables.begin()->first - 1);
+
+            if (!_paired.empty())
+                id = nd4j::math::nd4j_min<int>(id, _paired.begin()->first.first - 1);
+
+            return id;
+        }
+
+        std::vector<Variable*> VariableSpace::getPendingVariables() {
+            std::vector<Variable*> result;
+
+            for (auto &v: _paired) {
+                // negative ids are reserved for external variables
+                if (v.first.first < 0)
+                    continue;
+
+                if (!v.second->hasNDArray() && !v.second->hasNDArrayList())
+                    result.emplace_back(v.second);
+            }
+
+            return result;
+        }
+
         Nd4jLong nd4j::graph::VariableSpace::internalMemory() {
             Nd4jLong size = 0;
             for (auto n: _internal) {
@@ -231,6 +261,10 @@ namespace nd4j {
             //std::pair<std::pair<int, int>, nd4j::graph::Variable *> p(pair, variable);
             _paired[pair] = variable;
 
+            // external variables are resolved by id, see getVariable(pair)
+            if (pair.first >= 0)
+                updateSlots(pair, variable);
+
             _varmap.unlock();
         }
 
@@ -257,7 +291,11 @@ namespace nd4j {
         }
 
         void VariableSpace::trackList(nd4j::NDArrayList* list) {
+            _varmap.lock();
+
             _lists.emplace_back(list);
+
+            _varmap.unlock();
         }
 
         void nd4j::graph::VariableSpace::putVariable(int id, Variable *variable) {
@@ -297,6 +335,9 @@ namespace nd4j {
                 _external.push_back(variable);
 
                 _variables[id] = variable;
+
+                std::pair<int, int> pair(id, 0);
+                updateSlots(pair, variable);
             } else {
                 _internal.push_back(variable);
 
@@ -363,6 +404,9 @@ namespace nd4j {
                 delete p;
 
             _lists.clear();
+
+            // planned arrays don't own their buffers, so arena goes last
+            delete[] _arena;
         }
 
         VariableSpace& VariableSpace::operator=(const VariableSpace& other) {
@@ -439,6 +483,91 @@ namespace nd4j {
             return _flow;
         }
 
+        void VariableSpace::updateSlots(std::pair<int,int>& pair, Variable *variable) {
+            if (_slots == nullptr)
+                return;
+
+            if (pair.first < 0) {
+                // any output index of external variable refers to the same Variable
+                std::pair<int, int> first(pair.first, std::numeric_limits<int>::min());
+                for (auto it = _slots->lower_bound(first); it != _slots->end() && it->first.first == pair.first; ++it)
+                    _slotted[it->second] = variable;
+            } else {
+                auto it = _slots->find(pair);
+                if (it != _slots->end())
+                    _slotted[it->second] = variable;
+            }
+        }
+
+        void VariableSpace::attachSlots(const std::map<std::pair<int, int>, int>* slots) {
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            _slots = slots;
+            _slotted.assign(slots == nullptr ? 0 : slots->size(), nullptr);
+
+            if (slots == nullptr)
+                return;
+
+            // picking up everything stored so far
+            for (auto &v: *slots) {
+                if (v.first.first < 0) {
+                    auto it = _variables.find(v.first.first);
+                    if (it != _variables.end())
+                        _slotted[v.second] = it->second;
+                } else {
+                    auto it = _paired.find(v.first);
+                    if (it != _paired.end())
+                        _slotted[v.second] = it->second;
+                }
+            }
+        }
+
+        Variable* VariableSpace::slotVariable(int slot) {
+            if (slot < 0 || slot >= _slotted.size())
+                return nullptr;
+
+            return _slotted[slot];
+        }
+
+        void VariableSpace::attachMemoryPlan(MemoryPlan* plan) {
+            // arena can't be replaced once planned arrays were created
+            if (_memoryPlan != nullptr || plan == nullptr)
+                return;
+
+            _memoryPlan = plan;
+            if (plan->getPeakBytes() > 0) {
+                _arenaSize = plan->getPeakBytes();
+                _arena = new int8_t[_arenaSize + MemoryPlan::ALIGNMENT];
+            }
+        }
+
+        MemoryPlan* VariableSpace::memoryPlan() {
+            return _memoryPlan;
+        }
+
+        Nd4jLong VariableSpace::arenaSize() {
+            return _arenaSize;
+        }
+
+        NDArray* VariableSpace::plannedArray(std::pair<int,int>& pair, Nd4jLong *shapeInfo, nd4j::LaunchContext *context) {
+            if (_arena == nullptr || !_memoryPlan->isPlanned(pair))
+                return nullptr;
+
+            auto dtype = ArrayOptions::dataType(shapeInfo);
+            if (shape::isEmpty(shapeInfo) || DataTypeUtils::isS(dtype) || shape::elementWiseStride(shapeInfo) != 1)
+                return nullptr;
+
+            // shapes might change between runs, so planned region might be too small
+            if (shape::length(shapeInfo) * (Nd4jLong) DataTypeUtils::sizeOfElement(dtype) > _memoryPlan->size(pair))
+                return nullptr;
+
+            auto base = (reinterpret_cast<Nd4jLong>(_arena) + MemoryPlan::ALIGNMENT - 1) / MemoryPlan::ALIGNMENT * MemoryPlan::ALIGNMENT;
+            auto array = new NDArray(reinterpret_cast<int8_t *>(base) + _memoryPlan->offset(pair), shapeInfo, context, false);
+            array->nullify();
+
+            return array;
+        }
+
         VariableSpace::VariableSpace() {
             _handles = new std::vector<Variable *>;
         }
@@ -0,0 +1,453 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_BLOCKEDGEMM_H
+#define LIBND4J_BLOCKEDGEMM_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <op_boilerplate.h>
+#include <openmp_pragmas.h>
+#include <templatemath.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+#include <memory/CachingHostAllocator.h>
+#include <type_traits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// macro-tile sizes, in elements: packed A block (MC x KC) should fit into L2, packed B panel (KC x NC) into L3
+#define GEMM_MC 128
+#define GEMM_KC 256
+#define GEMM_NC 2048
+
+// columns of B panel processed by single parallel task, multiple of every kernel's NR
+#define GEMM_NT 256
+
+// below this number of multiply-adds gemm runs single-threaded
+#define GEMM_PARALLEL_THRESHOLD 32768
+
+namespace nd4j {
+
+    /**
+     * Type products are accumulated in: half types are accumulated in float, and rounded once on store
+     */
+    template <typename T>
+    struct GemmAccumulator {
+        typedef T type;
+    };
+
+    template <>
+    struct GemmAccumulator<float16> {
+        typedef float type;
+    };
+
+    template <>
+    struct GemmAccumulator<bfloat16> {
+        typedef float type;
+    };
+
+    /**
+     * Converts contiguous run of elements, used while packing panels. Half types use vector conversions if CPU supports them,
+     * these are compiled regardless of target arch and picked at runtime, see BlockedGemm.cpp
+     */
+    template <typename S, typename T>
+    struct GemmConverter {
+        static FORCEINLINE void convert(const S *src, const int length, T *dst) {
+            for (int e = 0; e < length; e++)
+                dst[e] = static_cast<T>(src[e]);
+        }
+    };
+
+    template <>
+    struct ND4J_EXPORT GemmConverter<float16, float> {
+        static void convert(const float16 *src, const int length, float *dst);
+    };
+
+    template <>
+    struct ND4J_EXPORT GemmConverter<bfloat16, float> {
+        static void convert(const bfloat16 *src, const int length, float *dst);
+    };
+
+    /**
+     * Epilogue is applied to every element of C once its final value is known, while it's stored.
+     * It gets value in accumulation type along with column of C, so per-column bias and activation fit into it
+     */
+    struct GemmNoEpilogue {
+        template <typename Acc>
+        FORCEINLINE Acc operator()(const Acc value, const int column) const {
+            return value;
+        }
+    };
+
+    /**
+     * Default kernel: panels are converted to accumulation type, and MR x NR tile is computed with plain SIMD loop
+     */
+    template <typename X, typename Y, typename Z>
+    class ConvertingGemmKernel {
+    public:
+        typedef typename GemmAccumulator<Z>::type Acc;
+        typedef Acc PackedA;
+        typedef Acc PackedB;
+
+        static const int MR = 4;
+        static const int NR = 16;
+
+        // number of k steps packed into single element
+        static const int KP = 1;
+
+        // K block length
+        static const int KC = GEMM_KC;
+
+        // copies MR x kc panel of A, k-major, zero-padded
+        static void packA(const X *A, const Nd4jLong rowStride, const Nd4jLong colStride, const int mr, const int kc, PackedA *panel) {
+            if (rowStride == 1 && mr == MR) {
+                for (int k = 0; k < kc; k++)
+                    GemmConverter<X, Acc>::convert(A + k * colStride, MR, panel + k * MR);
+            } else if (colStride == 1) {
+                Acc row[GEMM_KC];
+                for (int i = 0; i < mr; i++) {
+                    GemmConverter<X, Acc>::convert(A + i * rowStride, kc, row);
+                    for (int k = 0; k < kc; k++)
+                        panel[k * MR + i] = row[k];
+                }
+            } else {
+                for (int k = 0; k < kc; k++)
+                    for (int i = 0; i < mr; i++)
+                        panel[k * MR + i] = static_cast<Acc>(A[i * rowStride + k * colStride]);
+            }
+
+            for (int i = mr; i < MR; i++)
+                for (int k = 0; k < kc; k++)
+                    panel[k * MR + i] = static_cast<Acc>(0);
+        }
+
+        // copies kc x NR panel of B, k-major, zero-padded
+        static void packB(const Y *B, const Nd4jLong rowStride, const Nd4jLong colStride, const int nr, const int kc, PackedB *panel) {
+            if (colStride == 1) {
+                for (int k = 0; k < kc; k++)
+                    GemmConverter<Y, Acc>::convert(B + k * rowStride, nr, panel + k * NR);
+            } else if (rowStride == 1) {
+                Acc column[GEMM_KC];
+                for (int j = 0; j < nr; j++) {
+                    GemmConverter<Y, Acc>::convert(B + j * colStride, kc, column);
+                    for (int k = 0; k < kc; k++)
+                        panel[k * NR + j] = column[k];
+                }
+            } else {
+                for (int k = 0; k < kc; k++)
+                    for (int j = 0; j < nr; j++)
+                        panel[k * NR + j] = static_cast<Acc>(B[k * rowStride + j * colStride]);
+            }
+
+            for (int k = 0; k < kc; k++)
+                for (int j = nr; j < NR; j++)
+                    panel[k * NR + j] = static_cast<Acc>(0);
+        }
+
+        static FORCEINLINE void compute(const int kc, const PackedA *a, const PackedB *b, Acc *acc) {
+            for (int e = 0; e < MR * NR; e++)
+                acc[e] = static_cast<Acc>(0);
+
+            for (int k = 0; k < kc; k++) {
+                auto ak = a + k * MR;
+                auto bk = b + k * NR;
+
+                for (int i = 0; i < MR; i++) {
+                    const Acc ai = ak[i];
+                    auto acci = acc + i * NR;
+
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < NR; j++)
+                        acci[j] += ai * bk[j];
+                }
+            }
+        }
+    };
+
+    /**
+     * bfloat16 kernel for CPUs with AVX512-BF16: panels keep pairs of consecutive k values in single 32-bit element,
+     * and vdpbf16ps accumulates both products of each pair into fp32
+     */
+    class ND4J_EXPORT BF16DotGemmKernel {
+    private:
+        static FORCEINLINE uint32_t pairOf(const bfloat16 &lo, const bfloat16 &hi) {
+            return static_cast<uint32_t>(static_cast<uint16_t>(lo._data)) | (static_cast<uint32_t>(static_cast<uint16_t>(hi._data)) << 16);
+        }
+
+    public:
+        typedef float Acc;
+        typedef uint32_t PackedA;
+        typedef uint32_t PackedB;
+
+        static const int MR = 8;
+        static const int NR = 32;
+        static const int KP = 2;
+        static const int KC = GEMM_KC;
+
+        /**
+         * This method returns TRUE if kernel was compiled in, and current CPU supports it
+         */
+        static bool isAvailable();
+
+        // throws if kernel isn't available, so it must be checked via isAvailable() first
+        static void compute(const int kp, const PackedA *a, const PackedB *b, Acc *acc);
+
+        static void packA(const bfloat16 *A, const Nd4jLong rowStride, const Nd4jLong colStride, const int mr, const int kc, PackedA *panel) {
+            const bfloat16 zero;
+            const int kp = (kc + 1) / 2;
+
+            for (int p = 0; p < kp; p++) {
+                const int k = 2 * p;
+                for (int i = 0; i < mr; i++)
+                    panel[p * MR + i] = pairOf(A[i * rowStride + k * colStride], k + 1 < kc ? A[i * rowStride + (k + 1) * colStride] : zero);
+
+                for (int i = mr; i < MR; i++)
+                    panel[p * MR + i] = 0;
+            }
+        }
+
+        static void packB(const bfloat16 *B, const Nd4jLong rowStride, const Nd4jLong colStride, const int nr, const int kc, PackedB *panel) {
+            const bfloat16 zero;
+            const int kp = (kc + 1) / 2;
+
+            for (int p = 0; p < kp; p++) {
+                const int k = 2 * p;
+                for (int j = 0; j < nr; j++)
+                    panel[p * NR + j] = pairOf(B[k * rowStride + j * colStride], k + 1 < kc ? B[(k + 1) * rowStride + j * colStride] : zero);
+
+                for (int j = nr; j < NR; j++)
+                    panel[p * NR + j] = 0;
+            }
+        }
+    };
+
+    /**
+     * This class provides cache-blocked GEMM for types not covered by BLAS: mixed types, half types and integers.
+     *
+     * Computes C = alpha * A x B + beta * C, with every matrix addressed via its row and column strides,
+     * so any 2D layout (c, f or transposed) is handled the same way. A and B are packed into contiguous
+     * panels, and MR x NR micro-tiles of C are computed out of these panels by kernel.
+     * Parallelism is over (MC x NT) tiles of C within each packed B panel.
+     *
+     * Half types are accumulated in fp32 and rounded into C only once. bfloat16 inputs use AVX512-BF16 kernel
+     * if CPU supports it. QuantizedGemm runs its int8 kernels through the same driver.
+     */
+    template <typename X, typename Y, typename Z>
+    class BlockedGemm {
+    private:
+        // first K block applies beta, following ones accumulate into C, and the last one applies epilogue. n0 is column of C the tile starts at
+        template <typename Acc, typename T, typename Epilogue>
+        static FORCEINLINE void store(const Acc *acc, const int ldAcc, const int mr, const int nr, const Acc alpha, const Acc beta, const bool first, const bool last, const int n0, const Epilogue &epilogue, T *C, const Nd4jLong cRowStride, const Nd4jLong cColStride) {
+            for (int i = 0; i < mr; i++) {
+                auto c = C + i * cRowStride;
+                auto acci = acc + i * ldAcc;
+
+                if (!first) {
+                    if (last) {
+                        for (int j = 0; j < nr; j++)
+                            c[j * cColStride] = static_cast<T>(epilogue(static_cast<Acc>(c[j * cColStride]) + alpha * acci[j], n0 + j));
+                    } else {
+                        for (int j = 0; j < nr; j++)
+                            c[j * cColStride] = static_cast<T>(static_cast<Acc>(c[j * cColStride]) + alpha * acci[j]);
+                    }
+                } else if (beta != static_cast<Acc>(0)) {
+                    if (last) {
+                        for (int j = 0; j < nr; j++)
+                            c[j * cColStride] = static_cast<T>(epilogue(alpha * acci[j] + beta * static_cast<Acc>(c[j * cColStride]), n0 + j));
+                    } else {
+                        for (int j = 0; j < nr; j++)
+                            c[j * cColStride] = static_cast<T>(alpha * acci[j] + beta * static_cast<Acc>(c[j * cColStride]));
+                    }
+                } else {
+                    if (last) {
+                        for (int j = 0; j < nr; j++)
+                            c[j * cColStride] = static_cast<T>(epilogue(alpha * acci[j], n0 + j));
+                    } else {
+                        for (int j = 0; j < nr; j++)
+                            c[j * cColStride] = static_cast<T>(alpha * acci[j]);
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * This method runs blocked GEMM with given kernel: Kernel provides Acc, PackedA/PackedB types, MR x NR tile,
+         * KP k steps per packed element and KC block length, along with packA/packB/compute methods.
+         * Products are accumulated in Kernel::Acc and stored into C scaled by alpha/beta, with epilogue applied on final store
+         */
+        template <typename Kernel, typename Epilogue = GemmNoEpilogue>
+        static void run(const int M, const int N, const int K, const double alpha,
+                        const X *A, const Nd4jLong aRowStride, const Nd4jLong aColStride,
+                        const Y *B, const Nd4jLong bRowStride, const Nd4jLong bColStride,
+                        const double beta,
+                        Z *C, const Nd4jLong cRowStride, const Nd4jLong cColStride,
+                        const bool parallel,
+                        const Epilogue &epilogue = Epilogue()) {
+
+            typedef typename Kernel::Acc Acc;
+            typedef typename Kernel::PackedA PackedA;
+            typedef typename Kernel::PackedB PackedB;
+
+            const int MR = Kernel::MR;
+            const int NR = Kernel::NR;
+            const Acc alphaA(alpha), betaA(beta);
+
+            const int kpMax = (nd4j::math::nd4j_min<int>(Kernel::KC, K) + Kernel::KP - 1) / Kernel::KP;
+            const int ncMax = nd4j::math::nd4j_min<int>(GEMM_NC, (N + NR - 1) / NR * NR);
+            const int mcMax = (nd4j::math::nd4j_min<int>(GEMM_MC, M) + MR - 1) / MR * MR;
+            const int numRowTiles = (M + GEMM_MC - 1) / GEMM_MC;
+
+            // packing buffers are reused between calls via host cache: one B panel, and one A block per row tile,
+            // so each A block is packed once per K block and shared by all column tiles
+            auto allocator = memory::CachingHostAllocator::getInstance();
+            const Nd4jLong aLength = (Nd4jLong) mcMax * kpMax;
+            auto bBuffer = reinterpret_cast<PackedB*>(allocator->allocate((Nd4jLong) kpMax * ncMax * sizeof(PackedB)));
+            auto aBuffers = reinterpret_cast<PackedA*>(allocator->allocate(aLength * numRowTiles * sizeof(PackedA)));
+
+            // if narrow C would be updated once per K block, partial sums are kept in fp32 buffer instead
+            const bool buffered = !std::is_same<Z, Acc>::value && K > Kernel::KC;
+            auto cBuffer = buffered ? reinterpret_cast<Acc*>(allocator->allocate((Nd4jLong) M * N * sizeof(Acc))) : nullptr;
+
+            for (int jc = 0; jc < N; jc += GEMM_NC) {
+                const int nc = nd4j::math::nd4j_min<int>(GEMM_NC, N - jc);
+
+                for (int pc = 0; pc < K; pc += Kernel::KC) {
+                    const int kc = nd4j::math::nd4j_min<int>(Kernel::KC, K - pc);
+                    const int kp = (kc + Kernel::KP - 1) / Kernel::KP;
+                    const bool first = pc == 0;
+                    const bool last = pc + kc >= K;
+
+                    const int numPanels = (nc + NR - 1) / NR;
+
+                    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel && numPanels > 1) schedule(static))
+                    for (int p = 0; p < numPanels; p++) {
+                        const int jr = p * NR;
+                        Kernel::packB(B + pc * bRowStride + (jc + jr) * bColStride, bRowStride, bColStride, nd4j::math::nd4j_min<int>(NR, nc - jr), kc, bBuffer + jr * kp);
+                    }
+
+                    const int numRowPanels = mcMax / MR;
+
+                    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel && numRowTiles * numRowPanels > 1) schedule(static) collapse(2))
+                    for (int ic = 0; ic < numRowTiles; ic++) {
+                        for (int p = 0; p < numRowPanels; p++) {
+                            const int m0 = ic * GEMM_MC;
+                            const int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - m0);
+                            const int ir = p * MR;
+
+                            if (ir < mc)
+                                Kernel::packA(A + (m0 + ir) * aRowStride + pc * aColStride, aRowStride, aColStride, nd4j::math::nd4j_min<int>(MR, mc - ir), kc, aBuffers + ic * aLength + ir * kp);
+                        }
+                    }
+
+                    const int numColTiles = (nc + GEMM_NT - 1) / GEMM_NT;
+
+                    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel && numRowTiles * numColTiles > 1) schedule(dynamic) collapse(2))
+                    for (int ic = 0; ic < numRowTiles; ic++) {
+                        for (int jt = 0; jt < numColTiles; jt++) {
+                            const int m0 = ic * GEMM_MC;
+                            const int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - m0);
+                            const int n0 = jt * GEMM_NT;
+                            const int nt = nd4j::math::nd4j_min<int>(GEMM_NT, nc - n0);
+                            auto aBuffer = aBuffers + ic * aLength;
+
+                            Acc acc[MR * NR];
+
+                            for (int jr = 0; jr < nt; jr += NR) {
+                                const int nr = nd4j::math::nd4j_min<int>(NR, nt - jr);
+                                auto bPanel = bBuffer + (n0 + jr) * kp;
+
+                                for (int ir = 0; ir < mc; ir += MR) {
+                                    const int mr = nd4j::math::nd4j_min<int>(MR, mc - ir);
+
+                                    Kernel::compute(kp, aBuffer + ir * kp, bPanel, acc);
+
+                                    if (buffered)
+                                        store<Acc, Acc>(acc, NR, mr, nr, static_cast<Acc>(1), static_cast<Acc>(0), first, false, jc + n0 + jr, GemmNoEpilogue(), cBuffer + (Nd4jLong) (m0 + ir) * N + jc + n0 + jr, N, 1);
+                                    else
+                                        store<Acc, Z>(acc, NR, mr, nr, alphaA, betaA, first, last, jc + n0 + jr, epilogue, C + (m0 + ir) * cRowStride + (jc + n0 + jr) * cColStride, cRowStride, cColStride);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (buffered) {
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallel && M > 1) schedule(static))
+                for (int m = 0; m < M; m++)
+                    store<Acc, Z>(cBuffer + (Nd4jLong) m * N, N, 1, N, alphaA, betaA, true, true, 0, epilogue, C + m * cRowStride, cRowStride, cColStride);
+
+                allocator->release(cBuffer);
+            }
+
+            allocator->release(aBuffers);
+            allocator->release(bBuffer);
+        }
+
+    public:
+        /**
+         * C[m,n] = epilogue(alpha * sum(A[m,k] * B[k,n]) + beta * C[m,n], n)
+         *
+         * @param parallel - if FALSE, gemm runs in calling thread only, i.e. when caller parallelizes over batch itself
+         * @param epilogue - applied to each element of C on final store, i.e. bias and activation of fused ops
+         */
+        template <typename Epilogue = GemmNoEpilogue>
+        static void gemm(const int M, const int N, const int K, const double alpha,
+                         const X *A, const Nd4jLong aRowStride, const Nd4jLong aColStride,
+                         const Y *B, const Nd4jLong bRowStride, const Nd4jLong bColStride,
+                         const double beta,
+                         Z *C, const Nd4jLong cRowStride, const Nd4jLong cColStride,
+                         bool parallel = true,
+                         const Epilogue &epilogue = Epilogue()) {
+
+            if (M <= 0 || N <= 0)
+                return;
+
+            // nothing to multiply, so C is just scaled
+            if (K <= 0) {
+                typedef typename GemmAccumulator<Z>::type Acc;
+                const Acc betaA(beta);
+                for (int m = 0; m < M; m++)
+                    for (int n = 0; n < N; n++) {
+                        auto c = C + m * cRowStride + n * cColStride;
+                        *c = static_cast<Z>(epilogue(betaA != static_cast<Acc>(0) ? betaA * static_cast<Acc>(*c) : static_cast<Acc>(0), n));
+                    }
+
+                return;
+            }
+
+            parallel = parallel && (Nd4jLong) M * N * K > GEMM_PARALLEL_THRESHOLD;
+
+            // for all other types DotKernel is the default one, so this branch is never taken
+            const bool bf16 = std::is_same<X, bfloat16>::value && std::is_same<Y, bfloat16>::value;
+            typedef typename std::conditional<std::is_same<X, bfloat16>::value && std::is_same<Y, bfloat16>::value, BF16DotGemmKernel, ConvertingGemmKernel<X, Y, Z>>::type DotKernel;
+
+            if (bf16 && BF16DotGemmKernel::isAvailable())
+                run<DotKernel>(M, N, K, alpha, A, aRowStride, aColStride, B, bRowStride, bColStride, beta, C, cRowStride, cColStride, parallel, epilogue);
+            else
+                run<ConvertingGemmKernel<X, Y, Z>>(M, N, K, alpha, A, aRowStride, aColStride, B, bRowStride, bColStride, beta, C, cRowStride, cColStride, parallel, epilogue);
+        }
+    };
+}
+
+#endif //LIBND4J_BLOCKEDGEMM_H
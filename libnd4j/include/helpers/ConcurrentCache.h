@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CONCURRENTCACHE_H
+#define LIBND4J_CONCURRENTCACHE_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/EpochManager.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#define CONCURRENT_CACHE_SHARDS_BITS 6
+#define CONCURRENT_CACHE_SHARDS (1 << CONCURRENT_CACHE_SHARDS_BITS)
+#define CONCURRENT_CACHE_INITIAL_CAPACITY 64
+
+// max number of slots visited by single eviction pass
+#define CONCURRENT_CACHE_SWEEP_LIMIT 1024
+
+// hits are counted per thread, and flushed to shared counter in batches
+#define CONCURRENT_CACHE_HITS_BATCH 64
+
+namespace nd4j {
+
+    /**
+     * This class provides hash map for read-mostly caches, i.e. shapes and TADs.
+     *
+     * Keys are distributed over shards by their hash, each shard is open-addressed table of entry pointers.
+     * Lookups never take locks: they just probe current table of the shard. Insertions are serialized per shard.
+     * Entries are never moved, so references returned stay valid until entry is evicted.
+     *
+     * If T::limit() returns positive number of bytes, each shard evicts entries above its share of that limit,
+     * using CLOCK policy. Entries pinned via T::isPinned() are never evicted. Evicted entries and replaced tables
+     * are released via EpochManager: only after every reader that could see them has left its EpochGuard,
+     * and evicted entries only if they were not pinned meanwhile. So values returned by get() stay valid
+     * while caller holds EpochGuard, callers keeping them longer have to pin them.
+     *
+     * K must provide hash() method and equal to operator.
+     * T must provide static limit(), sizeOf(V&), isPinned(V&) and destroy(V&) methods.
+     */
+    template <typename K, typename V, typename T>
+    class ConcurrentCache {
+    private:
+        struct Entry {
+            Nd4jLong hash;
+            K key;
+            V value;
+            Nd4jLong bytes;
+            Nd4jLong retiredEpoch = 0;
+
+            // CLOCK reference bit, set on lookups
+            std::atomic<bool> referenced;
+
+            Entry(Nd4jLong h, const K &k, const V &v) : hash(h), key(k), value(v) {
+                bytes = T::sizeOf(value) + sizeof(Entry);
+                referenced.store(true, std::memory_order_relaxed);
+            }
+        };
+
+        struct Table {
+            Nd4jLong capacity;
+            Nd4jLong retiredEpoch = 0;
+            std::atomic<Entry*> *slots;
+
+            explicit Table(Nd4jLong c) : capacity(c) {
+                slots = new std::atomic<Entry*>[c];
+                for (Nd4jLong e = 0; e < c; e++)
+                    slots[e].store(nullptr, std::memory_order_relaxed);
+            }
+
+            ~Table() {
+                delete[] slots;
+            }
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::atomic<Table*> table;
+            std::atomic<Nd4jLong> size;
+
+            // everything below is guarded by mutex
+            Nd4jLong tombstones = 0;
+            Nd4jLong hand = 0;
+            Nd4jLong liveBytes = 0;
+            Nd4jLong retiredBytes = 0;
+
+            // evicted entries and replaced tables, waiting for readers to leave
+            std::vector<Entry*> retired;
+            std::vector<Table*> retiredTables;
+
+            // keeps shards on separate cache lines
+            int8_t padding[64];
+        };
+
+        Shard _shards[CONCURRENT_CACHE_SHARDS];
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+        std::atomic<Nd4jLong> _evictions;
+
+        // marks slot of evicted entry, so probe chains stay intact
+        static FORCEINLINE Entry* tombstone() {
+            return reinterpret_cast<Entry*>(static_cast<uintptr_t>(1));
+        }
+
+        static FORCEINLINE Nd4jLong slotOf(Nd4jLong hash, Nd4jLong capacity) {
+            return (static_cast<uint64_t>(hash) >> CONCURRENT_CACHE_SHARDS_BITS) & (capacity - 1);
+        }
+
+        FORCEINLINE Shard& shardOf(Nd4jLong hash) {
+            return _shards[static_cast<uint64_t>(hash) & (CONCURRENT_CACHE_SHARDS - 1)];
+        }
+
+        static Entry* probe(Table *table, const K &key, Nd4jLong hash) {
+            for (auto e = slotOf(hash, table->capacity); ; e = (e + 1) & (table->capacity - 1)) {
+                auto entry = table->slots[e].load(std::memory_order_acquire);
+                if (entry == nullptr)
+                    return nullptr;
+
+                if (entry != tombstone() && entry->hash == hash && entry->key == key)
+                    return entry;
+            }
+        }
+
+        // returns TRUE if tombstone was reused
+        static bool place(Table *table, Entry *entry) {
+            auto e = slotOf(entry->hash, table->capacity);
+            while (true) {
+                auto existing = table->slots[e].load(std::memory_order_relaxed);
+                if (existing == nullptr || existing == tombstone()) {
+                    table->slots[e].store(entry, std::memory_order_release);
+                    return existing != nullptr;
+                }
+
+                e = (e + 1) & (table->capacity - 1);
+            }
+        }
+
+        FORCEINLINE void countHit() {
+            static thread_local Nd4jLong pending = 0;
+            if (++pending == CONCURRENT_CACHE_HITS_BATCH) {
+                _hits.fetch_add(CONCURRENT_CACHE_HITS_BATCH, std::memory_order_relaxed);
+                pending = 0;
+            }
+        }
+
+        // releases evicted entries and tables no reader can see anymore, unless entries are still pinned
+        void reclaim(Shard &shard) {
+            auto safe = EpochManager::getInstance()->safeEpoch();
+
+            for (size_t e = 0; e < shard.retired.size(); ) {
+                auto entry = shard.retired[e];
+                if (entry->retiredEpoch < safe && !T::isPinned(entry->value)) {
+                    shard.retiredBytes -= entry->bytes;
+                    T::destroy(entry->value);
+                    delete entry;
+
+                    shard.retired[e] = shard.retired.back();
+                    shard.retired.pop_back();
+                } else
+                    e++;
+            }
+
+            for (size_t e = 0; e < shard.retiredTables.size(); ) {
+                if (shard.retiredTables[e]->retiredEpoch < safe) {
+                    delete shard.retiredTables[e];
+                    shard.retiredTables[e] = shard.retiredTables.back();
+                    shard.retiredTables.pop_back();
+                } else
+                    e++;
+            }
+        }
+
+        // CLOCK sweep: recently used entries get second chance, pinned entries are skipped
+        void evict(Shard &shard, Nd4jLong budget) {
+            auto table = shard.table.load(std::memory_order_relaxed);
+            auto target = budget - budget / 4;
+            auto first = shard.retired.size();
+
+            for (Nd4jLong visited = 0; shard.liveBytes > target && visited < 2 * table->capacity && visited < CONCURRENT_CACHE_SWEEP_LIMIT; visited++) {
+                auto e = shard.hand++ & (table->capacity - 1);
+                auto entry = table->slots[e].load(std::memory_order_relaxed);
+                if (entry == nullptr || entry == tombstone())
+                    continue;
+
+                if (entry->referenced.load(std::memory_order_relaxed)) {
+                    entry->referenced.store(false, std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (T::isPinned(entry->value))
+                    continue;
+
+                table->slots[e].store(tombstone(), std::memory_order_release);
+                shard.size.fetch_sub(1, std::memory_order_relaxed);
+                shard.tombstones++;
+
+                shard.liveBytes -= entry->bytes;
+                shard.retiredBytes += entry->bytes;
+                shard.retired.emplace_back(entry);
+
+                _evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // all entries evicted by this pass are unlinked already, so they share the same epoch
+            if (shard.retired.size() > first) {
+                auto epoch = EpochManager::getInstance()->retire();
+                for (auto e = first; e < shard.retired.size(); e++)
+                    shard.retired[e]->retiredEpoch = epoch;
+            }
+        }
+
+    public:
+        ConcurrentCache() {
+            // manager is created upfront, so lock-free lookups never race for it
+            EpochManager::getInstance();
+
+            for (int e = 0; e < CONCURRENT_CACHE_SHARDS; e++) {
+                _shards[e].table.store(new Table(CONCURRENT_CACHE_INITIAL_CAPACITY));
+                _shards[e].size.store(0L);
+            }
+
+            _hits.store(0L);
+            _misses.store(0L);
+            _evictions.store(0L);
+        }
+
+        ~ConcurrentCache() {
+            for (int e = 0; e < CONCURRENT_CACHE_SHARDS; e++) {
+                auto table = _shards[e].table.load();
+                for (Nd4jLong i = 0; i < table->capacity; i++) {
+                    auto entry = table->slots[i].load();
+                    if (entry != nullptr && entry != tombstone()) {
+                        T::destroy(entry->value);
+                        delete entry;
+                    }
+                }
+
+                delete table;
+
+                for (auto entry : _shards[e].retired) {
+                    T::destroy(entry->value);
+                    delete entry;
+                }
+
+                for (auto t : _shards[e].retiredTables)
+                    delete t;
+            }
+        }
+
+        /**
+         * This method returns pointer to cached value, or nullptr if there's no such key
+         */
+        V* find(const K &key, Nd4jLong hash) {
+            EpochGuard guard;
+            auto entry = probe(shardOf(hash).table.load(std::memory_order_acquire), key, hash);
+            return entry == nullptr ? nullptr : &entry->value;
+        }
+
+        /**
+         * This method returns cached value, creating it with factory() if there's no such key yet.
+         * Factory is called at most once per key, unless key was evicted since then.
+         *
+         * PLEASE NOTE: if cache has limit, returned value is valid only while caller holds EpochGuard, or keeps value pinned
+         */
+        template <typename F>
+        V& get(const K &key, Nd4jLong hash, F factory) {
+            auto &shard = shardOf(hash);
+            EpochGuard guard;
+
+            auto entry = probe(shard.table.load(std::memory_order_acquire), key, hash);
+            if (entry != nullptr) {
+                if (!entry->referenced.load(std::memory_order_relaxed))
+                    entry->referenced.store(true, std::memory_order_relaxed);
+
+                countHit();
+                return entry->value;
+            }
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            // someone could insert it while we were waiting
+            auto table = shard.table.load(std::memory_order_relaxed);
+            entry = probe(table, key, hash);
+            if (entry != nullptr) {
+                countHit();
+                return entry->value;
+            }
+
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            entry = new Entry(hash, key, factory());
+
+            if (!shard.retired.empty() || !shard.retiredTables.empty())
+                reclaim(shard);
+
+            auto limit = T::limit();
+            if (limit > 0) {
+                auto budget = limit / CONCURRENT_CACHE_SHARDS;
+                if (shard.liveBytes + entry->bytes > budget)
+                    evict(shard, budget);
+            }
+
+            // keeping load factor below 0.5, so probes stay short. tombstones are dropped on rebuild
+            auto size = shard.size.load(std::memory_order_relaxed);
+            if ((size + shard.tombstones + 1) * 2 > table->capacity) {
+                auto capacity = table->capacity;
+                while ((size + 1) * 4 > capacity)
+                    capacity *= 2;
+
+                auto rebuilt = new Table(capacity);
+                for (Nd4jLong e = 0; e < table->capacity; e++) {
+                    auto existing = table->slots[e].load(std::memory_order_relaxed);
+                    if (existing != nullptr && existing != tombstone())
+                        place(rebuilt, existing);
+                }
+
+                place(rebuilt, entry);
+                shard.table.store(rebuilt, std::memory_order_release);
+                shard.tombstones = 0;
+
+                table->retiredEpoch = EpochManager::getInstance()->retire();
+                shard.retiredTables.emplace_back(table);
+            } else if (place(table, entry)) {
+                shard.tombstones--;
+            }
+
+            shard.size.fetch_add(1, std::memory_order_relaxed);
+            shard.liveBytes += entry->bytes;
+
+            return entry->value;
+        }
+
+        /**
+         * This method returns number of cached entries
+         */
+        Nd4jLong size() {
+            Nd4jLong result = 0;
+            for (int e = 0; e < CONCURRENT_CACHE_SHARDS; e++)
+                result += _shards[e].size.load(std::memory_order_relaxed);
+
+            return result;
+        }
+
+        /**
+         * This method returns memory used by cached entries, and by evicted entries not released yet
+         */
+        Nd4jLong bytes() {
+            Nd4jLong result = 0;
+            for (int e = 0; e < CONCURRENT_CACHE_SHARDS; e++) {
+                std::lock_guard<std::mutex> lock(_shards[e].mutex);
+                result += _shards[e].liveBytes + _shards[e].retiredBytes;
+            }
+
+            return result;
+        }
+
+        // hits are flushed in batches, so this counter lags behind a bit
+        Nd4jLong hits() {
+            return _hits.load();
+        }
+
+        Nd4jLong misses() {
+            return _misses.load();
+        }
+
+        Nd4jLong evictions() {
+            return _evictions.load();
+        }
+    };
+}
+
+#endif //LIBND4J_CONCURRENTCACHE_H
@@ -23,24 +23,65 @@
 
 #include <dll.h>
 #include <pointercast.h>
-#include <map>
-#include <mutex>
 #include <vector>
 #include <ShapeDescriptor.h>
 #include <array/ConstantDataBuffer.h>
 #include <memory/Workspace.h>
+#include <helpers/ConcurrentCache.h>
+#include <Environment.h>
+#include <atomic>
 
 namespace nd4j {
 
+    /**
+     * Every cached shapeInfo is preceded by this header. NDArrays pin shapeInfo they use, so it can't be evicted while array is alive
+     */
+    struct ShapeInfoHeader {
+        std::atomic<Nd4jLong> pins;
+        Nd4jLong length;
+    };
+
+    struct ShapeCacheTraits {
+        static FORCEINLINE ShapeInfoHeader* headerOf(const void *shapeInfo) {
+            return reinterpret_cast<ShapeInfoHeader*>(const_cast<void*>(shapeInfo)) - 1;
+        }
+
+        // device buffers can't be released individually, so CUDA caches are never evicted
+        static FORCEINLINE Nd4jLong limit() {
+#ifdef __CUDABLAS__
+            return 0L;
+#else
+            return Environment::getInstance()->shapeCacheLimit();
+#endif
+        }
+
+        static FORCEINLINE Nd4jLong sizeOf(ConstantDataBuffer &buffer) {
+            return sizeof(ShapeInfoHeader) + headerOf(buffer.primary())->length * sizeof(Nd4jLong);
+        }
+
+        static FORCEINLINE bool isPinned(ConstantDataBuffer &buffer) {
+            return headerOf(buffer.primary())->pins.load(std::memory_order_acquire) > 0;
+        }
+
+        static FORCEINLINE void destroy(ConstantDataBuffer &buffer) {
+            auto header = headerOf(buffer.primary());
+            header->~ShapeInfoHeader();
+            delete[] reinterpret_cast<int8_t*>(header);
+        }
+    };
+
     class ND4J_EXPORT ConstantShapeHelper {
     private:
         static ConstantShapeHelper *_INSTANCE;
 
-        std::mutex _mutex;
-        std::vector<std::map<ShapeDescriptor, ConstantDataBuffer>> _cache;
+        // one cache per device
+        std::vector<ConcurrentCache<ShapeDescriptor, ConstantDataBuffer, ShapeCacheTraits>*> _cache;
 
 
         ConstantShapeHelper();
+
+        // returns shapeInfo preceded by ShapeInfoHeader
+        static Nd4jLong* allocateShapeInfo(const ShapeDescriptor &descriptor);
     public:
         ~ConstantShapeHelper() = default;
 
@@ -64,6 +105,26 @@ namespace nd4j {
         Nd4jLong* createFromExisting(Nd4jLong *shapeInfo, bool destroyOriginal = true);
 
         bool checkBufferExistenceForShapeInfo(ShapeDescriptor &descriptor);
+
+        /**
+         * These methods pin and unpin cached shapeInfo: pinned shapeInfo is never evicted from cache
+         */
+        static FORCEINLINE void retain(const Nd4jLong *shapeInfo) {
+            if (shapeInfo != nullptr)
+                ShapeCacheTraits::headerOf(shapeInfo)->pins.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static FORCEINLINE void release(const Nd4jLong *shapeInfo) {
+            if (shapeInfo != nullptr)
+                ShapeCacheTraits::headerOf(shapeInfo)->pins.fetch_sub(1, std::memory_order_release);
+        }
+
+        // cache statistics, for current device
+        Nd4jLong cachedEntries();
+        Nd4jLong cachedBytes();
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+        Nd4jLong cacheEvictions();
     };
 }
 
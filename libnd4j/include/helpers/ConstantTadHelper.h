@@ -24,20 +24,56 @@
 
 #include <dll.h>
 #include <pointercast.h>
-#include <map>
 #include <vector>
-#include <mutex>
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/TadPack.h>
+#include <helpers/ConcurrentCache.h>
+#include <Environment.h>
 
 namespace nd4j {
+    /**
+     * Cached TadPack is the only instance sharing its buffers, unless someone holds a copy of it.
+     * Every copy pins the pack, so it's never released while copy is alive
+     */
+    struct TadCacheTraits {
+        // device buffers can't be released individually, so CUDA caches are never evicted
+        static FORCEINLINE Nd4jLong limit() {
+#ifdef __CUDABLAS__
+            return 0L;
+#else
+            return Environment::getInstance()->tadCacheLimit();
+#endif
+        }
+
+        static FORCEINLINE Nd4jLong sizeOf(TadPack &pack) {
+            return (pack.shapeInfoLength() + pack.numberOfTads()) * sizeof(Nd4jLong);
+        }
+
+        static FORCEINLINE bool isPinned(TadPack &pack) {
+            return pack.pins() > 1;
+        }
+
+        static FORCEINLINE void destroy(TadPack &pack) {
+            auto shapeInfo = pack.primaryShapeInfo();
+            auto offsets = pack.primaryOffsets();
+            auto pins = pack.pinsCounter();
+
+            // cached instance has to drop its own pin before counter is released
+            pack = TadPack();
+
+            delete[] shapeInfo;
+            delete[] offsets;
+            delete pins;
+        }
+    };
+
     class ND4J_EXPORT ConstantTadHelper {
     private:
         static ConstantTadHelper *_INSTANCE;
 
-        std::mutex _mutex;
-        std::vector<std::map<TadDescriptor, TadPack>> _cache;
+        // one cache per device
+        std::vector<ConcurrentCache<TadDescriptor, TadPack, TadCacheTraits>*> _cache;
 
         ConstantTadHelper();
     public:
@@ -45,11 +81,18 @@ namespace nd4j {
 
         static ConstantTadHelper* getInstance();
 
-        TadPack& tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
-        TadPack& tadForDimensions(const Nd4jLong *originalShape, int* dimensions, int dimLength, const bool keepUnitiesInShape = false);
-        TadPack& tadForDimensions(const Nd4jLong *originalShape, int dimensions, const bool keepUnitiesInShape = false);
-        TadPack& tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
-        TadPack& tadForDimensions(TadDescriptor &descriptor);
+        TadPack tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
+        TadPack tadForDimensions(const Nd4jLong *originalShape, int* dimensions, int dimLength, const bool keepUnitiesInShape = false);
+        TadPack tadForDimensions(const Nd4jLong *originalShape, int dimensions, const bool keepUnitiesInShape = false);
+        TadPack tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
+        TadPack tadForDimensions(TadDescriptor &descriptor);
+
+        // cache statistics, for current device
+        Nd4jLong cachedEntries();
+        Nd4jLong cachedBytes();
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+        Nd4jLong cacheEvictions();
     };
 }
 
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CPUFEATURES_H
+#define LIBND4J_CPUFEATURES_H
+
+#include <dll.h>
+
+namespace nd4j {
+    /**
+     * This class provides instruction set extensions of current CPU, detected once via cpuid.
+     * Extensions using wider registers are reported only if OS saves their state.
+     *
+     * On non-x86 platforms all methods return FALSE.
+     */
+    class ND4J_EXPORT CpuFeatures {
+    private:
+        static CpuFeatures *_INSTANCE;
+
+        bool _f16c = false;
+        bool _avx2 = false;
+        bool _avx512f = false;
+        bool _avx512bw = false;
+        bool _avx512vnni = false;
+        bool _avx512bf16 = false;
+
+        CpuFeatures();
+    public:
+        ~CpuFeatures() = default;
+
+        static CpuFeatures* getInstance();
+
+        bool hasF16C();
+        bool hasAVX2();
+        bool hasAVX512F();
+        bool hasAVX512BW();
+
+        /**
+         * This method returns TRUE if CPU supports int8 dot products, i.e. vpdpbusd
+         */
+        bool hasAVX512VNNI();
+
+        /**
+         * This method returns TRUE if CPU supports bfloat16 dot products, i.e. vdpbf16ps
+         */
+        bool hasAVX512BF16();
+    };
+}
+
+#endif //LIBND4J_CPUFEATURES_H
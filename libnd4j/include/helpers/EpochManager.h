@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_EPOCHMANAGER_H
+#define LIBND4J_EPOCHMANAGER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+
+namespace nd4j {
+    struct EpochRecord;
+
+    /**
+     * This class provides epoch-based reclamation for lock-free readers of ConcurrentCache.
+     *
+     * Readers announce current epoch while they're within EpochGuard. Writers tag memory they've unlinked with
+     * retire(), and release it only once safeEpoch() is above that tag: i.e. once every thread that could
+     * observe that memory has left its guard.
+     */
+    class ND4J_EXPORT EpochManager {
+    private:
+        static EpochManager* _INSTANCE;
+
+        // starts at 1, since 0 means "outside of guard"
+        std::atomic<Nd4jLong> _epoch{1L};
+
+        // records are reused by new threads, and never released
+        std::atomic<EpochRecord*> _records{nullptr};
+
+        EpochManager() = default;
+        ~EpochManager() = default;
+
+        EpochRecord* acquireRecord();
+    public:
+        static EpochManager* getInstance();
+
+        /**
+         * These methods are called by EpochGuard. Guards can be nested
+         */
+        void enter();
+        void leave();
+
+        /**
+         * This method advances global epoch, and returns tag for memory unlinked before the call
+         */
+        Nd4jLong retire();
+
+        /**
+         * This method returns smallest epoch announced by threads within guard. Memory tagged below it is safe to release
+         */
+        Nd4jLong safeEpoch();
+    };
+
+    /**
+     * Memory obtained from ConcurrentCache stays valid while calling thread holds this guard
+     */
+    class ND4J_EXPORT EpochGuard {
+    public:
+        EpochGuard() {
+            EpochManager::getInstance()->enter();
+        }
+
+        ~EpochGuard() {
+            EpochManager::getInstance()->leave();
+        }
+    };
+}
+
+#endif //LIBND4J_EPOCHMANAGER_H
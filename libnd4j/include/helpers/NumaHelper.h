@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_NUMAHELPER_H
+#define LIBND4J_NUMAHELPER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * This class provides NUMA topology, thread pinning and node-local allocations.
+     *
+     * Topology is read from sysfs once. On single-node machines, or platforms without NUMA support,
+     * all methods degrade to no-ops: allocations are plain, and threads aren't pinned.
+     */
+    class ND4J_EXPORT NumaHelper {
+    private:
+        static NumaHelper *_INSTANCE;
+
+        // cpus of each node
+        std::vector<std::vector<int>> _cpus;
+
+        // node of each cpu
+        std::vector<int> _nodes;
+
+        NumaHelper();
+
+        static std::vector<int> parseList(const std::string &list);
+    public:
+        ~NumaHelper() = default;
+
+        static NumaHelper* getInstance();
+
+        /**
+         * This method returns number of NUMA nodes, 1 if topology isn't available
+         */
+        int numberOfNodes();
+
+        /**
+         * This method returns TRUE if there's more than 1 node, so NUMA placement makes sense
+         */
+        bool isAvailable();
+
+        std::vector<int> cpusOfNode(int node);
+
+        /**
+         * This method returns node current thread is bound to, or node of cpu it's running on
+         */
+        int currentNode();
+
+        /**
+         * This method returns node current thread is bound to via bindThread(), or -1
+         */
+        int boundNode();
+
+        /**
+         * This method returns node new graph sessions should be bound to: current node if Environment is NUMA-aware, -1 otherwise
+         */
+        int sessionNode();
+
+        /**
+         * This method pins current thread to cpus of given node. Previous affinity is restored by unbindThread()
+         * @return FALSE if thread wasn't pinned
+         */
+        bool bindThread(int node);
+        void unbindThread();
+
+        /**
+         * This method allocates page-aligned memory with preference to given node. Memory is released with free()
+         */
+        void* allocate(Nd4jLong numBytes, int node);
+
+        /**
+         * This method sets preference to given node for page-aligned memory region, which wasn't touched yet
+         */
+        void place(void *ptr, Nd4jLong numBytes, int node);
+
+        /**
+         * This method zero-fills memory from current thread pinned to given node, so pages are first touched there
+         */
+        void touch(void *ptr, Nd4jLong numBytes, int node);
+    };
+
+    /**
+     * Scoped binding of current thread to NUMA node. Negative node means no binding.
+     */
+    class ND4J_EXPORT NumaBinding {
+    private:
+        bool _bound = false;
+    public:
+        explicit NumaBinding(int node);
+        ~NumaBinding();
+    };
+}
+
+#endif //LIBND4J_NUMAHELPER_H
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_QUANTIZATIONCALIBRATOR_H
+#define LIBND4J_QUANTIZATIONCALIBRATOR_H
+
+#include <NDArray.h>
+
+namespace nd4j {
+
+    /**
+     * This class collects range of values seen in some array over calibration runs, i.e. output of some layer,
+     * and turns it into affine quantization parameters: real = scale * (quantized - zeroPoint).
+     *
+     * Typical use is requantization of quantized ops output: observe() layer output for a few representative batches
+     * in float mode, then pass scale() and zeroPoint() to op as output quantization parameters.
+     */
+    class ND4J_EXPORT QuantizationCalibrator {
+    private:
+        double _min = 0.;
+        double _max = 0.;
+        Nd4jLong _observations = 0;
+
+    public:
+        QuantizationCalibrator() = default;
+        ~QuantizationCalibrator() = default;
+
+        /**
+         * This method extends range with min/max values of given array
+         */
+        void observe(const NDArray &array);
+
+        void reset();
+
+        Nd4jLong observations() const;
+        double min() const;
+        double max() const;
+
+        // parameters for observed range, int8 by default
+        double scale(const int qMin = -128, const int qMax = 127) const;
+        int zeroPoint(const int qMin = -128, const int qMax = 127) const;
+
+        /**
+         * This method returns affine parameters mapping [min, max] to [qMin, qMax].
+         * Range is extended to include 0, so zero (i.e. padding) is always represented exactly
+         */
+        static void paramsOf(double min, double max, const int qMin, const int qMax, double &scale, int &zeroPoint);
+
+        /**
+         * This method returns parameters of symmetric quantization: zero point is 0, and [-absMax, absMax] maps to [-qMax, qMax]
+         */
+        static void symmetricParamsOf(const double absMax, const int qMax, double &scale, int &zeroPoint);
+    };
+}
+
+#endif //LIBND4J_QUANTIZATIONCALIBRATOR_H
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_QUANTIZEDGEMM_H
+#define LIBND4J_QUANTIZEDGEMM_H
+
+#include <helpers/BlockedGemm.h>
+
+// int8 panels are 4 times smaller than fp32 ones, so K block is longer
+#define QGEMM_KC 1024
+
+namespace nd4j {
+
+    /**
+     * Kernel for CPUs with AVX512-VNNI: panels keep 4 consecutive k values in single 32-bit element,
+     * and vpdpbusd accumulates all 4 uint8 x int8 products of each element into int32
+     */
+    class ND4J_EXPORT VNNIGemmKernel {
+    private:
+        static FORCEINLINE uint32_t quadOf(const uint8_t *values, const Nd4jLong stride, const int length) {
+            uint32_t quad = 0;
+            for (int e = 0; e < length; e++)
+                quad |= static_cast<uint32_t>(values[e * stride]) << (8 * e);
+
+            return quad;
+        }
+
+    public:
+        typedef int32_t Acc;
+        typedef uint32_t PackedA;
+        typedef uint32_t PackedB;
+
+        static const int MR = 8;
+        static const int NR = 32;
+        static const int KP = 4;
+        static const int KC = QGEMM_KC;
+
+        /**
+         * This method returns TRUE if kernel was compiled in, and current CPU supports it
+         */
+        static bool isAvailable();
+
+        static void compute(const int kp, const PackedA *a, const PackedB *b, int32_t *acc);
+
+        static void packA(const uint8_t *A, const Nd4jLong rowStride, const Nd4jLong colStride, const int mr, const int kc, PackedA *panel) {
+            const int kp = (kc + KP - 1) / KP;
+
+            for (int p = 0; p < kp; p++) {
+                const int k = KP * p;
+                const int length = nd4j::math::nd4j_min<int>(KP, kc - k);
+
+                for (int i = 0; i < mr; i++)
+                    panel[p * MR + i] = quadOf(A + i * rowStride + k * colStride, colStride, length);
+
+                for (int i = mr; i < MR; i++)
+                    panel[p * MR + i] = 0;
+            }
+        }
+
+        static void packB(const int8_t *B, const Nd4jLong rowStride, const Nd4jLong colStride, const int nr, const int kc, PackedB *panel) {
+            const int kp = (kc + KP - 1) / KP;
+            auto bytes = reinterpret_cast<const uint8_t*>(B);
+
+            for (int p = 0; p < kp; p++) {
+                const int k = KP * p;
+                const int length = nd4j::math::nd4j_min<int>(KP, kc - k);
+
+                for (int j = 0; j < nr; j++)
+                    panel[p * NR + j] = quadOf(bytes + k * rowStride + j * colStride, rowStride, length);
+
+                for (int j = nr; j < NR; j++)
+                    panel[p * NR + j] = 0;
+            }
+        }
+    };
+
+    /**
+     * Kernel for all other CPUs: panels keep pairs of consecutive k values widened to int16, so AVX2 vpmaddwd
+     * (or plain loop without AVX2) sums both products of each pair into int32. Unlike vpmaddubsw, nothing saturates here
+     */
+    class ND4J_EXPORT PairGemmKernel {
+    private:
+        static FORCEINLINE uint32_t pairOf(const int16_t lo, const int16_t hi) {
+            return static_cast<uint32_t>(static_cast<uint16_t>(lo)) | (static_cast<uint32_t>(static_cast<uint16_t>(hi)) << 16);
+        }
+
+    public:
+        typedef int32_t Acc;
+        typedef uint32_t PackedA;
+        typedef uint32_t PackedB;
+
+        static const int MR = 4;
+        static const int NR = 16;
+        static const int KP = 2;
+        static const int KC = QGEMM_KC;
+
+        static void compute(const int kp, const PackedA *a, const PackedB *b, int32_t *acc);
+
+        static void packA(const uint8_t *A, const Nd4jLong rowStride, const Nd4jLong colStride, const int mr, const int kc, PackedA *panel) {
+            const int kp = (kc + 1) / 2;
+
+            for (int p = 0; p < kp; p++) {
+                const int k = 2 * p;
+                for (int i = 0; i < mr; i++)
+                    panel[p * MR + i] = pairOf(A[i * rowStride + k * colStride], k + 1 < kc ? A[i * rowStride + (k + 1) * colStride] : 0);
+
+                for (int i = mr; i < MR; i++)
+                    panel[p * MR + i] = 0;
+            }
+        }
+
+        static void packB(const int8_t *B, const Nd4jLong rowStride, const Nd4jLong colStride, const int nr, const int kc, PackedB *panel) {
+            const int kp = (kc + 1) / 2;
+
+            for (int p = 0; p < kp; p++) {
+                const int k = 2 * p;
+                for (int j = 0; j < nr; j++)
+                    panel[p * NR + j] = pairOf(B[k * rowStride + j * colStride], k + 1 < kc ? B[(k + 1) * rowStride + j * colStride] : 0);
+
+                for (int j = nr; j < NR; j++)
+                    panel[p * NR + j] = 0;
+            }
+        }
+    };
+
+    /**
+     * This class provides int8 GEMM: C = A x B, with uint8 A, int8 B and int32 C.
+     *
+     * Products are summed exactly, so zero points and scales are left to caller: it's expected to be applied in
+     * epilogue, i.e. by ops::helpers::quantizedMatmul. Kernels are driven by BlockedGemm::run, so blocking, packing
+     * and parallelism are shared with BlockedGemm. CPUs with AVX512-VNNI use vpdpbusd kernel, others use int16 pairs kernel.
+     */
+    class ND4J_EXPORT QuantizedGemm {
+    public:
+        /**
+         * C[m,n] = sum(A[m,k] * B[k,n])
+         *
+         * @param parallel - if FALSE, gemm runs in calling thread only
+         */
+        static void gemm(const int M, const int N, const int K,
+                         const uint8_t *A, const Nd4jLong aRowStride, const Nd4jLong aColStride,
+                         const int8_t *B, const Nd4jLong bRowStride, const Nd4jLong bColStride,
+                         int32_t *C, const Nd4jLong cRowStride, const Nd4jLong cColStride,
+                         bool parallel = true);
+    };
+}
+
+#endif //LIBND4J_QUANTIZEDGEMM_H
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/BlockedGemm.h>
+#include <helpers/CpuFeatures.h>
+#include <stdexcept>
+
+// kernel is compiled for AVX512-BF16 regardless of target arch, and is used only if CPU supports it
+#if defined(__x86_64__) && ((defined(__clang__) && __clang_major__ >= 9) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 10))
+#define ND4J_BF16_DOT_KERNEL
+#endif
+
+// the same goes for vector conversions of half types
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define ND4J_HALF_CONVERTERS
+#endif
+
+#if defined(ND4J_BF16_DOT_KERNEL) || defined(ND4J_HALF_CONVERTERS)
+#include <immintrin.h>
+#endif
+
+namespace nd4j {
+
+#ifdef ND4J_HALF_CONVERTERS
+    __attribute__((target("avx512f")))
+    static int halfToFloatAVX512(const float16 *src, const int length, float *dst) {
+        int e = 0;
+        for (; e + 16 <= length; e += 16)
+            _mm512_storeu_ps(dst + e, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + e))));
+
+        return e;
+    }
+
+    __attribute__((target("avx,f16c")))
+    static int halfToFloatF16C(const float16 *src, const int length, float *dst) {
+        int e = 0;
+        for (; e + 8 <= length; e += 8)
+            _mm256_storeu_ps(dst + e, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + e))));
+
+        return e;
+    }
+
+    // bfloat16 is just upper half of float
+    __attribute__((target("avx512f")))
+    static int bfloatToFloatAVX512(const bfloat16 *src, const int length, float *dst) {
+        int e = 0;
+        for (; e + 16 <= length; e += 16)
+            _mm512_storeu_si512(dst + e, _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + e))), 16));
+
+        return e;
+    }
+
+    __attribute__((target("avx2")))
+    static int bfloatToFloatAVX2(const bfloat16 *src, const int length, float *dst) {
+        int e = 0;
+        for (; e + 8 <= length; e += 8)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + e), _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + e))), 16));
+
+        return e;
+    }
+#endif
+
+    void GemmConverter<float16, float>::convert(const float16 *src, const int length, float *dst) {
+        int e = 0;
+#ifdef ND4J_HALF_CONVERTERS
+        static const bool avx512 = CpuFeatures::getInstance()->hasAVX512F();
+        static const bool f16c = CpuFeatures::getInstance()->hasF16C();
+
+        if (avx512)
+            e = halfToFloatAVX512(src, length, dst);
+
+        if (f16c)
+            e += halfToFloatF16C(src + e, length - e, dst + e);
+#endif
+        for (; e < length; e++)
+            dst[e] = static_cast<float>(src[e]);
+    }
+
+    void GemmConverter<bfloat16, float>::convert(const bfloat16 *src, const int length, float *dst) {
+        int e = 0;
+#ifdef ND4J_HALF_CONVERTERS
+        static const bool avx512 = CpuFeatures::getInstance()->hasAVX512F();
+        static const bool avx2 = CpuFeatures::getInstance()->hasAVX2();
+
+        if (avx512)
+            e = bfloatToFloatAVX512(src, length, dst);
+        else if (avx2)
+            e = bfloatToFloatAVX2(src, length, dst);
+#endif
+        for (; e < length; e++)
+            dst[e] = static_cast<float>(src[e]);
+    }
+
+#ifdef ND4J_BF16_DOT_KERNEL
+    __attribute__((target("avx512f,avx512bf16")))
+    static void dotKernel(const int kp, const uint32_t *a, const uint32_t *b, float *acc) {
+        __m512 c[BF16DotGemmKernel::MR][2];
+
+        for (int i = 0; i < BF16DotGemmKernel::MR; i++) {
+            c[i][0] = _mm512_setzero_ps();
+            c[i][1] = _mm512_setzero_ps();
+        }
+
+        for (int p = 0; p < kp; p++) {
+            auto ap = a + p * BF16DotGemmKernel::MR;
+            auto b0 = (__m512bh) _mm512_loadu_si512(b + p * BF16DotGemmKernel::NR);
+            auto b1 = (__m512bh) _mm512_loadu_si512(b + p * BF16DotGemmKernel::NR + 16);
+
+            for (int i = 0; i < BF16DotGemmKernel::MR; i++) {
+                auto ai = (__m512bh) _mm512_set1_epi32(static_cast<int>(ap[i]));
+                c[i][0] = _mm512_dpbf16_ps(c[i][0], ai, b0);
+                c[i][1] = _mm512_dpbf16_ps(c[i][1], ai, b1);
+            }
+        }
+
+        for (int i = 0; i < BF16DotGemmKernel::MR; i++) {
+            _mm512_storeu_ps(acc + i * BF16DotGemmKernel::NR, c[i][0]);
+            _mm512_storeu_ps(acc + i * BF16DotGemmKernel::NR + 16, c[i][1]);
+        }
+    }
+#endif
+
+    bool BF16DotGemmKernel::isAvailable() {
+#ifdef ND4J_BF16_DOT_KERNEL
+        static const bool available = CpuFeatures::getInstance()->hasAVX512BF16();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    void BF16DotGemmKernel::compute(const int kp, const PackedA *a, const PackedB *b, Acc *acc) {
+#ifdef ND4J_BF16_DOT_KERNEL
+        dotKernel(kp, a, b, acc);
+#else
+        throw std::runtime_error("BF16DotGemmKernel: kernel wasn't compiled in, check isAvailable() before use");
+#endif
+    }
+}
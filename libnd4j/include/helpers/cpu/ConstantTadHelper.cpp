@@ -27,8 +27,7 @@
 namespace nd4j {
 
     ConstantTadHelper::ConstantTadHelper() {
-        std::map<TadDescriptor, TadPack> pack;
-        _cache.emplace_back(pack);
+        _cache.emplace_back(new ConcurrentCache<TadDescriptor, TadPack, TadCacheTraits>());
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -38,30 +37,30 @@ namespace nd4j {
         return _INSTANCE;
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int dimension, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int dimension, const bool keepUnitiesInShape) {
         return tadForDimensions(originalShape, &dimension, 1, keepUnitiesInShape);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions, const bool keepUnitiesInShape) {
         return tadForDimensions(originalShape, const_cast<int *>(dimensions.data()), dimensions.size(), keepUnitiesInShape);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int* dimensions, int dimLength, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int* dimensions, int dimLength, const bool keepUnitiesInShape) {
         TadDescriptor tadDescriptor(originalShape, dimensions, dimLength, keepUnitiesInShape);
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape) {
         TadDescriptor tadDescriptor(descriptor, dimensions, keepUnitiesInShape);
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
+    TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         const int deviceId = 0;
 
-        _mutex.lock();
-        if (_cache[deviceId].count(descriptor) == 0) {
-
+        // pinned copy is made before guard is released, so evicted pack can't be released meanwhile
+        EpochGuard guard;
+        return _cache[deviceId]->get(descriptor, descriptor.hash(), [&descriptor] () {
             const auto shapeInfo = descriptor.originalShape().toShapeInfo();
             const int rank = shape::rank(shapeInfo);
             const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
@@ -74,42 +73,33 @@ namespace nd4j {
             if (numOfSubArrs > 0)
                 shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
 
-
             ConstantDataBuffer shapesBuffer(sPtr, nullptr, shape::shapeInfoLength(subArrRank)*sizeof(Nd4jLong), DataType::INT64);
             ConstantDataBuffer offsetsBuffer(oPtr, nullptr, numOfSubArrs*sizeof(Nd4jLong), DataType::INT64);
-            TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
-
-
-
-            // auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            // shape::TAD tad;
-            // tad.init(shapeInfo, descriptor.axis().data(), descriptor.axis().size());
-            // tad.createTadOnlyShapeInfo();
-            // tad.createOffsets();
-
-            // auto sPtr = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
-            // auto oPtr = new Nd4jLong[tad.numTads];
-
-            // memcpy(sPtr, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-            // memcpy(oPtr, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
 
-            // TadPack t(shapesBuffer, offsetsBuffer, tad.numTads);
+            delete[] shapeInfo;
 
+            return TadPack(shapesBuffer, offsetsBuffer, numOfSubArrs, new std::atomic<Nd4jLong>(0L));
+        });
+    }
 
-            _cache[deviceId][descriptor] = t;
+    Nd4jLong ConstantTadHelper::cachedEntries() {
+        return _cache[0]->size();
+    }
 
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+    Nd4jLong ConstantTadHelper::cachedBytes() {
+        return _cache[0]->bytes();
+    }
 
-            delete[] shapeInfo;
+    Nd4jLong ConstantTadHelper::cacheHits() {
+        return _cache[0]->hits();
+    }
 
-            return r;
-        } else {
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+    Nd4jLong ConstantTadHelper::cacheMisses() {
+        return _cache[0]->misses();
+    }
 
-            return r;
-        }
+    Nd4jLong ConstantTadHelper::cacheEvictions() {
+        return _cache[0]->evictions();
     }
 
     nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
@@ -21,6 +21,7 @@
 #include "../MmulHelper.h"
 #include <NDArrayFactory.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/BlockedGemm.h>
 
 
 namespace nd4j {
@@ -33,66 +34,17 @@ static void usualGemm(const char cOrder, const bool transA, const bool transB, c
     T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
     T2* B = reinterpret_cast<T2*>(const_cast<void*>(vB));
     T3* C = reinterpret_cast<T3*>(vC);
-    T3 alphaZ(alpha), betaZ(beta);
-    
+
+    // flags are TRUE for arrays in c order
     const bool flagC = cOrder == 'f';
     const bool flagA = (flagC && transA) || (!flagC && !transA);
     const bool flagB = (flagC && transB) || (!flagC && !transB);
 
-    // PRAGMA_OMP_PARALLEL_FOR_ARGS(if(M*N > Environment::getInstance()->elementwiseThreshold()) schedule(guided))
-    // for(uint row = 0; row < M; ++row) {
-
-    //     T3* c = flagC ? (C + row) : (C + row * ldc);
-
-    //     for(uint col = 0; col < N; ++col)
-    //         c[flagC ? col * ldc : col] = 0;
-
-    //     for(uint i = 0; i < K; ++i) {
-            
-    //         T3* b = flagB ? (B + i * ldb) : (B + i);
-    //         T3* a = flagA ? (A + row * lda + i) : (A + row + i * lda);
-
-    //         if(flagC) {
-    //             PRAGMA_OMP_SIMD
-    //             for(uint col = 0; col < N; ++col) {
-    //                 if(betaZ)
-    //                     c[col * ldc] += a * b[flagB ? col : col * ldb] + betaZ * c[col * ldc];
-    //                 else
-    //                     c[col * ldc] += a * b[flagB ? col : col * ldb];
-    //             }
-    //         }
-    //         else {
-    //             PRAGMA_OMP_SIMD
-    //             for(uint col = 0; col < N; ++col) {
-    //                 if(betaZ)
-    //                     c[col] += a * b[flagB ? col : col * ldb] + betaZ * c[col];
-    //                 else
-    //                     c[col] += a * b[flagB ? col : col * ldb];
-    //             }
-    //         }
-    //     }
-    // }   
-
-    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(M*N > Environment::getInstance()->elementwiseThreshold()) schedule(guided) collapse(2))
-    for(uint row = 0; row < M; ++row) {
-       for(uint col = 0; col < N; ++col) {
-            
-            T3* c = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
-            T3 val = 0;  
-
-            PRAGMA_OMP_SIMD
-            for(uint i = 0; i < K; ++i) {
-                T3 a = flagA ? *(A + row * lda + i) : *(A + row + i * lda);
-                T3 b = flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);             
-                val += alphaZ * a * b;
-            }
-            
-            if(betaZ)
-                *c = val + betaZ * *c;
-            else
-                *c = val;
-       }
-    }
+    BlockedGemm<T1,T2,T3>::gemm(M, N, K, alpha,
+                                A, flagA ? lda : 1, flagA ? 1 : lda,
+                                B, flagB ? ldb : 1, flagB ? 1 : ldb,
+                                beta,
+                                C, flagC ? 1 : ldc, flagC ? ldc : 1);
 }
 
 //////////////////////////////////////////////////////////////////////////////
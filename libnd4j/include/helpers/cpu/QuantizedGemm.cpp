@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/QuantizedGemm.h>
+#include <helpers/CpuFeatures.h>
+
+// kernels are compiled for their instruction sets regardless of target arch, and are used only if CPU supports them
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define ND4J_AVX2_PAIR_KERNEL
+#if (defined(__clang__) && __clang_major__ >= 6) || (!defined(__clang__) && __GNUC__ >= 8)
+#define ND4J_VNNI_KERNEL
+#endif
+#include <immintrin.h>
+#endif
+
+namespace nd4j {
+
+#ifdef ND4J_VNNI_KERNEL
+    __attribute__((target("avx512f,avx512bw,avx512vnni")))
+    static void vnniKernel(const int kp, const uint32_t *a, const uint32_t *b, int32_t *acc) {
+        __m512i c[VNNIGemmKernel::MR][2];
+
+        for (int i = 0; i < VNNIGemmKernel::MR; i++) {
+            c[i][0] = _mm512_setzero_si512();
+            c[i][1] = _mm512_setzero_si512();
+        }
+
+        for (int p = 0; p < kp; p++) {
+            auto ap = a + p * VNNIGemmKernel::MR;
+            auto b0 = _mm512_loadu_si512(b + p * VNNIGemmKernel::NR);
+            auto b1 = _mm512_loadu_si512(b + p * VNNIGemmKernel::NR + 16);
+
+            for (int i = 0; i < VNNIGemmKernel::MR; i++) {
+                auto ai = _mm512_set1_epi32(static_cast<int>(ap[i]));
+                c[i][0] = _mm512_dpbusd_epi32(c[i][0], ai, b0);
+                c[i][1] = _mm512_dpbusd_epi32(c[i][1], ai, b1);
+            }
+        }
+
+        for (int i = 0; i < VNNIGemmKernel::MR; i++) {
+            _mm512_storeu_si512(acc + i * VNNIGemmKernel::NR, c[i][0]);
+            _mm512_storeu_si512(acc + i * VNNIGemmKernel::NR + 16, c[i][1]);
+        }
+    }
+#endif
+
+#ifdef ND4J_AVX2_PAIR_KERNEL
+    __attribute__((target("avx2")))
+    static void avx2PairKernel(const int kp, const uint32_t *a, const uint32_t *b, int32_t *acc) {
+        __m256i c[PairGemmKernel::MR][2];
+
+        for (int i = 0; i < PairGemmKernel::MR; i++) {
+            c[i][0] = _mm256_setzero_si256();
+            c[i][1] = _mm256_setzero_si256();
+        }
+
+        for (int p = 0; p < kp; p++) {
+            auto ap = a + p * PairGemmKernel::MR;
+            auto b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + p * PairGemmKernel::NR));
+            auto b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + p * PairGemmKernel::NR + 8));
+
+            for (int i = 0; i < PairGemmKernel::MR; i++) {
+                auto ai = _mm256_set1_epi32(static_cast<int>(ap[i]));
+                c[i][0] = _mm256_add_epi32(c[i][0], _mm256_madd_epi16(ai, b0));
+                c[i][1] = _mm256_add_epi32(c[i][1], _mm256_madd_epi16(ai, b1));
+            }
+        }
+
+        for (int i = 0; i < PairGemmKernel::MR; i++) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i * PairGemmKernel::NR), c[i][0]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i * PairGemmKernel::NR + 8), c[i][1]);
+        }
+    }
+#endif
+
+    static void pairKernel(const int kp, const uint32_t *a, const uint32_t *b, int32_t *acc) {
+        const int MR = PairGemmKernel::MR;
+        const int NR = PairGemmKernel::NR;
+
+        for (int e = 0; e < MR * NR; e++)
+            acc[e] = 0;
+
+        for (int p = 0; p < kp; p++) {
+            auto ap = a + p * MR;
+            auto bp = b + p * NR;
+
+            for (int i = 0; i < MR; i++) {
+                const int32_t lo = static_cast<int16_t>(ap[i] & 0xffff);
+                const int32_t hi = static_cast<int16_t>(ap[i] >> 16);
+                auto acci = acc + i * NR;
+
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < NR; j++)
+                    acci[j] += lo * static_cast<int16_t>(bp[j] & 0xffff) + hi * static_cast<int16_t>(bp[j] >> 16);
+            }
+        }
+    }
+
+    bool VNNIGemmKernel::isAvailable() {
+#ifdef ND4J_VNNI_KERNEL
+        static const bool available = CpuFeatures::getInstance()->hasAVX512BW() && CpuFeatures::getInstance()->hasAVX512VNNI();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    void VNNIGemmKernel::compute(const int kp, const PackedA *a, const PackedB *b, int32_t *acc) {
+#ifdef ND4J_VNNI_KERNEL
+        vnniKernel(kp, a, b, acc);
+#endif
+    }
+
+    void PairGemmKernel::compute(const int kp, const PackedA *a, const PackedB *b, int32_t *acc) {
+#ifdef ND4J_AVX2_PAIR_KERNEL
+        static const bool avx2 = CpuFeatures::getInstance()->hasAVX2();
+        if (avx2) {
+            avx2PairKernel(kp, a, b, acc);
+            return;
+        }
+#endif
+        pairKernel(kp, a, b, acc);
+    }
+
+    void QuantizedGemm::gemm(const int M, const int N, const int K,
+                             const uint8_t *A, const Nd4jLong aRowStride, const Nd4jLong aColStride,
+                             const int8_t *B, const Nd4jLong bRowStride, const Nd4jLong bColStride,
+                             int32_t *C, const Nd4jLong cRowStride, const Nd4jLong cColStride,
+                             bool parallel) {
+
+        if (M <= 0 || N <= 0)
+            return;
+
+        if (K <= 0) {
+            for (int m = 0; m < M; m++)
+                for (int n = 0; n < N; n++)
+                    C[m * cRowStride + n * cColStride] = 0;
+
+            return;
+        }
+
+        parallel = parallel && (Nd4jLong) M * N * K > GEMM_PARALLEL_THRESHOLD;
+
+        // int32 sums are exact, so with alpha 1 and beta 0 K blocks just accumulate into C
+        typedef BlockedGemm<uint8_t, int8_t, int32_t> Driver;
+
+        if (VNNIGemmKernel::isAvailable())
+            Driver::run<VNNIGemmKernel>(M, N, K, 1.0, A, aRowStride, aColStride, B, bRowStride, bColStride, 0.0, C, cRowStride, cColStride, parallel);
+        else
+            Driver::run<PairGemmKernel>(M, N, K, 1.0, A, aRowStride, aColStride, B, bRowStride, bColStride, 0.0, C, cRowStride, cColStride, parallel);
+    }
+}
@@ -29,11 +29,8 @@ namespace nd4j {
     ConstantShapeHelper::ConstantShapeHelper() {
         auto numDevices = ConstantHelper::getNumberOfDevices();
 
-        _cache.resize(numDevices);
-        for (int e = 0; e < numDevices; e++) {
-            std::map<ShapeDescriptor, ConstantDataBuffer> cache;
-            _cache[e] = cache;
-        }
+        for (int e = 0; e < numDevices; e++)
+            _cache.emplace_back(new ConcurrentCache<ShapeDescriptor, ConstantDataBuffer, ShapeCacheTraits>());
     }
 
     ConstantShapeHelper* ConstantShapeHelper::getInstance() {
@@ -43,6 +40,22 @@ namespace nd4j {
         return _INSTANCE;
     }
 
+    Nd4jLong* ConstantShapeHelper::allocateShapeInfo(const ShapeDescriptor &descriptor) {
+        auto temp = descriptor.toShapeInfo();
+        auto length = shape::shapeInfoLength(temp);
+
+        auto block = new int8_t[sizeof(ShapeInfoHeader) + length * sizeof(Nd4jLong)];
+        auto header = new (block) ShapeInfoHeader();
+        header->pins.store(0L);
+        header->length = length;
+
+        auto shapeInfo = reinterpret_cast<Nd4jLong*>(header + 1);
+        memcpy(shapeInfo, temp, length * sizeof(Nd4jLong));
+        RELEASE(temp, nullptr);
+
+        return shapeInfo;
+    }
+
     ConstantDataBuffer& ConstantShapeHelper::bufferForShapeInfo(nd4j::DataType dataType, char order, const std::vector<Nd4jLong> &shape) {
         ShapeDescriptor descriptor(dataType, order, shape);
         return bufferForShapeInfo(descriptor);
@@ -56,24 +69,11 @@ namespace nd4j {
     ConstantDataBuffer& ConstantShapeHelper::bufferForShapeInfo(const ShapeDescriptor &descriptor) {
         int deviceId = ConstantHelper::getCurrentDevice();
 
-        _mutex.lock();
-
-        if (_cache[deviceId].count(descriptor) == 0) {
-            auto hPtr = descriptor.toShapeInfo();
+        return _cache[deviceId]->get(descriptor, descriptor.hash(), [&descriptor] () {
+            auto hPtr = allocateShapeInfo(descriptor);
             auto dPtr = ConstantHelper::getInstance()->replicatePointer(hPtr, shape::shapeInfoByteLength(hPtr));
-            ConstantDataBuffer buffer(hPtr, dPtr, shape::shapeInfoLength(hPtr) * sizeof(Nd4jLong), DataType::INT64);
-            ShapeDescriptor descriptor1(descriptor);
-            _cache[deviceId][descriptor1] = buffer;
-            ConstantDataBuffer &r = _cache[deviceId][descriptor1];
-            _mutex.unlock();
-
-            return r;
-        } else {
-            ConstantDataBuffer &r = _cache[deviceId].at(descriptor);
-            _mutex.unlock();
-
-            return r;
-        }
+            return ConstantDataBuffer(hPtr, dPtr, shape::shapeInfoLength(hPtr) * sizeof(Nd4jLong), DataType::INT64);
+        });
     }
 
     ConstantDataBuffer& ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *shapeInfo) {
@@ -82,18 +82,8 @@ namespace nd4j {
     }
 
     bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor &descriptor) {
-        bool result;
         auto deviceId = ConstantHelper::getCurrentDevice();
-        _mutex.lock();
-
-        if (_cache[deviceId].count(descriptor) == 0)
-            result = false;
-        else
-            result = true;
-
-        _mutex.unlock();
-
-        return result;
+        return _cache[deviceId]->find(descriptor, descriptor.hash()) != nullptr;
     }
 
     Nd4jLong* ConstantShapeHelper::createShapeInfo(const nd4j::DataType dataType, const char order, const int rank, const Nd4jLong* shape) {
@@ -144,5 +134,25 @@ namespace nd4j {
         return result;
     }
 
+    Nd4jLong ConstantShapeHelper::cachedEntries() {
+        return _cache[ConstantHelper::getCurrentDevice()]->size();
+    }
+
+    Nd4jLong ConstantShapeHelper::cachedBytes() {
+        return _cache[ConstantHelper::getCurrentDevice()]->bytes();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheHits() {
+        return _cache[ConstantHelper::getCurrentDevice()]->hits();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheMisses() {
+        return _cache[ConstantHelper::getCurrentDevice()]->misses();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheEvictions() {
+        return _cache[ConstantHelper::getCurrentDevice()]->evictions();
+    }
+
     nd4j::ConstantShapeHelper* nd4j::ConstantShapeHelper::_INSTANCE = 0;
 }
\ No newline at end of file
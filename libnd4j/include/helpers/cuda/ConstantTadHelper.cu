@@ -29,10 +29,8 @@ namespace nd4j {
     ConstantTadHelper::ConstantTadHelper() {
         auto numDevices = ConstantHelper::getNumberOfDevices();
 
-        for (int e = 0; e < numDevices; e++) {
-            std::map<TadDescriptor, TadPack> pack;
-            _cache.emplace_back(pack);
-        }
+        for (int e = 0; e < numDevices; e++)
+            _cache.emplace_back(new ConcurrentCache<TadDescriptor, TadPack, TadCacheTraits>());
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -42,30 +40,28 @@ namespace nd4j {
         return _INSTANCE;
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int dimension, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int dimension, const bool keepUnitiesInShape) {
         return tadForDimensions(originalShape, &dimension, 1, keepUnitiesInShape);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions, const bool keepUnitiesInShape) {
         return tadForDimensions(originalShape, const_cast<int *>(dimensions.data()), dimensions.size(), keepUnitiesInShape);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int* dimensions, int dimLength, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int* dimensions, int dimLength, const bool keepUnitiesInShape) {
         TadDescriptor tadDescriptor(originalShape, dimensions, dimLength, keepUnitiesInShape);
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape) {
+    TadPack ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape) {
         TadDescriptor tadDescriptor(descriptor, dimensions, keepUnitiesInShape);
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
+    TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         const int deviceId = ConstantHelper::getCurrentDevice();
 
-        _mutex.lock();
-
-        if (_cache[deviceId].count(descriptor) == 0) {
+        return _cache[deviceId]->get(descriptor, descriptor.hash(), [&descriptor] () {
             const auto shapeInfo = descriptor.originalShape().toShapeInfo();
             const int rank = shape::rank(shapeInfo);
             const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
@@ -92,21 +88,30 @@ namespace nd4j {
             ConstantDataBuffer shapesBuffer(sPtr, ssPtr, shape::shapeInfoLength(subArrRank) * sizeof(Nd4jLong), DataType::INT64);
             ConstantDataBuffer offsetsBuffer(oPtr, soPtr, numOfSubArrs * sizeof(Nd4jLong), DataType::INT64);
 
-            TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
-            _cache[deviceId][descriptor] = t;
+            delete[] shapeInfo;
 
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+            return TadPack(shapesBuffer, offsetsBuffer, numOfSubArrs);
+        });
+    }
 
-            delete[] shapeInfo;
+    Nd4jLong ConstantTadHelper::cachedEntries() {
+        return _cache[ConstantHelper::getCurrentDevice()]->size();
+    }
 
-            return r;
-        } else {
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+    Nd4jLong ConstantTadHelper::cachedBytes() {
+        return _cache[ConstantHelper::getCurrentDevice()]->bytes();
+    }
+
+    Nd4jLong ConstantTadHelper::cacheHits() {
+        return _cache[ConstantHelper::getCurrentDevice()]->hits();
+    }
+
+    Nd4jLong ConstantTadHelper::cacheMisses() {
+        return _cache[ConstantHelper::getCurrentDevice()]->misses();
+    }
 
-            return r;
-        }
+    Nd4jLong ConstantTadHelper::cacheEvictions() {
+        return _cache[ConstantHelper::getCurrentDevice()]->evictions();
     }
 
     nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
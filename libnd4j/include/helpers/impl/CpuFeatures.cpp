@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/CpuFeatures.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#define ND4J_HAS_CPUID
+#endif
+
+namespace nd4j {
+
+#ifdef ND4J_HAS_CPUID
+    // XCR0 shows which register states OS saves on context switch
+    static unsigned long long xcr0() {
+        unsigned int eax, edx;
+        __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+    }
+#endif
+
+    CpuFeatures::CpuFeatures() {
+#ifdef ND4J_HAS_CPUID
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return;
+
+        const bool osxsave = (ecx & (1u << 27)) != 0;
+        const bool avx = (ecx & (1u << 28)) != 0;
+        const auto xstate = osxsave ? xcr0() : 0ULL;
+
+        // xmm and ymm states
+        const bool ymmSaved = (xstate & 0x6) == 0x6;
+
+        // opmask, upper halves of zmm0-15, and zmm16-31 states
+        const bool zmmSaved = ymmSaved && (xstate & 0xe0) == 0xe0;
+
+        _f16c = avx && ymmSaved && (ecx & (1u << 29)) != 0;
+
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return;
+
+        _avx2 = avx && ymmSaved && (ebx & (1u << 5)) != 0;
+        _avx512f = zmmSaved && (ebx & (1u << 16)) != 0;
+        _avx512bw = _avx512f && (ebx & (1u << 30)) != 0;
+        _avx512vnni = _avx512f && (ecx & (1u << 11)) != 0;
+
+        if (_avx512f && eax >= 1 && __get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx))
+            _avx512bf16 = (eax & (1u << 5)) != 0;
+#endif
+    }
+
+    CpuFeatures* CpuFeatures::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new CpuFeatures();
+
+        return _INSTANCE;
+    }
+
+    bool CpuFeatures::hasF16C() {
+        return _f16c;
+    }
+
+    bool CpuFeatures::hasAVX2() {
+        return _avx2;
+    }
+
+    bool CpuFeatures::hasAVX512F() {
+        return _avx512f;
+    }
+
+    bool CpuFeatures::hasAVX512BW() {
+        return _avx512bw;
+    }
+
+    bool CpuFeatures::hasAVX512VNNI() {
+        return _avx512vnni;
+    }
+
+    bool CpuFeatures::hasAVX512BF16() {
+        return _avx512bf16;
+    }
+
+    CpuFeatures* CpuFeatures::_INSTANCE = 0;
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/EpochManager.h>
+
+namespace nd4j {
+    struct EpochRecord {
+        // epoch announced by owner thread, or 0 if it's outside of guard
+        std::atomic<Nd4jLong> active{0L};
+        std::atomic<bool> used{true};
+        EpochRecord *next = nullptr;
+
+        // keeps records on separate cache lines
+        int8_t padding[64];
+    };
+
+    class ThreadEpoch {
+    public:
+        EpochRecord *record = nullptr;
+        int depth = 0;
+
+        // record of exiting thread goes to other threads
+        ~ThreadEpoch() {
+            if (record != nullptr) {
+                record->active.store(0L, std::memory_order_release);
+                record->used.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    static thread_local ThreadEpoch _threadEpoch;
+
+    EpochManager* EpochManager::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new EpochManager();
+
+        return _INSTANCE;
+    }
+
+    EpochRecord* EpochManager::acquireRecord() {
+        for (auto record = _records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+            bool expected = false;
+            if (!record->used.load(std::memory_order_relaxed) && record->used.compare_exchange_strong(expected, true))
+                return record;
+        }
+
+        auto record = new EpochRecord();
+        record->next = _records.load(std::memory_order_relaxed);
+        while (!_records.compare_exchange_weak(record->next, record));
+
+        return record;
+    }
+
+    void EpochManager::enter() {
+        if (_threadEpoch.depth++ > 0)
+            return;
+
+        if (_threadEpoch.record == nullptr)
+            _threadEpoch.record = acquireRecord();
+
+        // announcement has to be visible before any read of shared memory
+        _threadEpoch.record->active.store(_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void EpochManager::leave() {
+        if (--_threadEpoch.depth == 0)
+            _threadEpoch.record->active.store(0L, std::memory_order_release);
+    }
+
+    Nd4jLong EpochManager::retire() {
+        return _epoch.fetch_add(1L, std::memory_order_seq_cst);
+    }
+
+    Nd4jLong EpochManager::safeEpoch() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto result = _epoch.load(std::memory_order_seq_cst);
+        for (auto record = _records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+            auto active = record->active.load(std::memory_order_acquire);
+            if (active != 0L && active < result)
+                result = active;
+        }
+
+        return result;
+    }
+
+    EpochManager* EpochManager::_INSTANCE = 0;
+}
@@ -0,0 +1,249 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/NumaHelper.h>
+#include <helpers/logger.h>
+#include <Environment.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+// linux/mempolicy.h
+#define ND4J_MPOL_PREFERRED 1
+#endif
+
+namespace nd4j {
+#if defined(__linux__)
+    // affinity masks saved by bindThread(), restored by unbindThread()
+    static thread_local std::vector<cpu_set_t> _savedMasks;
+    static thread_local std::vector<int> _savedNodes;
+#endif
+    static thread_local int _boundNode = -1;
+
+    NumaHelper::NumaHelper() {
+#if defined(__linux__)
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string list;
+        if (online.good() && std::getline(online, list)) {
+            for (auto node: parseList(list)) {
+                std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                std::string cpus;
+                if (!cpulist.good() || !std::getline(cpulist, cpus))
+                    continue;
+
+                if (node >= (int) _cpus.size())
+                    _cpus.resize(node + 1);
+
+                _cpus[node] = parseList(cpus);
+                for (auto cpu: _cpus[node]) {
+                    if (cpu >= (int) _nodes.size())
+                        _nodes.resize(cpu + 1, 0);
+
+                    _nodes[cpu] = node;
+                }
+            }
+        }
+#endif
+
+        // no topology available: single node
+        if (_cpus.empty())
+            _cpus.resize(1);
+
+        nd4j_debug("NUMA nodes found: %i\n", (int) _cpus.size());
+    }
+
+    std::vector<int> NumaHelper::parseList(const std::string &list) {
+        std::vector<int> result;
+        std::stringstream stream(list);
+        std::string token;
+
+        // lists look like this: 0-3,8-11
+        while (std::getline(stream, token, ',')) {
+            if (token.empty())
+                continue;
+
+            auto dash = token.find('-');
+            try {
+                if (dash == std::string::npos) {
+                    result.emplace_back(std::stoi(token));
+                } else {
+                    auto first = std::stoi(token.substr(0, dash));
+                    auto last = std::stoi(token.substr(dash + 1));
+                    for (int e = first; e <= last; e++)
+                        result.emplace_back(e);
+                }
+            } catch (std::exception &e) {
+                // malformed entries are just skipped
+            }
+        }
+
+        return result;
+    }
+
+    NumaHelper* NumaHelper::getInstance() {
+        if (_INSTANCE == 0)
+            _INSTANCE = new NumaHelper();
+
+        return _INSTANCE;
+    }
+
+    int NumaHelper::numberOfNodes() {
+        return static_cast<int>(_cpus.size());
+    }
+
+    bool NumaHelper::isAvailable() {
+        return _cpus.size() > 1;
+    }
+
+    std::vector<int> NumaHelper::cpusOfNode(int node) {
+        if (node < 0 || node >= (int) _cpus.size())
+            return std::vector<int>();
+
+        return _cpus[node];
+    }
+
+    int NumaHelper::boundNode() {
+        return _boundNode;
+    }
+
+    int NumaHelper::sessionNode() {
+        if (!isAvailable() || !Environment::getInstance()->isNumaAware())
+            return -1;
+
+        return currentNode();
+    }
+
+    int NumaHelper::currentNode() {
+        if (_boundNode >= 0)
+            return _boundNode;
+
+#if defined(__linux__)
+        auto cpu = sched_getcpu();
+        if (cpu >= 0 && cpu < (int) _nodes.size())
+            return _nodes[cpu];
+#endif
+
+        return 0;
+    }
+
+    bool NumaHelper::bindThread(int node) {
+#if defined(__linux__)
+        if (!isAvailable() || node < 0 || node >= (int) _cpus.size() || _cpus[node].empty())
+            return false;
+
+        cpu_set_t previous;
+        CPU_ZERO(&previous);
+        if (sched_getaffinity(0, sizeof(previous), &previous) != 0)
+            return false;
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        for (auto cpu: _cpus[node])
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &mask);
+
+        if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+            nd4j_debug("Failed to bind thread to NUMA node [%i]\n", node);
+            return false;
+        }
+
+        _savedMasks.emplace_back(previous);
+        _savedNodes.emplace_back(_boundNode);
+        _boundNode = node;
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void NumaHelper::unbindThread() {
+#if defined(__linux__)
+        if (_savedMasks.empty())
+            return;
+
+        auto previous = _savedMasks.back();
+        sched_setaffinity(0, sizeof(previous), &previous);
+
+        _boundNode = _savedNodes.back();
+        _savedMasks.pop_back();
+        _savedNodes.pop_back();
+#endif
+    }
+
+    void* NumaHelper::allocate(Nd4jLong numBytes, int node) {
+        if (!isAvailable() || node < 0 || node >= (int) _cpus.size())
+            return malloc(numBytes);
+
+#if defined(__linux__)
+        auto pageSize = static_cast<Nd4jLong>(sysconf(_SC_PAGESIZE));
+        auto length = (numBytes + pageSize - 1) / pageSize * pageSize;
+
+        void *ptr = nullptr;
+        if (posix_memalign(&ptr, pageSize, length) != 0)
+            return nullptr;
+
+        place(ptr, length, node);
+
+        return ptr;
+#else
+        return malloc(numBytes);
+#endif
+    }
+
+    void NumaHelper::place(void *ptr, Nd4jLong numBytes, int node) {
+#if defined(__linux__)
+        if (!isAvailable() || node < 0 || node >= (int) _cpus.size())
+            return;
+
+        // preferred policy falls back to other nodes if given one has no free memory
+        unsigned long mask[16];
+        memset(mask, 0, sizeof(mask));
+        if (node < (int) (sizeof(mask) * 8)) {
+            mask[node / (sizeof(unsigned long) * 8)] |= 1UL << (node % (sizeof(unsigned long) * 8));
+            if (syscall(SYS_mbind, ptr, numBytes, ND4J_MPOL_PREFERRED, mask, sizeof(mask) * 8 + 1, 0) != 0)
+                nd4j_debug("mbind failed for NUMA node [%i], relying on first touch\n", node);
+        }
+#endif
+    }
+
+    void NumaHelper::touch(void *ptr, Nd4jLong numBytes, int node) {
+        NumaBinding binding(node);
+        memset(ptr, 0, numBytes);
+    }
+
+    NumaBinding::NumaBinding(int node) {
+        if (node >= 0)
+            _bound = NumaHelper::getInstance()->bindThread(node);
+    }
+
+    NumaBinding::~NumaBinding() {
+        if (_bound)
+            NumaHelper::getInstance()->unbindThread();
+    }
+
+    NumaHelper* NumaHelper::_INSTANCE = 0;
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/QuantizationCalibrator.h>
+#include <cmath>
+
+namespace nd4j {
+
+    void QuantizationCalibrator::observe(const NDArray &array) {
+        if (array.lengthOf() == 0)
+            return;
+
+        auto min = array.reduceNumber(nd4j::reduce::Min).e<double>(0);
+        auto max = array.reduceNumber(nd4j::reduce::Max).e<double>(0);
+
+        _min = _observations > 0 ? nd4j::math::nd4j_min<double>(_min, min) : min;
+        _max = _observations > 0 ? nd4j::math::nd4j_max<double>(_max, max) : max;
+        _observations++;
+    }
+
+    void QuantizationCalibrator::reset() {
+        _min = 0.;
+        _max = 0.;
+        _observations = 0;
+    }
+
+    Nd4jLong QuantizationCalibrator::observations() const {
+        return _observations;
+    }
+
+    double QuantizationCalibrator::min() const {
+        return _min;
+    }
+
+    double QuantizationCalibrator::max() const {
+        return _max;
+    }
+
+    double QuantizationCalibrator::scale(const int qMin, const int qMax) const {
+        double scale;
+        int zeroPoint;
+        paramsOf(_min, _max, qMin, qMax, scale, zeroPoint);
+
+        return scale;
+    }
+
+    int QuantizationCalibrator::zeroPoint(const int qMin, const int qMax) const {
+        double scale;
+        int zeroPoint;
+        paramsOf(_min, _max, qMin, qMax, scale, zeroPoint);
+
+        return zeroPoint;
+    }
+
+    void QuantizationCalibrator::paramsOf(double min, double max, const int qMin, const int qMax, double &scale, int &zeroPoint) {
+        min = nd4j::math::nd4j_min<double>(min, 0.);
+        max = nd4j::math::nd4j_max<double>(max, 0.);
+
+        scale = (max - min) / (qMax - qMin);
+
+        // constant zero range, any scale works
+        if (scale == 0.) {
+            scale = 1.;
+            zeroPoint = nd4j::math::nd4j_max<int>(qMin, nd4j::math::nd4j_min<int>(qMax, 0));
+            return;
+        }
+
+        zeroPoint = static_cast<int>(std::nearbyint(qMin - min / scale));
+        zeroPoint = nd4j::math::nd4j_max<int>(qMin, nd4j::math::nd4j_min<int>(qMax, zeroPoint));
+    }
+
+    void QuantizationCalibrator::symmetricParamsOf(const double absMax, const int qMax, double &scale, int &zeroPoint) {
+        scale = absMax > 0. ? absMax / qMax : 1.;
+        zeroPoint = 0;
+    }
+}
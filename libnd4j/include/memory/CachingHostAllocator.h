@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_CACHINGHOSTALLOCATOR_H
+#define LIBND4J_CACHINGHOSTALLOCATOR_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace nd4j {
+    namespace memory {
+        class ThreadCache;
+
+        /**
+         * This class caches host buffers allocated outside of workspaces, so short-lived arrays don't hit malloc/free every time.
+         *
+         * Blocks are binned by power-of-2 size classes. Each thread keeps a few blocks per class for itself,
+         * everything else goes to shared bins, as long as total cached size stays below Environment::hostCacheLimit().
+         * Caching is controlled via Environment::setHostCache(), and is disabled by default under ASAN.
+         */
+        class ND4J_EXPORT CachingHostAllocator {
+            friend class ThreadCache;
+        private:
+            static CachingHostAllocator* _INSTANCE;
+
+            // shared bins, one per size class
+            std::vector<std::vector<void*>> _bins;
+            std::mutex _mutex;
+
+            // size of all cached blocks, thread caches included
+            std::atomic<Nd4jLong> _cachedBytes{0L};
+
+            std::atomic<Nd4jLong> _hits{0L};
+            std::atomic<Nd4jLong> _misses{0L};
+
+            CachingHostAllocator();
+            ~CachingHostAllocator() = default;
+
+            // puts block to shared bin, or frees it if limit is reached
+            void releaseShared(void *block, int sizeClass);
+        public:
+            static CachingHostAllocator* getInstance();
+
+            /**
+             * This method returns block of at least numBytes bytes. Memory isn't zeroed.
+             */
+            void* allocate(Nd4jLong numBytes);
+
+            /**
+             * This method returns block obtained via allocate() back to cache
+             */
+            void release(void *ptr);
+
+            /**
+             * This method frees all blocks cached in shared bins, and in bins of calling thread
+             */
+            void trim();
+
+            // total size of cached blocks, in bytes
+            Nd4jLong cachedBytes();
+
+            // number of allocations served from cache, and number of allocations that went to system allocator
+            Nd4jLong hits();
+            Nd4jLong misses();
+        };
+    }
+}
+
+#endif //LIBND4J_CACHINGHOSTALLOCATOR_H
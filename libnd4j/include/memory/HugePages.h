@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HUGEPAGES_H
+#define LIBND4J_HUGEPAGES_H
+
+#include <dll.h>
+#include <pointercast.h>
+
+namespace nd4j {
+    namespace memory {
+        /**
+         * This class allocates large host buffers backed by 2MB pages: explicit hugetlb pages if any are reserved,
+         * transparent huge pages (2MB-aligned mmap + MADV_HUGEPAGE) otherwise.
+         *
+         * Policy is controlled via Environment::setHugePages() and Environment::setHugePagesThreshold().
+         * Allocations are zero-filled, and are released with release() only.
+         */
+        class ND4J_EXPORT HugePages {
+        public:
+            /**
+             * This method returns TRUE if allocation of given size should be backed by huge pages, according to Environment
+             */
+            static bool isEligible(Nd4jLong numBytes);
+
+            /**
+             * This method returns huge pages backed memory region, or nullptr if it can't be allocated on this platform
+             */
+            static void* allocate(Nd4jLong numBytes);
+
+            /**
+             * This method releases given region if it was allocated via allocate()
+             * @return FALSE if pointer doesn't belong to HugePages, so caller should release it on its own
+             */
+            static bool release(void *ptr);
+
+            // number of currently allocated regions, and how many of them are backed by explicit hugetlb pages
+            static Nd4jLong numberOfRegions();
+            static Nd4jLong numberOfHugeTlbRegions();
+
+            // total size of currently allocated regions, in bytes
+            static Nd4jLong allocatedBytes();
+        };
+    }
+}
+
+#endif //LIBND4J_HUGEPAGES_H
@@ -30,6 +30,10 @@ namespace nd4j {
             Nd4jLong _vm = 0;
             Nd4jLong _rss = 0;
 
+            // estimates provided by static memory planner
+            Nd4jLong _plannedPeak = 0;
+            Nd4jLong _plannedTotal = 0;
+
         public:
             MemoryReport() = default;
             ~MemoryReport() = default;
@@ -46,6 +50,18 @@ namespace nd4j {
 
             Nd4jLong getRSS() const;
             void setRSS(Nd4jLong rss);
+
+            /**
+             * Arena size required for intermediate arrays of planned graph, in bytes
+             */
+            Nd4jLong getPlannedPeak() const;
+            void setPlannedPeak(Nd4jLong bytes);
+
+            /**
+             * Size of the same intermediate arrays without memory reuse, in bytes
+             */
+            Nd4jLong getPlannedTotal() const;
+            void setPlannedTotal(Nd4jLong bytes);
         };
     }
 }
@@ -38,6 +38,14 @@ namespace nd4j {
 
         class ND4J_EXPORT Workspace {
         protected:
+            // header placed in front of each spilled allocation
+            struct SpillNode {
+                SpillNode* next;
+
+                // index of size class, or -1 for allocations too big to be pooled
+                Nd4jLong sizeClass;
+            };
+
             char* _ptrHost = nullptr;
             char* _ptrDevice = nullptr;
 
@@ -67,8 +75,44 @@ namespace nd4j {
             std::atomic<Nd4jLong> _spillsSizeSecondary;
             std::atomic<Nd4jLong> _cycleAllocationsSecondary;
 
+            // in thread-local mode each thread bump-allocates from its own chunk of primary buffer
+            bool _threadLocal = false;
+            Nd4jLong _chunkSize = 0L;
+
+            // changes whenever buffer is reset or reallocated, so threads know their chunks are gone
+            std::atomic<Nd4jLong> _generation{0L};
+
+            // spills of current cycle, lock-free list
+            std::atomic<SpillNode*> _spillsList{nullptr};
+
+            // released spills are kept in size-classed pool, and reused in next cycles. guarded by _mutexSpills
+            std::vector<std::vector<SpillNode*>> _spillsPool;
+            Nd4jLong _spillsPoolSize = 0L;
+
+            std::atomic<Nd4jLong> _spillsHits{0L};
+            std::atomic<Nd4jLong> _spillsMisses{0L};
+
+            // NUMA node primary buffer is allocated on, -1 means node of the thread bound via NumaHelper, if any
+            int _numaNode = -1;
+
+            // smoothed size of allocations per cycle, used only to shrink workspace once it's mostly unused
+            Nd4jLong _cycleAverage = 0L;
+
+            // number of consecutive cycles that didn't fit into workspace, and the biggest of them
+            int _overflowCycles = 0;
+            Nd4jLong _overflowPeak = 0L;
+
+            std::atomic<Nd4jLong> _reallocations{0L};
+
             void init(Nd4jLong primaryBytes, Nd4jLong secondaryBytes = 0L);
+            char* allocateHostBuffer(Nd4jLong numBytes);
+            void releaseHostBuffer();
             void freeSpills();
+
+            void nextGeneration();
+            void* allocateThreadLocal(Nd4jLong numBytes);
+            void* allocateSpill(Nd4jLong numBytes);
+            void trimSpillsPool(Nd4jLong limit);
         public:
             explicit Workspace(ExternalWorkspace *external);
             Workspace(Nd4jLong initialSize = 0L, Nd4jLong secondaryBytes = 0L);
@@ -80,6 +124,16 @@ namespace nd4j {
             Nd4jLong getSpilledSize();
             Nd4jLong getUsedSize();
 
+            // number of spilled allocations served from spills pool, and number of allocations that required malloc
+            Nd4jLong getSpillsHits();
+            Nd4jLong getSpillsMisses();
+
+            // number of bytes held in spills pool
+            Nd4jLong getSpillsPoolSize();
+
+            // number of times primary buffer was reallocated after construction
+            Nd4jLong getReallocations();
+
             Nd4jLong getAllocatedSecondarySize();
             Nd4jLong getCurrentSecondarySize();
             Nd4jLong getCurrentSecondaryOffset();
@@ -94,6 +148,27 @@ namespace nd4j {
             void* allocateBytes(Nd4jLong numBytes);
             void* allocateBytes(MemoryType type, Nd4jLong numBytes);
 
+            /**
+             * This method switches workspace to thread-local mode: each thread carves its own chunk out of primary buffer
+             * with single atomic op, and allocates from that chunk without locks. Spills are kept in lock-free list.
+             *
+             * PLEASE NOTE: mode must be changed only while there are no allocations in progress, i.e. between scopes
+             *
+             * @param reallyThreadLocal
+             * @param chunkSize - size of per-thread chunk, in bytes, rounded up to multiple of 16. 0 means default size
+             */
+            void setThreadLocal(bool reallyThreadLocal, Nd4jLong chunkSize = 0L);
+            bool isThreadLocal();
+
+            /**
+             * This method binds workspace to given NUMA node: primary buffer is reallocated there, and first touched by thread pinned to that node.
+             * Has no effect on single-node machines.
+             *
+             * PLEASE NOTE: existing primary buffer content is lost, so this method must be called between scopes
+             */
+            void setNumaNode(int node);
+            int numaNode();
+
             void scopeIn();
             void scopeOut();
 
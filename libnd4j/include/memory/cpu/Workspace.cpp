@@ -27,12 +27,41 @@
 #include <stdlib.h>
 #include "../Workspace.h"
 #include <helpers/logger.h>
+#include <helpers/NumaHelper.h>
+#include <memory/HugePages.h>
 #include <templatemath.h>
 #include <cstring>
 
+#define DEFAULT_CHUNK_SIZE 65536L
+#define MIN_CHUNK_SIZE 256L
+#define NUM_THREAD_CHUNKS 4
+
+// spills are pooled in power-of-2 size classes, from 64 bytes to 128MB
+#define MIN_SPILL_CLASS 64L
+#define SPILLS_SIZE_CLASSES 22
+
+// spilled buffers are preceded by SpillNode, this keeps them 16-bytes aligned
+#define SPILL_HEADER 16L
+
+// number of consecutive overflowing cycles before workspace grows, single spike is served from spills pool
+#define OVERFLOW_CYCLES 2
 
 namespace nd4j {
     namespace memory {
+        // chunk of some workspace owned by current thread
+        struct ThreadChunk {
+            Nd4jLong generation = -1L;
+            char* ptr = nullptr;
+            char* end = nullptr;
+        };
+
+        // single thread might work with few workspaces at once
+        static thread_local ThreadChunk _threadChunks[NUM_THREAD_CHUNKS];
+        static thread_local int _threadVictim = 0;
+
+        // generations are unique across all workspaces, so chunks of deleted workspace are never matched
+        static std::atomic<Nd4jLong> _generations(1L);
+
         Workspace::Workspace(ExternalWorkspace *external) {
             if (external->sizeHost() > 0) {
                 _ptrHost = (char *) external->pointerHost();
@@ -47,15 +76,14 @@ namespace nd4j {
 
                 _externalized = true;
             }
+
+            _spillsPool.resize(SPILLS_SIZE_CLASSES);
+            nextGeneration();
         };
 
         Workspace::Workspace(Nd4jLong initialSize, Nd4jLong secondaryBytes) {
             if (initialSize > 0) {
-                this->_ptrHost = (char *) malloc(initialSize);
-
-                CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace", initialSize);
-
-                memset(this->_ptrHost, 0, initialSize);
+                this->_ptrHost = allocateHostBuffer(initialSize);
                 this->_allocatedHost = true;
             } else
                 this->_allocatedHost = false;
@@ -66,21 +94,100 @@ namespace nd4j {
             this->_offsetSecondary = 0;
             this->_cycleAllocations = 0;
             this->_spillsSize = 0;
+
+            _spillsPool.resize(SPILLS_SIZE_CLASSES);
+            nextGeneration();
+        }
+
+        void Workspace::nextGeneration() {
+            _generation.store(_generations++);
+        }
+
+        void Workspace::setThreadLocal(bool reallyThreadLocal, Nd4jLong chunkSize) {
+            _threadLocal = reallyThreadLocal;
+            // chunks are carved back to back, so their size has to keep allocations aligned
+            _chunkSize = chunkSize > 0 ? (chunkSize + 15L) & ~15L : DEFAULT_CHUNK_SIZE;
+
+            // chunks carved before are not valid anymore
+            nextGeneration();
+        }
+
+        bool Workspace::isThreadLocal() {
+            return _threadLocal;
         }
 
         void Workspace::init(Nd4jLong bytes, Nd4jLong secondaryBytes) {
             if (this->_currentSize < bytes) {
                 if (this->_allocatedHost && !_externalized)
-                    free((void *)this->_ptrHost);
+                    releaseHostBuffer();
 
-                this->_ptrHost =(char *) malloc(bytes);
-
-                CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace", bytes);
-
-                memset(this->_ptrHost, 0, bytes);
+                this->_ptrHost = allocateHostBuffer(bytes);
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
+                _reallocations++;
+
+                nextGeneration();
+            }
+        }
+
+        char* Workspace::allocateHostBuffer(Nd4jLong numBytes) {
+            auto numa = NumaHelper::getInstance();
+            auto node = _numaNode >= 0 ? _numaNode : numa->boundNode();
+
+            // huge pages come zero-filled, and aren't faulted in until used
+            if (HugePages::isEligible(numBytes)) {
+                auto ptr = (char *) HugePages::allocate(numBytes);
+                if (ptr != nullptr) {
+                    if (node >= 0 && numa->isAvailable()) {
+                        numa->place(ptr, numBytes, node);
+                        numa->touch(ptr, numBytes, node);
+                    }
+
+                    return ptr;
+                }
             }
+
+            if (node >= 0 && numa->isAvailable()) {
+                auto ptr = (char *) numa->allocate(numBytes, node);
+
+                CHECK_ALLOC(ptr, "Failed to allocate new workspace", numBytes);
+
+                // zero-fill doubles as first touch from the owning node
+                numa->touch(ptr, numBytes, node);
+
+                return ptr;
+            }
+
+            auto ptr = (char *) malloc(numBytes);
+
+            CHECK_ALLOC(ptr, "Failed to allocate new workspace", numBytes);
+
+            memset(ptr, 0, numBytes);
+
+            return ptr;
+        }
+
+        void Workspace::releaseHostBuffer() {
+            if (!HugePages::release(_ptrHost))
+                free((void *) _ptrHost);
+
+            _ptrHost = nullptr;
+        }
+
+        void Workspace::setNumaNode(int node) {
+            _numaNode = node;
+
+            if (!NumaHelper::getInstance()->isAvailable() || !_allocatedHost || _externalized || _currentSize < 1)
+                return;
+
+            releaseHostBuffer();
+            _ptrHost = allocateHostBuffer(_currentSize);
+
+            nextGeneration();
+        }
+
+        int Workspace::numaNode() {
+            return _numaNode;
         }
 
         void Workspace::expandBy(Nd4jLong numBytes, Nd4jLong secondaryBytes) {
@@ -94,20 +201,43 @@ namespace nd4j {
         void Workspace::freeSpills() {
             _spillsSize = 0;
 
-            if (_spills.size() < 1)
+            auto node = _spillsList.exchange(nullptr);
+            if (node == nullptr)
                 return;
 
-            for (auto v:_spills)
-                free(v);
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            while (node != nullptr) {
+                auto next = node->next;
+                if (node->sizeClass >= 0) {
+                    _spillsPool[node->sizeClass].emplace_back(node);
+                    _spillsPoolSize += MIN_SPILL_CLASS << node->sizeClass;
+                } else
+                    free(node);
+
+                node = next;
+            }
+        }
 
-            _spills.clear();
+        void Workspace::trimSpillsPool(Nd4jLong limit) {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+
+            // biggest buffers go first, they're the ones most likely to be absorbed by grown workspace
+            for (int e = (int) _spillsPool.size() - 1; e >= 0 && _spillsPoolSize > limit; e--) {
+                auto &bucket = _spillsPool[e];
+                while (!bucket.empty() && _spillsPoolSize > limit) {
+                    free(bucket.back());
+                    bucket.pop_back();
+                    _spillsPoolSize -= MIN_SPILL_CLASS << e;
+                }
+            }
         }
 
         Workspace::~Workspace() {
             if (this->_allocatedHost && !_externalized)
-                free((void *)this->_ptrHost);
+                releaseHostBuffer();
 
             freeSpills();
+            trimSpillsPool(0L);
         }
 
         Nd4jLong Workspace::getUsedSize() {
@@ -119,14 +249,130 @@ namespace nd4j {
         }
 
         Nd4jLong Workspace::getCurrentOffset() {
-            return _offset.load();
+            // in thread-local mode failed chunk reservations might move offset beyond buffer
+            return nd4j::math::nd4j_min<Nd4jLong>(_offset.load(), _currentSize);
         }
 
+        Nd4jLong Workspace::getSpillsHits() {
+            return _spillsHits.load();
+        }
+
+        Nd4jLong Workspace::getSpillsMisses() {
+            return _spillsMisses.load();
+        }
+
+        Nd4jLong Workspace::getSpillsPoolSize() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            return _spillsPoolSize;
+        }
+
+        Nd4jLong Workspace::getReallocations() {
+            return _reallocations.load();
+        }
+
+        void* Workspace::allocateSpill(Nd4jLong numBytes) {
+            nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
+
+            Nd4jLong sizeClass = -1;
+            Nd4jLong classBytes = numBytes;
+            for (int e = 0; e < SPILLS_SIZE_CLASSES; e++) {
+                if (numBytes <= (MIN_SPILL_CLASS << e)) {
+                    sizeClass = e;
+                    classBytes = MIN_SPILL_CLASS << e;
+                    break;
+                }
+            }
+
+            SpillNode *node = nullptr;
+            if (sizeClass >= 0) {
+                std::lock_guard<std::mutex> lock(_mutexSpills);
+                auto &bucket = _spillsPool[sizeClass];
+                if (!bucket.empty()) {
+                    node = bucket.back();
+                    bucket.pop_back();
+                    _spillsPoolSize -= classBytes;
+                }
+            }
+
+            if (node != nullptr) {
+                _spillsHits++;
+            } else {
+                _spillsMisses++;
+                node = (SpillNode *) malloc(classBytes + SPILL_HEADER);
+
+                CHECK_ALLOC(node, "Failed to allocate new workspace", numBytes);
+
+                node->sizeClass = sizeClass;
+            }
+
+            node->next = _spillsList.load();
+            while (!_spillsList.compare_exchange_weak(node->next, node));
+
+            _spillsSize += numBytes;
+
+            return reinterpret_cast<char *>(node) + SPILL_HEADER;
+        }
+
+        void* Workspace::allocateThreadLocal(Nd4jLong numBytes) {
+            // chunks are carved at 16 bytes boundaries, so we keep the same alignment within chunk
+            auto alignedBytes = (numBytes + 15L) & ~15L;
+            auto generation = _generation.load();
+
+            ThreadChunk *chunk = nullptr;
+            for (int e = 0; e < NUM_THREAD_CHUNKS; e++) {
+                if (_threadChunks[e].generation == generation) {
+                    chunk = &_threadChunks[e];
+                    break;
+                }
+            }
+
+            // fast path: bump pointer within own chunk
+            if (chunk != nullptr && chunk->ptr + alignedBytes <= chunk->end) {
+                auto result = chunk->ptr;
+                chunk->ptr += alignedBytes;
+
+                return result;
+            }
+
+            // chunks can't take more than 1/8 of workspace, otherwise few threads would exhaust it
+            auto chunkSize = nd4j::math::nd4j_max<Nd4jLong>(MIN_CHUNK_SIZE, nd4j::math::nd4j_min<Nd4jLong>(_chunkSize, (_currentSize / 8L) & ~15L));
+
+            // big allocations go directly to the shared buffer
+            if (alignedBytes * 2 > chunkSize) {
+                this->_cycleAllocations += alignedBytes;
+                auto offset = _offset.fetch_add(alignedBytes);
+                if (offset + alignedBytes > _currentSize)
+                    return allocateSpill(numBytes);
+
+                return _ptrHost + offset;
+            }
+
+            auto offset = _offset.fetch_add(chunkSize);
+            if (offset + chunkSize > _currentSize) {
+                this->_cycleAllocations += alignedBytes;
+                return allocateSpill(numBytes);
+            }
+
+            this->_cycleAllocations += chunkSize;
+
+            if (chunk == nullptr) {
+                chunk = &_threadChunks[_threadVictim];
+                _threadVictim = (_threadVictim + 1) % NUM_THREAD_CHUNKS;
+            }
+
+            chunk->generation = generation;
+            chunk->ptr = _ptrHost + offset + alignedBytes;
+            chunk->end = _ptrHost + offset + chunkSize;
+
+            return _ptrHost + offset;
+        }
 
         void* Workspace::allocateBytes(Nd4jLong numBytes) {
             if (numBytes < 1)
                 throw allocation_exception::build("Number of bytes for allocation should be positive", numBytes);
 
+            if (_threadLocal)
+                return allocateThreadLocal(numBytes);
 
             //numBytes += 32;
             void* result = nullptr;
@@ -134,20 +380,9 @@ namespace nd4j {
             this->_mutexAllocation.lock();
 
             if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
                 this->_mutexAllocation.unlock();
 
-                void *p = malloc(numBytes);
-
-                CHECK_ALLOC(p, "Failed to allocate new workspace", numBytes);
-
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
-
-                _spillsSize += numBytes;
-
-                return p;
+                return allocateSpill(numBytes);
             }
 
             result = (void *)(_ptrHost + _offset.load());
@@ -167,13 +402,48 @@ namespace nd4j {
 
         void Workspace::scopeIn() {
             freeSpills();
-            init(_cycleAllocations.load());
+
+            auto cycle = _cycleAllocations.load();
+            _cycleAverage = _cycleAverage == 0 ? cycle : (_cycleAverage * 3 + cycle) / 4;
+
+            if (cycle > _currentSize) {
+                // once overflow persists, workspace grows straight to the biggest cycle seen, but at least twice,
+                // so steadily growing cycles don't reallocate every time
+                _overflowPeak = nd4j::math::nd4j_max<Nd4jLong>(_overflowPeak, cycle);
+                if (++_overflowCycles >= OVERFLOW_CYCLES) {
+                    init(nd4j::math::nd4j_max<Nd4jLong>(_overflowPeak, _currentSize * 2));
+
+                    _overflowCycles = 0;
+                    _overflowPeak = 0L;
+                }
+            } else {
+                _overflowCycles = 0;
+                _overflowPeak = 0L;
+
+                // smoothed cycle size is used only for shrinking, so workspace mostly unused for a while gets back to twice of it
+                if (_cycleAverage * 4 < _currentSize && _currentSize > _initialSize && _allocatedHost && !_externalized) {
+                    auto bytes = nd4j::math::nd4j_max<Nd4jLong>(_initialSize, _cycleAverage * 2);
+
+                    releaseHostBuffer();
+                    _ptrHost = allocateHostBuffer(bytes);
+                    _currentSize = bytes;
+                    _reallocations++;
+
+                    nextGeneration();
+                }
+            }
+
             _cycleAllocations = 0;
+
+            // pool never holds more than workspace itself
+            trimSpillsPool(_currentSize);
         }
 
         void Workspace::scopeOut() {
             _offset = 0;
             _offsetSecondary = 0;
+
+            nextGeneration();
         }
 
         Nd4jLong Workspace::getSpilledSize() {
@@ -209,7 +479,14 @@ namespace nd4j {
 
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            auto result = new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            if (_threadLocal)
+                result->setThreadLocal(true, _chunkSize);
+
+            if (_numaNode >= 0)
+                result->setNumaNode(_numaNode);
+
+            return result;
         }
     }
 }
@@ -98,6 +98,7 @@ namespace nd4j {
                 cudaMemset(this->_ptrDevice, 0, primaryBytes);
                 this->_currentSize = primaryBytes;
                 this->_allocatedDevice = true;
+                _reallocations++;
             }
 
             if (this->_currentSizeSecondary < secondaryBytes) {
@@ -267,6 +268,42 @@ namespace nd4j {
             }
         }
 
+        Nd4jLong Workspace::getSpillsHits() {
+            return _spillsHits.load();
+        }
+
+        Nd4jLong Workspace::getSpillsMisses() {
+            return _spillsMisses.load();
+        }
+
+        Nd4jLong Workspace::getSpillsPoolSize() {
+            // CUDA spills aren't pooled
+            return 0L;
+        }
+
+        Nd4jLong Workspace::getReallocations() {
+            return _reallocations.load();
+        }
+
+        void Workspace::setThreadLocal(bool reallyThreadLocal, Nd4jLong chunkSize) {
+            // CUDA workspaces keep locked allocations, since device memory can't be carved per thread the same way
+            _threadLocal = reallyThreadLocal;
+            _chunkSize = chunkSize;
+        }
+
+        bool Workspace::isThreadLocal() {
+            return _threadLocal;
+        }
+
+        void Workspace::setNumaNode(int node) {
+            // host buffers of CUDA workspaces aren't NUMA-placed
+            _numaNode = node;
+        }
+
+        int Workspace::numaNode() {
+            return _numaNode;
+        }
+
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
             return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <memory/CachingHostAllocator.h>
+#include <exceptions/allocation_exception.h>
+#include <Environment.h>
+#include <op_boilerplate.h>
+#include <cstdlib>
+
+// every block starts with header holding its size class, and data stays 16 bytes aligned
+#define HOST_CACHE_HEADER 16
+#define HOST_CACHE_MIN_CLASS 64L
+#define HOST_CACHE_CLASSES 21
+
+// each thread keeps up to THREAD_CACHE_ENTRIES blocks per class, for classes up to 1MB only
+#define THREAD_CACHE_ENTRIES 4
+#define THREAD_CACHE_CLASSES 15
+
+namespace nd4j {
+    namespace memory {
+
+        class ThreadCache {
+        public:
+            void* _blocks[THREAD_CACHE_CLASSES][THREAD_CACHE_ENTRIES];
+            int _counts[THREAD_CACHE_CLASSES];
+            bool _alive = true;
+
+            ThreadCache() {
+                for (int e = 0; e < THREAD_CACHE_CLASSES; e++)
+                    _counts[e] = 0;
+            }
+
+            // blocks of exiting thread go to shared bins, they're accounted in cachedBytes already
+            ~ThreadCache() {
+                auto allocator = CachingHostAllocator::getInstance();
+
+                std::lock_guard<std::mutex> lock(allocator->_mutex);
+                for (int e = 0; e < THREAD_CACHE_CLASSES; e++) {
+                    for (int i = 0; i < _counts[e]; i++)
+                        allocator->_bins[e].emplace_back(_blocks[e][i]);
+
+                    _counts[e] = 0;
+                }
+
+                _alive = false;
+            }
+        };
+
+        static thread_local ThreadCache _threadCache;
+
+        static FORCEINLINE Nd4jLong bytesOfClass(int sizeClass) {
+            return HOST_CACHE_MIN_CLASS << sizeClass;
+        }
+
+        // returns -1 for blocks that are too large to be cached
+        static FORCEINLINE int classOf(Nd4jLong numBytes) {
+            int sizeClass = 0;
+            while (bytesOfClass(sizeClass) < numBytes && sizeClass < HOST_CACHE_CLASSES)
+                sizeClass++;
+
+            return sizeClass < HOST_CACHE_CLASSES ? sizeClass : -1;
+        }
+
+        static FORCEINLINE void* dataOf(void *block) {
+            return reinterpret_cast<int8_t*>(block) + HOST_CACHE_HEADER;
+        }
+
+        static FORCEINLINE void* blockOf(void *ptr) {
+            return reinterpret_cast<int8_t*>(ptr) - HOST_CACHE_HEADER;
+        }
+
+        CachingHostAllocator::CachingHostAllocator() {
+            _bins.resize(HOST_CACHE_CLASSES);
+        }
+
+        CachingHostAllocator* CachingHostAllocator::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new CachingHostAllocator();
+
+            return _INSTANCE;
+        }
+
+        void* CachingHostAllocator::allocate(Nd4jLong numBytes) {
+            auto sizeClass = classOf(numBytes);
+
+            if (sizeClass >= 0 && Environment::getInstance()->isHostCache()) {
+                void *block = nullptr;
+
+                if (sizeClass < THREAD_CACHE_CLASSES && _threadCache._alive && _threadCache._counts[sizeClass] > 0) {
+                    block = _threadCache._blocks[sizeClass][--_threadCache._counts[sizeClass]];
+                } else {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_bins[sizeClass].empty()) {
+                        block = _bins[sizeClass].back();
+                        _bins[sizeClass].pop_back();
+                    }
+                }
+
+                if (block != nullptr) {
+                    _cachedBytes.fetch_sub(bytesOfClass(sizeClass), std::memory_order_relaxed);
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    return dataOf(block);
+                }
+
+                _misses.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            auto length = sizeClass >= 0 ? bytesOfClass(sizeClass) : numBytes;
+            auto block = std::malloc(length + HOST_CACHE_HEADER);
+            if (block == nullptr)
+                throw nd4j::allocation_exception::build("CachingHostAllocator: failed to allocate memory", length);
+
+            *reinterpret_cast<Nd4jLong*>(block) = sizeClass;
+
+            return dataOf(block);
+        }
+
+        void CachingHostAllocator::release(void *ptr) {
+            if (ptr == nullptr)
+                return;
+
+            auto block = blockOf(ptr);
+            auto sizeClass = static_cast<int>(*reinterpret_cast<Nd4jLong*>(block));
+            auto env = Environment::getInstance();
+
+            if (sizeClass < 0 || !env->isHostCache()) {
+                std::free(block);
+                return;
+            }
+
+            // reserving space in cache first, so concurrent releases can't overshoot the limit
+            auto length = bytesOfClass(sizeClass);
+            if (_cachedBytes.fetch_add(length, std::memory_order_relaxed) + length > env->hostCacheLimit()) {
+                _cachedBytes.fetch_sub(length, std::memory_order_relaxed);
+                std::free(block);
+                return;
+            }
+
+            if (sizeClass < THREAD_CACHE_CLASSES && _threadCache._alive && _threadCache._counts[sizeClass] < THREAD_CACHE_ENTRIES) {
+                _threadCache._blocks[sizeClass][_threadCache._counts[sizeClass]++] = block;
+                return;
+            }
+
+            releaseShared(block, sizeClass);
+        }
+
+        void CachingHostAllocator::releaseShared(void *block, int sizeClass) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _bins[sizeClass].emplace_back(block);
+        }
+
+        void CachingHostAllocator::trim() {
+            Nd4jLong freed = 0;
+
+            if (_threadCache._alive) {
+                for (int e = 0; e < THREAD_CACHE_CLASSES; e++) {
+                    for (int i = 0; i < _threadCache._counts[e]; i++) {
+                        std::free(_threadCache._blocks[e][i]);
+                        freed += bytesOfClass(e);
+                    }
+
+                    _threadCache._counts[e] = 0;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (int e = 0; e < HOST_CACHE_CLASSES; e++) {
+                    for (auto block : _bins[e]) {
+                        std::free(block);
+                        freed += bytesOfClass(e);
+                    }
+
+                    _bins[e].clear();
+                    _bins[e].shrink_to_fit();
+                }
+            }
+
+            _cachedBytes.fetch_sub(freed);
+        }
+
+        Nd4jLong CachingHostAllocator::cachedBytes() {
+            return _cachedBytes.load();
+        }
+
+        Nd4jLong CachingHostAllocator::hits() {
+            return _hits.load();
+        }
+
+        Nd4jLong CachingHostAllocator::misses() {
+            return _misses.load();
+        }
+
+        CachingHostAllocator* CachingHostAllocator::_INSTANCE = 0;
+    }
+}
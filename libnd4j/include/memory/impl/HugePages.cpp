@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <memory/HugePages.h>
+#include <helpers/logger.h>
+#include <Environment.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#define HUGE_PAGE_SIZE (2L * 1024L * 1024L)
+
+namespace nd4j {
+    namespace memory {
+        // region length, and whether it's hugetlb-backed
+        static std::map<void*, std::pair<Nd4jLong, bool>> _regions;
+        static std::mutex _mutex;
+
+        // releases of regular buffers only check this counter
+        static std::atomic<Nd4jLong> _numberOfRegions(0L);
+        static std::atomic<Nd4jLong> _numberOfHugeTlb(0L);
+        static std::atomic<Nd4jLong> _allocatedBytes(0L);
+
+        // once hugetlb mmap fails, we don't try it again
+        static std::atomic<bool> _hugeTlbAvailable(true);
+
+        bool HugePages::isEligible(Nd4jLong numBytes) {
+#if defined(__linux__)
+            auto env = Environment::getInstance();
+            return env->isHugePages() && numBytes >= env->hugePagesThreshold();
+#else
+            return false;
+#endif
+        }
+
+        void* HugePages::allocate(Nd4jLong numBytes) {
+#if defined(__linux__)
+            if (numBytes < 1)
+                return nullptr;
+
+            auto length = (numBytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+            void *ptr = MAP_FAILED;
+            bool hugeTlb = false;
+
+#ifdef MAP_HUGETLB
+            if (_hugeTlbAvailable.load()) {
+                ptr = mmap(nullptr, (size_t) length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (ptr == MAP_FAILED) {
+                    nd4j_debug("hugetlb pages aren't available, switching to transparent huge pages\n", "");
+                    _hugeTlbAvailable.store(false);
+                } else
+                    hugeTlb = true;
+            }
+#endif
+
+            if (ptr == MAP_FAILED) {
+                // over-allocating, so region can be aligned to huge page boundary
+                auto raw = mmap(nullptr, (size_t) (length + HUGE_PAGE_SIZE), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (raw == MAP_FAILED)
+                    return nullptr;
+
+                auto address = reinterpret_cast<uintptr_t>(raw);
+                auto aligned = (address + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+                auto head = aligned - address;
+                auto tail = HUGE_PAGE_SIZE - head;
+
+                if (head > 0)
+                    munmap(raw, head);
+
+                if (tail > 0)
+                    munmap(reinterpret_cast<void *>(aligned + length), tail);
+
+                ptr = reinterpret_cast<void *>(aligned);
+
+#ifdef MADV_HUGEPAGE
+                // failure here just means regular pages
+                madvise(ptr, (size_t) length, MADV_HUGEPAGE);
+#endif
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _regions[ptr] = std::pair<Nd4jLong, bool>(length, hugeTlb);
+            }
+
+            _numberOfRegions++;
+            _allocatedBytes += length;
+            if (hugeTlb)
+                _numberOfHugeTlb++;
+
+            return ptr;
+#else
+            return nullptr;
+#endif
+        }
+
+        bool HugePages::release(void *ptr) {
+#if defined(__linux__)
+            if (ptr == nullptr || _numberOfRegions.load() == 0)
+                return false;
+
+            std::pair<Nd4jLong, bool> region;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _regions.find(ptr);
+                if (it == _regions.end())
+                    return false;
+
+                region = it->second;
+                _regions.erase(it);
+            }
+
+            munmap(ptr, (size_t) region.first);
+
+            _numberOfRegions--;
+            _allocatedBytes -= region.first;
+            if (region.second)
+                _numberOfHugeTlb--;
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        Nd4jLong HugePages::numberOfRegions() {
+            return _numberOfRegions.load();
+        }
+
+        Nd4jLong HugePages::numberOfHugeTlbRegions() {
+            return _numberOfHugeTlb.load();
+        }
+
+        Nd4jLong HugePages::allocatedBytes() {
+            return _allocatedBytes.load();
+        }
+    }
+}
@@ -59,3 +59,19 @@ Nd4jLong nd4j::memory::MemoryReport::getRSS() const {
 void nd4j::memory::MemoryReport::setRSS(Nd4jLong _rss) {
     MemoryReport::_rss = _rss;
 }
+
+Nd4jLong nd4j::memory::MemoryReport::getPlannedPeak() const {
+    return _plannedPeak;
+}
+
+void nd4j::memory::MemoryReport::setPlannedPeak(Nd4jLong bytes) {
+    _plannedPeak = bytes;
+}
+
+Nd4jLong nd4j::memory::MemoryReport::getPlannedTotal() const {
+    return _plannedTotal;
+}
+
+void nd4j::memory::MemoryReport::setPlannedTotal(Nd4jLong bytes) {
+    _plannedTotal = bytes;
+}
@@ -31,12 +31,14 @@
 #include <array/ShapeList.h>
 #include <array/ResultSet.h>
 #include <helpers/OpArgsHolder.h>
+#include <ops/declarable/OpShapeKey.h>
 #include <dll.h>
 //#include <ops/declarable/declarable_ops.h>
 
 #include <chrono>
 #include <ctime>
 #include <mutex>
+#include <map>
 
 using namespace nd4j::graph;
 
@@ -68,6 +70,15 @@ namespace nd4j {
             std::mutex _registrator;
             bool _registered = false;
 
+            // memoized output shapes, for shape functions that don't read input values
+            std::map<OpShapeKey, std::vector<Nd4jLong*>> _shapeCache;
+            std::mutex _shapeLock;
+
+            ShapeList* memoizedOutputShape(ShapeList &inputShapes, Context &block);
+
+            // DECLARE_TYPES is applied lazily, on first use
+            void ensureTypesRegistered();
+
         protected:
             OpDescriptor *_descriptor;
             NDArray *_scalar = nullptr;
@@ -133,11 +144,26 @@ namespace nd4j {
 
             Nd4jStatus validateDataTypes(Context& block);
 
+            /**
+             * This method returns TRUE if this Op consumes RNG state, so its outputs can't be precomputed
+             */
+            bool isRandom();
+
             /**
             *   This method should be available in each implemented Op, and should return Op output shape(s), for a given input shape(s)
             */
             virtual ShapeList* calculateOutputShape(ShapeList* inputShape, nd4j::graph::Context& block) = 0;
 
+            /**
+             * This method forgets output shapes memoized for this Op
+             */
+            void purgeShapeCache();
+
+            /**
+             * This method returns number of input shapes/arguments combinations memoized for this Op
+             */
+            Nd4jLong shapeCacheSize();
+
             /**
              * Returns opName
              *
@@ -80,6 +80,9 @@ namespace nd4j {
 
 
             bool _sameMode = false;
+
+            // ops that consume RNG state can't be folded or deduplicated
+            bool _random = false;
             std::vector<nd4j::DataType> _allowedIns;
             std::vector<nd4j::DataType> _allowedOuts;
 
@@ -165,6 +168,7 @@ namespace nd4j {
             OpDescriptor* setAllowedInputTypes(nd4j::DataType dtype);
             OpDescriptor* setAllowedOutputTypes(nd4j::DataType dtype);
             OpDescriptor* setSameMode(bool reallySame);
+            OpDescriptor* setRandom(bool reallyRandom);
             OpDescriptor* setInputType(int idx, nd4j::DataType dtype);
             OpDescriptor* setOutputType(int idx, nd4j::DataType dtype);
 
@@ -173,6 +177,7 @@ namespace nd4j {
             bool checkInputMatch(int index, nd4j::DataType dataType);
             bool checkOutputMatch(int index, nd4j::DataType dataType);
             bool isSameMode();
+            bool isRandom();
 
             bool isInherit(int index);
         };
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_OPSHAPEKEY_H
+#define LIBND4J_OPSHAPEKEY_H
+
+#include <vector>
+#include <dll.h>
+#include <pointercast.h>
+#include <array/ShapeDescriptor.h>
+#include <array/ShapeList.h>
+
+namespace nd4j {
+    namespace graph {
+        class Context;
+    }
+
+    namespace ops {
+        /**
+         * This class describes everything shape function of DeclarableOp can see without reading input values:
+         * input shapes and op arguments. It's used as key for memoized output shapes.
+         */
+        class ND4J_EXPORT OpShapeKey {
+        private:
+            std::vector<ShapeDescriptor> _inputs;
+            std::vector<int> _iArgs;
+            std::vector<double> _tArgs;
+            std::vector<bool> _bArgs;
+            std::vector<int> _axis;
+            nd4j::DataType _dataType;
+            int _opNum;
+            unsigned long _width;
+
+        public:
+            OpShapeKey(ShapeList &inputShapes, nd4j::graph::Context &block);
+            OpShapeKey(const OpShapeKey &other) = default;
+            ~OpShapeKey() = default;
+
+            OpShapeKey& operator=(const OpShapeKey &other) = default;
+
+            // returns false if key can't be ordered, i.e. NaN was passed as T argument
+            bool isOrdered() const;
+
+            bool operator==(const OpShapeKey &other) const;
+            bool operator<(const OpShapeKey &other) const;
+        };
+    }
+}
+
+#endif //LIBND4J_OPSHAPEKEY_H
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_matmul)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/biasActivation.h>
+#include <MmulHelper.h>
+
+namespace nd4j {
+    namespace ops {
+
+        CUSTOM_OP_IMPL(fused_matmul, 2, 1, false, 0, 4) {
+            auto x = INPUT_VARIABLE(0);
+            auto y = INPUT_VARIABLE(1);
+            auto bias = block.width() > 2 ? INPUT_VARIABLE(2) : nullptr;
+            auto z = OUTPUT_VARIABLE(0);
+
+            int transX = INT_ARG(0);
+            int transY = INT_ARG(1);
+            const int transZ = INT_ARG(2);
+            const int activation = INT_ARG(3);
+            const double alpha = block.numT() > 0 ? T_ARG(0) : 0.;
+
+            REQUIRE_TRUE(activation >= helpers::FUSED_NONE && activation <= helpers::FUSED_TANH, 0, "FUSED_MATMUL OP: unknown activation %i !", activation);
+            if (bias)
+                REQUIRE_TRUE(z->rankOf() > 0 && bias->lengthOf() == z->sizeAt(-1), 0, "FUSED_MATMUL OP: bias length must be equal to last output dimension %i, but got %i instead !", (int) z->sizeAt(-1), (int) bias->lengthOf());
+
+            if (transZ) {
+                x = INPUT_VARIABLE(1);
+                y = INPUT_VARIABLE(0);
+                bool temp = transX;
+                transX = !transY;
+                transY = !temp;
+            }
+
+            // matrices of the same type: bias and activation are applied by GEMM itself, while it stores z
+            if (x->rankOf() == 2 && y->rankOf() == 2 && z->rankOf() == 2 && x->dataType() == z->dataType() && y->dataType() == z->dataType()) {
+                helpers::matmulBiasActivation(block.launchContext(), x, y, z, transX, transY, bias, activation, alpha);
+                return Status::OK();
+            }
+
+            // batched and mixed-type products go through matmul, with separate epilogue pass
+            MmulHelper::matmul(x, y, z, transX, transY);
+
+            if (bias != nullptr || activation != helpers::FUSED_NONE)
+                helpers::biasActivation(*z, bias, activation, alpha);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(fused_matmul) {
+            // output shape doesn't depend on epilogue, so it's exactly the same as matmul one
+            nd4j::ops::matmul op;
+            return op.calculateOutputShape(inputShape, block);
+        }
+
+        DECLARE_TYPES(fused_matmul) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, {ALL_FLOATS})
+                    ->setAllowedInputTypes(2, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS});
+        }
+    }
+}
+
+#endif
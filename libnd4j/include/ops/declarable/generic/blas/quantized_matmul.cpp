@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantized_matmul)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+
+        CUSTOM_OP_IMPL(quantized_matmul, 4, 1, false, 0, 0) {
+            auto x = INPUT_VARIABLE(0);
+            auto w = INPUT_VARIABLE(1);
+            auto scales = INPUT_VARIABLE(2);
+            auto zeroPoints = INPUT_VARIABLE(3);
+            auto bias = block.width() > 4 ? INPUT_VARIABLE(4) : nullptr;
+            auto z = OUTPUT_VARIABLE(0);
+
+            const double outScale = block.numT() > 0 ? T_ARG(0) : 0.;
+            const int outZeroPoint = block.numT() > 1 ? static_cast<int>(T_ARG(1)) : 0;
+
+            REQUIRE_TRUE(x->rankOf() > 0, 0, "QUANTIZED_MATMUL OP: input must have rank bigger than 0 !");
+            REQUIRE_TRUE(w->rankOf() == 2 && w->dataType() == nd4j::DataType::INT8, 0, "QUANTIZED_MATMUL OP: weights must be INT8 matrix, but got %s array of rank %i instead !", DataTypeUtils::asString(w->dataType()).c_str(), w->rankOf());
+            REQUIRE_TRUE(x->sizeAt(-1) == w->sizeAt(0), 0, "QUANTIZED_MATMUL OP: input arrays have inconsistent shapes for matrix product: x %s, w %s !", ShapeUtils::shapeAsString(x).c_str(), ShapeUtils::shapeAsString(w).c_str());
+
+            const Nd4jLong K = w->sizeAt(0);
+            const Nd4jLong N = w->sizeAt(1);
+            const Nd4jLong M = x->lengthOf() / K;
+
+            REQUIRE_TRUE(scales->lengthOf() == N && zeroPoints->lengthOf() == N, 0, "QUANTIZED_MATMUL OP: scales and zero points must have length %i, but got %i and %i instead !", (int) N, (int) scales->lengthOf(), (int) zeroPoints->lengthOf());
+            if (bias)
+                REQUIRE_TRUE(bias->lengthOf() == N, 0, "QUANTIZED_MATMUL OP: bias length must be equal to %i, but got %i instead !", (int) N, (int) bias->lengthOf());
+
+            // leading dimensions of x are rows of single matrix product
+            auto x2 = x->reshape('c', {M, K});
+            auto z2 = z->reshape('c', {M, N});
+
+            helpers::quantizedMatmul(x2, *w, *scales, *zeroPoints, bias, z2, outScale, outZeroPoint);
+
+            if (z2.getBuffer() != z->getBuffer())
+                z->assign(z2.reshape('c', z->getShapeAsVector()));
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantized_matmul) {
+            auto xShapeInfo = inputShape->at(0);
+            auto wShapeInfo = inputShape->at(1);
+
+            REQUIRE_TRUE(shape::rank(xShapeInfo) > 0 && shape::rank(wShapeInfo) == 2, 0, "QUANTIZED_MATMUL OP: input must have rank bigger than 0, and weights must be matrix !");
+
+            std::vector<Nd4jLong> shape(shape::shapeOf(xShapeInfo), shape::shapeOf(xShapeInfo) + shape::rank(xShapeInfo));
+            shape.back() = shape::sizeAt(wShapeInfo, 1);
+
+            // requantized output is int8, otherwise it has type of x
+            const bool requantize = block.numT() > 0 && T_ARG(0) > 0.;
+            auto dtype = requantize ? nd4j::DataType::INT8 : ArrayOptions::dataType(xShapeInfo);
+
+            return SHAPELIST(ConstantShapeHelper::getInstance()->createShapeInfo(dtype, 'c', shape));
+        }
+
+        DECLARE_TYPES(quantized_matmul) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, nd4j::DataType::INT8)
+                    ->setAllowedInputTypes(2, {ALL_FLOATS})
+                    ->setAllowedInputTypes(3, {ALL_INTS})
+                    ->setAllowedInputTypes(4, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS, nd4j::DataType::INT8});
+        }
+    }
+}
+
+#endif
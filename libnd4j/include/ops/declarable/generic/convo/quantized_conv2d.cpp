@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantized_conv2d)
+
+#include <ops/declarable/CustomOperations.h>
+#include <declarable/helpers/convolutions.h>
+#include <declarable/helpers/im2col.h>
+#include <declarable/helpers/quantization.h>
+
+namespace nd4j {
+namespace ops  {
+
+
+CUSTOM_OP_IMPL(quantized_conv2d, 4, 1, false, 0, 9) {
+
+    auto input      = INPUT_VARIABLE(0);                                    // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    auto weights    = INPUT_VARIABLE(1);                                    // [kH, kW, iC, oC] always, INT8
+    auto scales     = INPUT_VARIABLE(2);                                    // [oC]
+    auto zeroPoints = INPUT_VARIABLE(3);                                    // [oC]
+    auto bias       = block.width() > 4 ? INPUT_VARIABLE(4) : nullptr;      // [oC]
+
+    auto output  = OUTPUT_VARIABLE(0);                                      // [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    int sH = INT_ARG(2);                                                        // strides height
+    int sW = INT_ARG(3);                                                        // strides width
+    int pH = INT_ARG(4);                                                        // paddings height
+    int pW = INT_ARG(5);                                                        // paddings width
+    int dH = INT_ARG(6);                                                        // dilations height
+    int dW = INT_ARG(7);                                                        // dilations width
+    int isSameMode = INT_ARG(8);                                                // 0-VALID, 1-SAME
+    bool isNCHW    = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;       // INT_ARG(9): 0-NCHW,  1-NHWC
+    double outScale = block.numT() > 0 ? T_ARG(0) : 0.;                         // requantization scale
+    int outZeroPoint = block.numT() > 1 ? static_cast<int>(T_ARG(1)) : 0;       // requantization zero point
+
+    int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(weights->sizeAt(0)); // filter(kernel) height
+    int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(weights->sizeAt(1)); // filter(kernel) width
+
+    REQUIRE_TRUE(weights->dataType() == nd4j::DataType::INT8, 0, "CUSTOM QUANTIZED_CONV2D OP: weights must be INT8, but got %s instead !", DataTypeUtils::asString(weights->dataType()).c_str());
+
+    int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    std::string expectedWeightsShape = ShapeUtils::shapeAsString({kH, kW, iC, oC});
+    REQUIRE_TRUE(expectedWeightsShape == ShapeUtils::shapeAsString(weights), 0, "CUSTOM QUANTIZED_CONV2D OP: wrong shape of weights array, expected is %s, but got %s instead !", expectedWeightsShape.c_str(), ShapeUtils::shapeAsString(weights).c_str());
+    REQUIRE_TRUE(scales->lengthOf() == oC && zeroPoints->lengthOf() == oC, 0, "CUSTOM QUANTIZED_CONV2D OP: scales and zero points must have length %i, but got %i and %i instead !", oC, scales->lengthOf(), zeroPoints->lengthOf());
+    if (bias)
+        REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "CUSTOM QUANTIZED_CONV2D OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
+
+    if(isSameMode)                       // SAME
+        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+    if(!isNCHW)
+        input = new NDArray(input->permute({0, 3, 1, 2}));                         // [bS, iH, iW, iC] -> [bS, iC, iH, iW] if NHWC
+
+    // the same columns as in conv2d: [bS, oH, oW, kH, kW, iC] rows match [kH, kW, iC, oC] weights flattened into [kH*kW*iC, oC] matrix
+    NDArray col('c', {bS, oH, oW, kH, kW, iC}, input->dataType(), input->getContext());
+    NDArray colP = col.permute({0, 5, 3, 4, 1, 2});            // {bS, iC, kH, kW, oH, oW}
+    NDArray mmulResult('c', {bS*oH*oW, oC}, output->dataType(), output->getContext());
+
+    helpers::im2col(*block.launchContext(), *input, colP, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getContext()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+
+    auto columns = col.reshape('c', {bS*oH*oW, kH*kW*iC});
+    auto w = weights->reshape('c', {kH*kW*iC, oC});
+
+    // padding is 0, and 0 is always quantized exactly, so it adds nothing to sums
+    helpers::quantizedMatmul(columns, w, *scales, *zeroPoints, bias, mmulResult, outScale, outZeroPoint);
+
+    mmulResult.reshapei({bS, oH, oW, oC});
+    if(isNCHW)
+        mmulResult.permutei({0, 3, 1, 2});                                           // [bS, oH, oW, oC] -> [bS, oC, oH, oW]
+
+    output->assign(mmulResult);
+
+    if(!isNCHW)
+        delete input;
+
+    return Status::OK();
+}
+
+
+DECLARE_SHAPE_FN(quantized_conv2d) {
+    // spatial output shape is the same as conv2d one, and weights come at the same position. scales array stands for bias there, it has the same length
+    nd4j::ops::conv2d op;
+    auto shapes = op.calculateOutputShape(inputShape, block);
+
+    // requantized output is int8, otherwise it has type of input
+    const bool requantize = block.numT() > 0 && T_ARG(0) > 0.;
+    auto dtype = requantize ? nd4j::DataType::INT8 : ArrayOptions::dataType(inputShape->at(0));
+    auto outputShapeInfo = ShapeBuilders::copyShapeInfoAndType(shapes->at(0), dtype, true, block.getWorkspace());
+
+    delete shapes;
+
+    return SHAPELIST(CONSTANT(outputShapeInfo));
+}
+
+    DECLARE_TYPES(quantized_conv2d) {
+        getOpDescriptor()
+                ->setAllowedInputTypes(0, {ALL_FLOATS})
+                ->setAllowedInputTypes(1, nd4j::DataType::INT8)
+                ->setAllowedInputTypes(2, {ALL_FLOATS})
+                ->setAllowedInputTypes(3, {ALL_INTS})
+                ->setAllowedInputTypes(4, {ALL_FLOATS})
+                ->setAllowedOutputTypes({ALL_FLOATS, nd4j::DataType::INT8});
+    }
+
+}
+}
+
+#endif
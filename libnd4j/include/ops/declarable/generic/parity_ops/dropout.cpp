@@ -57,7 +57,8 @@ CONFIGURABLE_OP_IMPL(dropout, 1, 1, true, 1, 1) {
                     ->setAllowedInputTypes(0, {ALL_FLOATS})
                     ->setAllowedInputTypes(1, {ALL_INTS})
                     ->setAllowedOutputTypes({ALL_FLOATS})
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setRandom(true);
         }
 
 //////////////////////////////////////////////////////////////////////////
@@ -88,7 +89,8 @@ CONFIGURABLE_OP_IMPL(dropout_bp, 2, 1, false, 1, 1) {
 DECLARE_TYPES(dropout_bp) {
     getOpDescriptor()
             ->setAllowedInputTypes({ALL_FLOATS, ALL_INTS})
-            ->setAllowedOutputTypes({ALL_FLOATS});
+            ->setAllowedOutputTypes({ALL_FLOATS})
+            ->setRandom(true);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -120,7 +122,8 @@ CONFIGURABLE_OP_IMPL(alpha_dropout_bp, 2, 1, false, 4, 1) {
         DECLARE_TYPES(alpha_dropout_bp) {
             getOpDescriptor()
                     ->setAllowedInputTypes({ALL_FLOATS})
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setRandom(true);
         }
 }
 }
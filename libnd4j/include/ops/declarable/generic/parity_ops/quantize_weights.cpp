@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantize_weights)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(quantize_weights, 1, 3, false, 0, 0) {
+            auto input = INPUT_VARIABLE(0);
+            auto output = OUTPUT_VARIABLE(0);
+            auto scales = OUTPUT_VARIABLE(1);
+            auto zeroPoints = OUTPUT_VARIABLE(2);
+
+            const bool symmetric = block.numI() > 0 ? INT_ARG(0) != 0 : true;
+
+            REQUIRE_TRUE(input->rankOf() > 0, 0, "quantize_weights: input should have rank bigger than 0");
+
+            helpers::quantizeWeights(*input, *output, *scales, *zeroPoints, symmetric);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantize_weights) {
+            auto inShape = inputShape->at(0);
+            std::vector<Nd4jLong> channels = {shape::sizeAt(inShape, -1)};
+
+            auto outputShape = ShapeBuilders::copyShapeInfoAndType(inShape, nd4j::DataType::INT8, false, block.getWorkspace());
+            auto scalesShape = ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::FLOAT32, 'c', channels);
+            auto zeroPointsShape = ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::INT32, 'c', channels);
+
+            return SHAPELIST(CONSTANT(outputShape), scalesShape, zeroPointsShape);
+        }
+
+        DECLARE_TYPES(quantize_weights) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, nd4j::DataType::INT8)
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(2, {ALL_INTS});
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_quantized_xw_plus_b)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(quantized_xw_plus_b, 5, 1, false, 0, 0) {
+            auto x = INPUT_VARIABLE(0);
+            auto w = INPUT_VARIABLE(1);
+            auto b = INPUT_VARIABLE(2);
+            auto scales = INPUT_VARIABLE(3);
+            auto zeroPoints = INPUT_VARIABLE(4);
+            auto z = OUTPUT_VARIABLE(0);
+
+            const double outScale = block.numT() > 0 ? T_ARG(0) : 0.;
+            const int outZeroPoint = block.numT() > 1 ? static_cast<int>(T_ARG(1)) : 0;
+
+            REQUIRE_TRUE(x->rankOf() == 2 && w->rankOf() == 2 && z->rankOf() == 2, 0, "quantized_xw_plus_b: Input and Output NDArrays should have rank 2");
+            REQUIRE_TRUE(w->dataType() == nd4j::DataType::INT8, 0, "quantized_xw_plus_b: weights should be INT8, but got %s", DataTypeUtils::asString(w->dataType()).c_str());
+            REQUIRE_TRUE(x->sizeAt(1) == w->sizeAt(0), 0, "quantized_xw_plus_b: inconsistent shapes for matrix product: x %s, w %s", ShapeUtils::shapeAsString(x).c_str(), ShapeUtils::shapeAsString(w).c_str());
+            REQUIRE_TRUE(b->isVector() && b->lengthOf() == z->sizeAt(-1), 0, "quantized_xw_plus_b: Input vector should have proper dimension 1x%i. "
+                "But %i != %i.", z->sizeAt(-1), b->lengthOf(), z->sizeAt(-1));
+            REQUIRE_TRUE(scales->lengthOf() == z->sizeAt(-1) && zeroPoints->lengthOf() == z->sizeAt(-1), 0, "quantized_xw_plus_b: scales and zero points should have length %i", z->sizeAt(-1));
+
+            // bias is added in the same epilogue that dequantizes products
+            helpers::quantizedMatmul(*x, *w, *scales, *zeroPoints, b, *z, outScale, outZeroPoint);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(quantized_xw_plus_b) {
+            const bool requantize = block.numT() > 0 && T_ARG(0) > 0.;
+            auto dtype = requantize ? nd4j::DataType::INT8 : ArrayOptions::dataType(inputShape->at(0));
+
+            auto outputShape = ShapeUtils::matrixProductShape(inputShape->at(0), inputShape->at(1), false, false, dtype, block.getWorkspace());
+
+            return SHAPELIST(CONSTANT(outputShape));
+        }
+
+        DECLARE_TYPES(quantized_xw_plus_b) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, nd4j::DataType::INT8)
+                    ->setAllowedInputTypes(2, {ALL_FLOATS})
+                    ->setAllowedInputTypes(3, {ALL_FLOATS})
+                    ->setAllowedInputTypes(4, {ALL_INTS})
+                    ->setAllowedOutputTypes({ALL_FLOATS, nd4j::DataType::INT8});
+        }
+    }
+}
+
+#endif
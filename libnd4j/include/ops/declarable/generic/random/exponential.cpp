@@ -70,7 +70,8 @@ namespace nd4j {
         DECLARE_TYPES(random_exponential) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setRandom(true);
         }
     }
 }
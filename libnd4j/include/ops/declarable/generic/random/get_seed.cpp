@@ -43,7 +43,8 @@ namespace nd4j {
         DECLARE_TYPES(get_seed) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes(DataType::INT64);
+                    ->setAllowedOutputTypes(DataType::INT64)
+                    ->setRandom(true);
         }
     }
 }
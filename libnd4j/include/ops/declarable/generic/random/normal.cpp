@@ -57,7 +57,8 @@ namespace nd4j {
         DECLARE_TYPES(random_normal) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setRandom(true);
         }
     }
 }
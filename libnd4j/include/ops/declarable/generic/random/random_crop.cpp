@@ -66,7 +66,8 @@ DECLARE_SHAPE_FN(random_crop) {
         DECLARE_TYPES(random_crop) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setRandom(true);
         }
 }
 }
\ No newline at end of file
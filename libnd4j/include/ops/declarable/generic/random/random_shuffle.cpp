@@ -46,7 +46,8 @@ OP_IMPL(random_shuffle, 1, 1, true) {
     DECLARE_TYPES(random_shuffle) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
-                ->setSameMode(true);
+                ->setSameMode(true)
+                ->setRandom(true);
     }
 }
 }
@@ -55,7 +55,8 @@ namespace nd4j {
         DECLARE_TYPES(set_seed) {
             getOpDescriptor()
                     ->setAllowedInputTypes({ALL_INTS})
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setRandom(true);
         }
     }
 }
@@ -46,6 +46,44 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(matmul_bp, 3, 2, false, 0, -2);
         #endif
 
+        /**
+         * matmul with bias and activation applied in GEMM epilogue, i.e. matmul -> biasadd -> relu in single op.
+         * For matrices output is written once, with bias and activation applied while GEMM stores it; batched inputs
+         * get separate epilogue pass. Graph optimizer uses it instead of separate nodes.
+         * Expected input:
+         * x, y: the same as matmul
+         * bias: optional vector, length of last output dimension
+         *
+         * Integer arguments:
+         * 0 - 2: transX, transY, transZ, the same as matmul
+         * 3: activation: 0 none, 1 relu, 2 relu6, 3 sigmoid, 4 tanh
+         *
+         * Optional T arguments:
+         * 0: relu/relu6 cutoff
+         */
+        #if NOT_EXCLUDED(OP_fused_matmul)
+        DECLARE_CUSTOM_OP(fused_matmul, 2, 1, false, 0, 4);
+        #endif
+
+        /**
+         * matmul over int8 weights with per-output-channel scales and zero points, i.e. weights column n stands for
+         * scales[n] * (w[k, n] - zeroPoints[n]). x is quantized into uint8 on the fly, products are summed in int32,
+         * and scales, zero points and bias are applied in epilogue.
+         * Expected input:
+         * x: [..., K] floating point array, all leading dimensions are treated as rows
+         * w: [K, N] INT8 weights, i.e. produced by quantize_weights op
+         * scales: [N] weights scales
+         * zeroPoints: [N] weights zero points
+         * bias: optional [N] vector
+         *
+         * Optional T arguments:
+         * 0: output scale. If it's given, output is INT8 array holding result / outScale + outZeroPoint
+         * 1: output zero point, 0 by default
+         */
+        #if NOT_EXCLUDED(OP_quantized_matmul)
+        DECLARE_CUSTOM_OP(quantized_matmul, 4, 1, false, 0, 0);
+        #endif
+
         /**
          * tensorMmul/tensorDot operation
          * takes 2 ndarrays, and 2 sets of axes
@@ -68,6 +68,46 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(conv2d_input_bp, 3, 1, false, 0, 9);
         #endif
 
+        /**
+         * 2D convolution with bias and activation applied in GEMM epilogue, i.e. conv2d -> biasadd -> relu in single op.
+         * Graph optimizer uses it instead of separate nodes.
+         * Expected input:
+         * x: 4D array
+         * weight: 4D Array
+         * bias: optional vector, length of outputChannels
+         *
+         * IntArgs:
+         * 0 - 9: the same as conv2d
+         * 10: activation: 0 none, 1 relu, 2 relu6, 3 sigmoid, 4 tanh
+         *
+         * Optional T arguments:
+         * 0: relu/relu6 cutoff
+         */
+        #if NOT_EXCLUDED(OP_fused_conv2d)
+        DECLARE_CUSTOM_OP(fused_conv2d, 2, 1, false, 0, 11);
+        #endif
+
+        /**
+         * 2D convolution over int8 weights with per-output-channel scales and zero points, see quantized_matmul.
+         * Input is quantized into uint8 on the fly, and convolution is computed as int8 GEMM over im2col columns.
+         * Expected input:
+         * x: 4D floating point array
+         * weight: 4D INT8 array [kH, kW, iC, oC], i.e. produced by quantize_weights op
+         * scales: vector of weights scales, length of outputChannels
+         * zeroPoints: vector of weights zero points, length of outputChannels
+         * bias: optional vector, length of outputChannels
+         *
+         * IntArgs:
+         * 0 - 9: the same as conv2d
+         *
+         * Optional T arguments:
+         * 0: output scale. If it's given, output is requantized into INT8
+         * 1: output zero point
+         */
+        #if NOT_EXCLUDED(OP_quantized_conv2d)
+        DECLARE_CUSTOM_OP(quantized_conv2d, 4, 1, false, 0, 9);
+        #endif
+
         /**
          * Depthwise convolution2d op:
          * Expected inputs:
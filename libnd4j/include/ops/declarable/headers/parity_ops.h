@@ -728,6 +728,27 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(xw_plus_b, 3, 1, false, 0, 0);
         #endif
 
+        /**
+         * quantized_xw_plus_b op.
+         * xw_plus_b over int8 weights with per-output-channel scales and zero points, see quantized_matmul
+         *
+         * input params:
+         *   - 2D matrix MxK, floating point
+         *   - 2D INT8 matrix KxN
+         *   - 1D vector with N elements, bias
+         *   - 1D vector with N elements, weights scales
+         *   - 1D vector with N elements, weights zero points
+         *
+         * T params (optional):
+         *   0 - output scale. If it's given, output is requantized into INT8
+         *   1 - output zero point
+         *
+         * output value - 2D matrix MxN
+         */
+        #if NOT_EXCLUDED(OP_quantized_xw_plus_b)
+        DECLARE_CUSTOM_OP(quantized_xw_plus_b, 5, 1, false, 0, 0);
+        #endif
+
         /**
          * This operation is missed due it simplicy.
          * Input and output params are the same after operation.
@@ -1634,6 +1655,24 @@ namespace nd4j {
         DECLARE_CONFIGURABLE_OP(fake_quant_with_min_max_vars, 3, 1, true, 0, -2);
         #endif
 
+        /**
+         * quantize_weights - calibrates and quantizes weights for quantized ops, per channel along last dimension
+         *
+         * input params:
+         *    0 - NDArray (weights), i.e. [K, N] for quantized_matmul or [kH, kW, iC, oC] for quantized_conv2d
+         *
+         * int params (optional):
+         *    0 - symmetric, zero points are 0 (default True)
+         *
+         * output:
+         *    0 - INT8 NDArray with the same shape as input
+         *    1 - FLOAT32 vector of scales, one per channel
+         *    2 - INT32 vector of zero points, one per channel
+         */
+        #if NOT_EXCLUDED(OP_quantize_weights)
+        DECLARE_CUSTOM_OP(quantize_weights, 1, 3, false, 0, 0);
+        #endif
+
     }
 }
 
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_BIASACTIVATION_H
+#define LIBND4J_BIASACTIVATION_H
+
+#include <ops/declarable/helpers/helpers.h>
+#include <templatemath.h>
+
+namespace nd4j    {
+namespace ops     {
+namespace helpers {
+
+    // activations available in epilogue of fused ops, passed to them as integer argument
+    enum FusedActivation {
+        FUSED_NONE = 0,
+        FUSED_RELU = 1,         // max(x, alpha)
+        FUSED_RELU6 = 2,        // min(max(x, alpha), 6)
+        FUSED_SIGMOID = 3,
+        FUSED_TANH = 4,
+    };
+
+    template <typename X, int A>
+    _CUDA_HD FORCEINLINE X fusedActivation(const X value, const X alpha) {
+        if (A == FUSED_RELU)
+            return value < alpha ? alpha : value;
+        else if (A == FUSED_RELU6)
+            return nd4j::math::nd4j_min<X>(value < alpha ? alpha : value, static_cast<X>(6));
+        else if (A == FUSED_SIGMOID)
+            return nd4j::math::nd4j_sigmoid<X, X>(value);
+        else if (A == FUSED_TANH)
+            return nd4j::math::nd4j_tanh<X, X>(value);
+        else
+            return value;
+    }
+
+    /**
+     * GEMM epilogue: adds bias[column] (if bias isn't nullptr) and applies activation to each element of C while it's stored
+     */
+    template <typename X, int A>
+    struct BiasActivationEpilogue {
+        const X *bias;
+        X alpha;
+
+        _CUDA_HD FORCEINLINE X operator()(const X value, const int column) const {
+            return fusedActivation<X, A>(bias != nullptr ? value + bias[column] : value, alpha);
+        }
+    };
+
+    /**
+     * This method adds bias along the last dimension of input (if bias isn't nullptr) and applies activation, in place and in one pass over input
+     */
+	void biasActivation(NDArray& input, const NDArray* bias, const int activation, const double alpha);
+
+    /**
+     * This method computes z = activation(op(x) x op(y) + bias) for matrices, with bias and activation applied by GEMM while it stores z,
+     * so z is written exactly once. x, y and z must have the same data type
+     */
+    void matmulBiasActivation(nd4j::LaunchContext* context, const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha);
+
+}
+}
+}
+
+
+#endif // LIBND4J_BIASACTIVATION_H
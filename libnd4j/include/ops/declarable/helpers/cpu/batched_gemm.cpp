@@ -22,6 +22,7 @@
 #include <types/float16.h>
 #include <ops/declarable/helpers/batched_gemm.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/BlockedGemm.h>
 
 
 namespace nd4j    {
@@ -90,26 +91,22 @@ void bgemm_(const std::vector<NDArray*>& vA, const std::vector<NDArray*>& vB, st
         CBLAS_TRANSPOSE tA = (CBLAS_TRANSPOSE) transA;
         CBLAS_TRANSPOSE tB = (CBLAS_TRANSPOSE) transB;
 
-        int vaSize = vA.size();
+        // matrices are in f order, transposed ones are in c order
+        const Nd4jLong aRowStride = tA == CblasNoTrans ? 1 : lda;
+        const Nd4jLong aColStride = tA == CblasNoTrans ? lda : 1;
+        const Nd4jLong bRowStride = tB == CblasNoTrans ? 1 : ldb;
+        const Nd4jLong bColStride = tB == CblasNoTrans ? ldb : 1;
 
-        PRAGMA_OMP_PARALLEL_FOR
-        for (int p = 0; p < vaSize; ++p) {
+        // large batches are split between threads, small ones use all threads within each gemm
+        const bool parallelBatch = batchSize >= omp_get_max_threads();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelBatch) schedule(guided))
+        for (int p = 0; p < batchSize; ++p) {
             auto A = reinterpret_cast<T*>(vA.at(p)->buffer());
             auto B = reinterpret_cast<T*>(vB.at(p)->buffer());
             auto C = reinterpret_cast<T*>(vC.at(p)->buffer());
-            auto alpha = alphas->e<T>(p);
-            auto beta = betas->e<T>(p);
-            for (int m = 0; m < M; ++m) {
-                for (int n = 0; n < N; ++n) {
-                    T c_mnp = 0;
-
-                    PRAGMA_OMP_SIMD
-                    for (int k = 0; k < K; ++k)
-                        c_mnp += A[tA == CblasNoTrans ? (m + k * lda) : (m * lda + k)] * B[tB == CblasNoTrans ? (k + n * ldb) : (k * ldb + n)];
-
-                    C[m + n * ldc] = alpha * c_mnp + beta * C[m + n * ldc];
-                }
-            }
+
+            BlockedGemm<T,T,T>::gemm(M, N, K, alphas->e<double>(p), A, aRowStride, aColStride, B, bRowStride, bColStride, betas->e<double>(p), C, 1, ldc, !parallelBatch);
         }
     }
 }
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/biasActivation.h>
+#include <helpers/BlockedGemm.h>
+#include <stdexcept>
+#include <vector>
+
+namespace nd4j 	  {
+namespace ops 	  {
+namespace helpers {
+
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, int A>
+static void epilogue_(NDArray& input, const std::vector<X>& bias, const X alpha) {
+
+    auto buffer = input.bufferAsT<X>();
+    const Nd4jLong length = input.lengthOf();
+
+    if (bias.empty()) {
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = fusedActivation<X, A>(buffer[e], alpha);
+
+        return;
+    }
+
+    const Nd4jLong columns = static_cast<Nd4jLong>(bias.size());
+    const Nd4jLong rows = length / columns;
+    const X* b = bias.data();
+
+    if (input.ordering() == 'c') {
+        // [rows, columns] c-ordered: each row gets whole bias vector
+        PRAGMA_OMP_PARALLEL_FOR
+        for (Nd4jLong r = 0; r < rows; r++) {
+            auto row = buffer + r * columns;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong c = 0; c < columns; c++)
+                row[c] = fusedActivation<X, A>(row[c] + b[c], alpha);
+        }
+    }
+    else {
+        // [rows, columns] f-ordered, i.e. each column is contiguous, that's what GEMM gives us
+        PRAGMA_OMP_PARALLEL_FOR
+        for (Nd4jLong c = 0; c < columns; c++) {
+            auto column = buffer + c * rows;
+            const X bc = b[c];
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong r = 0; r < rows; r++)
+                column[r] = fusedActivation<X, A>(column[r] + bc, alpha);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void biasActivation_(NDArray& input, const NDArray* bias, const int activation, const double alpha) {
+
+    // bias is tiny, so it's cast to input type once, regardless of its type and layout
+    std::vector<X> b;
+    if (bias != nullptr) {
+        b.resize(bias->lengthOf());
+        for (Nd4jLong e = 0; e < bias->lengthOf(); e++)
+            b[e] = bias->e<X>(e);
+    }
+
+    auto a = static_cast<X>(alpha);
+
+    switch (activation) {
+        case FUSED_NONE:
+            epilogue_<X, FUSED_NONE>(input, b, a);
+            break;
+        case FUSED_RELU:
+            epilogue_<X, FUSED_RELU>(input, b, a);
+            break;
+        case FUSED_RELU6:
+            epilogue_<X, FUSED_RELU6>(input, b, a);
+            break;
+        case FUSED_SIGMOID:
+            epilogue_<X, FUSED_SIGMOID>(input, b, a);
+            break;
+        case FUSED_TANH:
+            epilogue_<X, FUSED_TANH>(input, b, a);
+            break;
+        default:
+            throw std::runtime_error("biasActivation: unknown activation");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void biasActivation(NDArray& input, const NDArray* bias, const int activation, const double alpha) {
+
+    if (bias != nullptr && (input.rankOf() < 1 || input.sizeAt(-1) != bias->lengthOf()))
+        throw std::runtime_error("biasActivation: bias length must be equal to last dimension of input");
+
+    // one pass is possible over dense buffer only: any layout w/o bias, c-order or f-ordered matrix with bias
+    bool dense = input.ews() == 1 && !input.isView();
+    if (dense && (bias == nullptr || input.ordering() == 'c' || input.rankOf() == 2)) {
+        BUILD_SINGLE_SELECTOR(input.dataType(), biasActivation_, (input, bias, activation, alpha), FLOAT_TYPES);
+        return;
+    }
+
+    if (bias != nullptr)
+        input.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Add(), bias, &input);
+
+    switch (activation) {
+        case FUSED_NONE:
+            break;
+        case FUSED_RELU:
+            input.applyScalar(nd4j::scalar::RELU, alpha, &input);
+            break;
+        case FUSED_RELU6:
+            input.applyScalar(nd4j::scalar::RELU6, alpha, &input);
+            break;
+        case FUSED_SIGMOID:
+            input.applyTransform(nd4j::transform::Sigmoid, &input);
+            break;
+        case FUSED_TANH:
+            input.applyTransform(nd4j::transform::Tanh, &input);
+            break;
+        default:
+            throw std::runtime_error("biasActivation: unknown activation");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, int A>
+static void matmulBiasActivation_(const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const std::vector<typename GemmAccumulator<X>::type>& bias, const double alpha) {
+
+    typedef typename GemmAccumulator<X>::type Acc;
+
+    const int M = z->sizeAt(0);
+    const int N = z->sizeAt(1);
+    const int K = transX ? x->sizeAt(0) : x->sizeAt(1);
+
+    // matrices are addressed via strides, so transposition is just a swap of strides
+    const Nd4jLong aRowStride = x->stridesOf()[transX ? 1 : 0];
+    const Nd4jLong aColStride = x->stridesOf()[transX ? 0 : 1];
+    const Nd4jLong bRowStride = y->stridesOf()[transY ? 1 : 0];
+    const Nd4jLong bColStride = y->stridesOf()[transY ? 0 : 1];
+
+    BiasActivationEpilogue<Acc, A> epilogue;
+    epilogue.bias = bias.empty() ? nullptr : bias.data();
+    epilogue.alpha = static_cast<Acc>(alpha);
+
+    BlockedGemm<X, X, X>::gemm(M, N, K, 1.0,
+                               x->bufferAsT<X>(), aRowStride, aColStride,
+                               y->bufferAsT<X>(), bRowStride, bColStride,
+                               0.0,
+                               z->bufferAsT<X>(), z->stridesOf()[0], z->stridesOf()[1],
+                               true, epilogue);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void matmulBiasActivationSelector_(const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha) {
+
+    // bias is added in accumulation type, before rounding
+    std::vector<typename GemmAccumulator<X>::type> b;
+    if (bias != nullptr) {
+        b.resize(bias->lengthOf());
+        for (Nd4jLong e = 0; e < bias->lengthOf(); e++)
+            b[e] = bias->e<typename GemmAccumulator<X>::type>(e);
+    }
+
+    switch (activation) {
+        case FUSED_NONE:
+            matmulBiasActivation_<X, FUSED_NONE>(x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_RELU:
+            matmulBiasActivation_<X, FUSED_RELU>(x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_RELU6:
+            matmulBiasActivation_<X, FUSED_RELU6>(x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_SIGMOID:
+            matmulBiasActivation_<X, FUSED_SIGMOID>(x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_TANH:
+            matmulBiasActivation_<X, FUSED_TANH>(x, y, z, transX, transY, b, alpha);
+            break;
+        default:
+            throw std::runtime_error("matmulBiasActivation: unknown activation");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void matmulBiasActivation(nd4j::LaunchContext* context, const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha) {
+
+    if (x->rankOf() != 2 || y->rankOf() != 2 || z->rankOf() != 2)
+        throw std::runtime_error("matmulBiasActivation: all arrays must be matrices");
+
+    if (x->dataType() != z->dataType() || y->dataType() != z->dataType())
+        throw std::runtime_error("matmulBiasActivation: x, y and z must have the same data type");
+
+    if (bias != nullptr && bias->lengthOf() != z->sizeAt(1))
+        throw std::runtime_error("matmulBiasActivation: bias length must be equal to number of columns of z");
+
+    BUILD_SINGLE_SELECTOR(z->dataType(), matmulBiasActivationSelector_, (x, y, z, transX, transY, bias, activation, alpha), FLOAT_TYPES);
+}
+
+
+BUILD_SINGLE_TEMPLATE(template void matmulBiasActivationSelector_, (const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void biasActivation_, (NDArray& input, const NDArray* bias, const int activation, const double alpha), FLOAT_TYPES);
+
+}
+}
+}
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/quantization.h>
+#include <helpers/QuantizedGemm.h>
+#include <helpers/QuantizationCalibrator.h>
+#include <memory/CachingHostAllocator.h>
+#include <templatemath.h>
+#include <stdexcept>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace nd4j 	  {
+namespace ops 	  {
+namespace helpers {
+
+
+//////////////////////////////////////////////////////////////////////////
+static FORCEINLINE int quantize(const float value, const float invScale, const int zeroPoint, const int qMin, const int qMax) {
+    const int q = static_cast<int>(std::nearbyint(value * invScale)) + zeroPoint;
+    return q < qMin ? qMin : (q > qMax ? qMax : q);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// x [M, K] -> uint8 [M, K] c-ordered, rowSums get sum of quantized values of each row
+template <typename X>
+static void quantizeActivations_(const NDArray& x, uint8_t *q, int32_t *rowSums, float& scale, int& zeroPoint) {
+
+    const Nd4jLong M = x.sizeAt(0);
+    const Nd4jLong K = x.sizeAt(1);
+    const Nd4jLong rowStride = x.stridesOf()[0];
+    const Nd4jLong colStride = x.stridesOf()[1];
+    auto buffer = x.bufferAsT<X>();
+
+    double lo = 0., hi = 0.;
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(reduction(min:lo) reduction(max:hi))
+    for (Nd4jLong m = 0; m < M; m++) {
+        auto row = buffer + m * rowStride;
+        for (Nd4jLong k = 0; k < K; k++) {
+            const double v = static_cast<double>(row[k * colStride]);
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+        }
+    }
+
+    double s;
+    QuantizationCalibrator::paramsOf(lo, hi, 0, 255, s, zeroPoint);
+    scale = static_cast<float>(s);
+
+    const float invScale = 1.f / scale;
+    const int zp = zeroPoint;
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(M > 1)
+    for (Nd4jLong m = 0; m < M; m++) {
+        auto row = buffer + m * rowStride;
+        auto qRow = q + m * K;
+        int32_t sum = 0;
+
+        for (Nd4jLong k = 0; k < K; k++) {
+            const int v = quantize(static_cast<float>(row[k * colStride]), invScale, zp, 0, 255);
+            qRow[k] = static_cast<uint8_t>(v);
+            sum += v;
+        }
+
+        rowSums[m] = sum;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// result[m, n] = multipliers[n] * (C[m, n] - zeroPoints[n] * rowSums[m] + colTerms[n]) + bias[n]
+template <typename Z>
+static void epilogue_(const int32_t *C, const int32_t *rowSums, const std::vector<Nd4jLong>& colTerms, const std::vector<int>& zeroPoints, const std::vector<float>& multipliers, const std::vector<float>& bias, NDArray& z, const double outScale, const int outZeroPoint) {
+
+    const Nd4jLong M = z.sizeAt(0);
+    const Nd4jLong N = z.sizeAt(1);
+    const Nd4jLong rowStride = z.stridesOf()[0];
+    const Nd4jLong colStride = z.stridesOf()[1];
+    auto buffer = z.bufferAsT<Z>();
+
+    // int8 output without scale given still has to be rounded and saturated, so it's requantized with unit scale
+    const bool requantize = outScale > 0. || std::is_same<Z, int8_t>::value;
+    const float invOutScale = outScale > 0. ? static_cast<float>(1. / outScale) : 1.f;
+    const bool hasBias = !bias.empty();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(M > 1)
+    for (Nd4jLong m = 0; m < M; m++) {
+        auto c = C + m * N;
+        auto row = buffer + m * rowStride;
+        const Nd4jLong rowSum = rowSums[m];
+
+        for (Nd4jLong n = 0; n < N; n++) {
+            const Nd4jLong acc = c[n] - zeroPoints[n] * rowSum + colTerms[n];
+            float value = multipliers[n] * static_cast<float>(acc);
+            if (hasBias)
+                value += bias[n];
+
+            if (requantize)
+                row[n * colStride] = static_cast<Z>(quantize(value, invOutScale, outZeroPoint, -128, 127));
+            else
+                row[n * colStride] = static_cast<Z>(value);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void quantizedMatmul(const NDArray& x, const NDArray& w, const NDArray& scales, const NDArray& zeroPoints, const NDArray* bias, NDArray& z, const double outScale, const int outZeroPoint) {
+
+    if (x.rankOf() != 2 || w.rankOf() != 2 || z.rankOf() != 2 || x.sizeAt(1) != w.sizeAt(0) || z.sizeAt(0) != x.sizeAt(0) || z.sizeAt(1) != w.sizeAt(1))
+        throw std::runtime_error("quantizedMatmul: x [M, K], w [K, N] and z [M, N] matrices are expected");
+
+    if (w.dataType() != nd4j::DataType::INT8)
+        throw std::runtime_error("quantizedMatmul: weights must be INT8");
+
+    if (outScale > 0. && z.dataType() != nd4j::DataType::INT8)
+        throw std::runtime_error("quantizedMatmul: requantized output must be INT8");
+
+    const Nd4jLong M = x.sizeAt(0);
+    const Nd4jLong K = x.sizeAt(1);
+    const Nd4jLong N = w.sizeAt(1);
+
+    if (scales.lengthOf() != N || zeroPoints.lengthOf() != N || (bias != nullptr && bias->lengthOf() != N))
+        throw std::runtime_error("quantizedMatmul: scales, zero points and bias must have one value per output column");
+
+    auto allocator = memory::CachingHostAllocator::getInstance();
+    auto qx = reinterpret_cast<uint8_t*>(allocator->allocate(M * K));
+    auto rowSums = reinterpret_cast<int32_t*>(allocator->allocate(M * sizeof(int32_t)));
+    auto C = reinterpret_cast<int32_t*>(allocator->allocate(M * N * sizeof(int32_t)));
+
+    float xScale;
+    int xZeroPoint;
+    BUILD_SINGLE_SELECTOR(x.dataType(), quantizeActivations_, (x, qx, rowSums, xScale, xZeroPoint), FLOAT_TYPES);
+
+    auto wBuffer = w.bufferAsT<int8_t>();
+    const Nd4jLong wRowStride = w.stridesOf()[0];
+    const Nd4jLong wColStride = w.stridesOf()[1];
+
+    QuantizedGemm::gemm(M, N, K, qx, K, 1, wBuffer, wRowStride, wColStride, C, N, 1);
+
+    // per-column parameters are tiny, so they're gathered once, regardless of their types and layouts
+    std::vector<int> wZeroPoints(N);
+    std::vector<float> multipliers(N);
+    std::vector<float> b(bias != nullptr ? N : 0);
+    std::vector<Nd4jLong> colTerms(N, 0);
+
+    for (Nd4jLong n = 0; n < N; n++) {
+        wZeroPoints[n] = zeroPoints.e<int>(n);
+        multipliers[n] = xScale * scales.e<float>(n);
+        if (bias != nullptr)
+            b[n] = bias->e<float>(n);
+    }
+
+    for (Nd4jLong k = 0; k < K; k++)
+        for (Nd4jLong n = 0; n < N; n++)
+            colTerms[n] -= wBuffer[k * wRowStride + n * wColStride];
+
+    for (Nd4jLong n = 0; n < N; n++)
+        colTerms[n] = xZeroPoint * (colTerms[n] + K * wZeroPoints[n]);
+
+    if (z.dataType() == nd4j::DataType::INT8)
+        epilogue_<int8_t>(C, rowSums, colTerms, wZeroPoints, multipliers, b, z, outScale, outZeroPoint);
+    else
+        BUILD_SINGLE_SELECTOR(z.dataType(), epilogue_, (C, rowSums, colTerms, wZeroPoints, multipliers, b, z, outScale, outZeroPoint), FLOAT_TYPES);
+
+    allocator->release(C);
+    allocator->release(rowSums);
+    allocator->release(qx);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void quantizeWeights_(const NDArray& input, NDArray& output, NDArray& scales, NDArray& zeroPoints, const bool symmetric) {
+
+    const Nd4jLong N = input.sizeAt(-1);
+    const Nd4jLong rows = input.lengthOf() / N;
+    auto in = input.bufferAsT<X>();
+    auto out = output.bufferAsT<int8_t>();
+
+    std::vector<double> lo(N, 0.), hi(N, 0.);
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong n = 0; n < N; n++) {
+            const double v = static_cast<double>(in[r * N + n]);
+            lo[n] = v < lo[n] ? v : lo[n];
+            hi[n] = v > hi[n] ? v : hi[n];
+        }
+
+    std::vector<float> invScales(N);
+    std::vector<int> zps(N);
+
+    for (Nd4jLong n = 0; n < N; n++) {
+        double scale;
+        if (symmetric)
+            QuantizationCalibrator::symmetricParamsOf(nd4j::math::nd4j_max<double>(-lo[n], hi[n]), 127, scale, zps[n]);
+        else
+            QuantizationCalibrator::paramsOf(lo[n], hi[n], -128, 127, scale, zps[n]);
+
+        invScales[n] = static_cast<float>(1. / scale);
+        scales.p(n, scale);
+        zeroPoints.p(n, zps[n]);
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(rows > 1)
+    for (Nd4jLong r = 0; r < rows; r++)
+        for (Nd4jLong n = 0; n < N; n++)
+            out[r * N + n] = static_cast<int8_t>(quantize(static_cast<float>(in[r * N + n]), invScales[n], zps[n], -128, 127));
+}
+
+//////////////////////////////////////////////////////////////////////////
+void quantizeWeights(const NDArray& input, NDArray& output, NDArray& scales, NDArray& zeroPoints, const bool symmetric) {
+
+    if (input.rankOf() < 1 || output.dataType() != nd4j::DataType::INT8 || !output.isSameShape(&input))
+        throw std::runtime_error("quantizeWeights: output must be INT8 array of input shape");
+
+    if (scales.lengthOf() != input.sizeAt(-1) || zeroPoints.lengthOf() != input.sizeAt(-1))
+        throw std::runtime_error("quantizeWeights: scales and zero points must have one value per channel");
+
+    // channels are along last dimension, so both arrays are processed as dense c-ordered [rows, channels] matrices
+    const bool dense = input.ordering() == 'c' && input.ews() == 1 && !input.isView();
+    const bool denseOutput = output.ordering() == 'c' && output.ews() == 1 && !output.isView();
+
+    auto in = dense ? const_cast<NDArray*>(&input) : input.dup('c');
+    auto out = denseOutput ? &output : output.dup('c');
+
+    BUILD_SINGLE_SELECTOR(input.dataType(), quantizeWeights_, (*in, *out, scales, zeroPoints, symmetric), FLOAT_TYPES);
+
+    if (!denseOutput) {
+        output.assign(out);
+        delete out;
+    }
+
+    if (!dense)
+        delete in;
+}
+
+
+BUILD_SINGLE_TEMPLATE(template void quantizeActivations_, (const NDArray& x, uint8_t *q, int32_t *rowSums, float& scale, int& zeroPoint), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void epilogue_, (const int32_t *C, const int32_t *rowSums, const std::vector<Nd4jLong>& colTerms, const std::vector<int>& zeroPoints, const std::vector<float>& multipliers, const std::vector<float>& bias, NDArray& z, const double outScale, const int outZeroPoint), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void quantizeWeights_, (const NDArray& input, NDArray& output, NDArray& scales, NDArray& zeroPoints, const bool symmetric), FLOAT_TYPES);
+
+}
+}
+}
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/biasActivation.h>
+#include <PointersManager.h>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// C tile computed by single block of threads
+#define FUSED_GEMM_TILE 16
+
+namespace nd4j 	  {
+namespace ops 	  {
+namespace helpers {
+
+
+//////////////////////////////////////////////////////////////////////////
+void biasActivation(NDArray& input, const NDArray* bias, const int activation, const double alpha) {
+
+    if (bias != nullptr && (input.rankOf() < 1 || input.sizeAt(-1) != bias->lengthOf()))
+        throw std::runtime_error("biasActivation: bias length must be equal to last dimension of input");
+
+    if (bias != nullptr)
+        input.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Add(), bias, &input);
+
+    switch (activation) {
+        case FUSED_NONE:
+            break;
+        case FUSED_RELU:
+            input.applyScalar(nd4j::scalar::RELU, alpha, &input);
+            break;
+        case FUSED_RELU6:
+            input.applyScalar(nd4j::scalar::RELU6, alpha, &input);
+            break;
+        case FUSED_SIGMOID:
+            input.applyTransform(nd4j::transform::Sigmoid, &input);
+            break;
+        case FUSED_TANH:
+            input.applyTransform(nd4j::transform::Tanh, &input);
+            break;
+        default:
+            throw std::runtime_error("biasActivation: unknown activation");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// each thread computes single element of C, and applies epilogue right before storing it
+template <typename X, int A>
+__global__ static void matmulBiasActivationCuda(const int M, const int N, const int K,
+                                                const X* a, const Nd4jLong aRowStride, const Nd4jLong aColStride,
+                                                const X* b, const Nd4jLong bRowStride, const Nd4jLong bColStride,
+                                                X* c, const Nd4jLong cRowStride, const Nd4jLong cColStride,
+                                                const BiasActivationEpilogue<typename std::conditional<sizeof(X) < 4, float, X>::type, A> epilogue) {
+
+    // half types are accumulated in float
+    typedef typename std::conditional<sizeof(X) < 4, float, X>::type Acc;
+
+    __shared__ Acc aTile[FUSED_GEMM_TILE][FUSED_GEMM_TILE];
+    __shared__ Acc bTile[FUSED_GEMM_TILE][FUSED_GEMM_TILE + 1];
+
+    const int row = blockIdx.y * FUSED_GEMM_TILE + threadIdx.y;
+    const int col = blockIdx.x * FUSED_GEMM_TILE + threadIdx.x;
+
+    Acc sum = static_cast<Acc>(0);
+
+    for (int k0 = 0; k0 < K; k0 += FUSED_GEMM_TILE) {
+        const int ka = k0 + threadIdx.x;
+        const int kb = k0 + threadIdx.y;
+
+        aTile[threadIdx.y][threadIdx.x] = row < M && ka < K ? static_cast<Acc>(a[row * aRowStride + ka * aColStride]) : static_cast<Acc>(0);
+        bTile[threadIdx.y][threadIdx.x] = kb < K && col < N ? static_cast<Acc>(b[kb * bRowStride + col * bColStride]) : static_cast<Acc>(0);
+        __syncthreads();
+
+        for (int k = 0; k < FUSED_GEMM_TILE; k++)
+            sum += aTile[threadIdx.y][k] * bTile[k][threadIdx.x];
+        __syncthreads();
+    }
+
+    if (row < M && col < N)
+        c[row * cRowStride + col * cColStride] = static_cast<X>(epilogue(sum, col));
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, int A>
+static void matmulBiasActivationCudaLauncher(nd4j::LaunchContext* context, const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const void* bias, const double alpha) {
+
+    typedef typename std::conditional<sizeof(X) < 4, float, X>::type Acc;
+
+    const int M = z->sizeAt(0);
+    const int N = z->sizeAt(1);
+    const int K = transX ? x->sizeAt(0) : x->sizeAt(1);
+
+    // matrices are addressed via strides, so transposition is just a swap of strides
+    const Nd4jLong aRowStride = x->stridesOf()[transX ? 1 : 0];
+    const Nd4jLong aColStride = x->stridesOf()[transX ? 0 : 1];
+    const Nd4jLong bRowStride = y->stridesOf()[transY ? 1 : 0];
+    const Nd4jLong bColStride = y->stridesOf()[transY ? 0 : 1];
+
+    BiasActivationEpilogue<Acc, A> epilogue;
+    epilogue.bias = reinterpret_cast<const Acc*>(bias);
+    epilogue.alpha = static_cast<Acc>(alpha);
+
+    const dim3 threadsPerBlock(FUSED_GEMM_TILE, FUSED_GEMM_TILE);
+    const dim3 blocksPerGrid((N + FUSED_GEMM_TILE - 1) / FUSED_GEMM_TILE, (M + FUSED_GEMM_TILE - 1) / FUSED_GEMM_TILE);
+
+    matmulBiasActivationCuda<X, A><<<blocksPerGrid, threadsPerBlock, 0, *context->getCudaStream()>>>(M, N, K,
+            reinterpret_cast<const X*>(x->getSpecialBuffer()), aRowStride, aColStride,
+            reinterpret_cast<const X*>(y->getSpecialBuffer()), bRowStride, bColStride,
+            reinterpret_cast<X*>(z->specialBuffer()), z->stridesOf()[0], z->stridesOf()[1],
+            epilogue);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X>
+static void matmulBiasActivation_(nd4j::LaunchContext* context, const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha) {
+
+    typedef typename std::conditional<sizeof(X) < 4, float, X>::type Acc;
+
+    PointersManager manager(context, "matmulBiasActivation");
+
+    // bias is tiny, so it's cast to accumulation type on host, and copied to device as is
+    void* b = nullptr;
+    if (bias != nullptr) {
+        std::vector<Acc> host(bias->lengthOf());
+        for (Nd4jLong e = 0; e < bias->lengthOf(); e++)
+            host[e] = bias->e<Acc>(e);
+
+        b = manager.replicatePointer(host.data(), host.size() * sizeof(Acc));
+    }
+
+    switch (activation) {
+        case FUSED_NONE:
+            matmulBiasActivationCudaLauncher<X, FUSED_NONE>(context, x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_RELU:
+            matmulBiasActivationCudaLauncher<X, FUSED_RELU>(context, x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_RELU6:
+            matmulBiasActivationCudaLauncher<X, FUSED_RELU6>(context, x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_SIGMOID:
+            matmulBiasActivationCudaLauncher<X, FUSED_SIGMOID>(context, x, y, z, transX, transY, b, alpha);
+            break;
+        case FUSED_TANH:
+            matmulBiasActivationCudaLauncher<X, FUSED_TANH>(context, x, y, z, transX, transY, b, alpha);
+            break;
+        default:
+            throw std::runtime_error("matmulBiasActivation: unknown activation");
+    }
+
+    manager.synchronize();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void matmulBiasActivation(nd4j::LaunchContext* context, const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha) {
+
+    if (x->rankOf() != 2 || y->rankOf() != 2 || z->rankOf() != 2)
+        throw std::runtime_error("matmulBiasActivation: all arrays must be matrices");
+
+    if (x->dataType() != z->dataType() || y->dataType() != z->dataType())
+        throw std::runtime_error("matmulBiasActivation: x, y and z must have the same data type");
+
+    if (bias != nullptr && bias->lengthOf() != z->sizeAt(1))
+        throw std::runtime_error("matmulBiasActivation: bias length must be equal to number of columns of z");
+
+    NDArray::prepareSpecialUse({z}, {x, y, bias});
+    BUILD_SINGLE_SELECTOR(z->dataType(), matmulBiasActivation_, (context, x, y, z, transX, transY, bias, activation, alpha), FLOAT_TYPES);
+    NDArray::registerSpecialUse({z}, {x, y, bias});
+}
+
+BUILD_SINGLE_TEMPLATE(template void matmulBiasActivation_, (nd4j::LaunchContext* context, const NDArray* x, const NDArray* y, NDArray* z, const bool transX, const bool transY, const NDArray* bias, const int activation, const double alpha), FLOAT_TYPES);
+
+}
+}
+}
@@ -21,6 +21,7 @@
 #include <ops/declarable/helpers/convolutions.h>
 #include <ops/declarable/helpers/im2col.h>
 #include <ops/declarable/helpers/col2im.h>
+#include <ops/declarable/helpers/biasActivation.h>
 #include <exceptions/cuda_exception.h>
 #include <NDArrayFactory.h>
 #include <MmulHelper.h>
@@ -288,6 +289,14 @@ void ConvolutionUtils::conv2d(nd4j::graph::Context& block, const NDArray* input,
     BUILD_DOUBLE_SELECTOR(input->dataType(), output->dataType(), conv2d_, (block, input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW), LIBND4J_TYPES, FLOAT_TYPES);
 }
 
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv2d(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW, const int activation, const double alpha) {
+    ConvolutionUtils::conv2d(block, input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW);
+
+    if (activation != helpers::FUSED_NONE)
+        helpers::biasActivation(*output, nullptr, activation, alpha);
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y>
 static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW) {
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/helpers/quantization.h>
+#include <helpers/QuantizationCalibrator.h>
+#include <MmulHelper.h>
+#include <stdexcept>
+#include <vector>
+
+namespace nd4j 	  {
+namespace ops 	  {
+namespace helpers {
+
+
+//////////////////////////////////////////////////////////////////////////
+// real values -> quantized values stored as floats: clamp(rint(x / scale) + zeroPoint)
+static void quantizeInPlace(NDArray& array, const double scale, const double zeroPoint, const double qMin, const double qMax) {
+    array.applyScalar(nd4j::scalar::Divide, scale, &array);
+    array.applyTransform(nd4j::transform::Rint, &array);
+    array.applyScalar(nd4j::scalar::Add, zeroPoint, &array);
+    array.applyScalar(nd4j::scalar::MaxPairwise, qMin, &array);
+    array.applyScalar(nd4j::scalar::MinPairwise, qMax, &array);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void quantizedMatmul(const NDArray& x, const NDArray& w, const NDArray& scales, const NDArray& zeroPoints, const NDArray* bias, NDArray& z, const double outScale, const int outZeroPoint) {
+
+    if (x.rankOf() != 2 || w.rankOf() != 2 || z.rankOf() != 2 || x.sizeAt(1) != w.sizeAt(0) || z.sizeAt(0) != x.sizeAt(0) || z.sizeAt(1) != w.sizeAt(1))
+        throw std::runtime_error("quantizedMatmul: x [M, K], w [K, N] and z [M, N] matrices are expected");
+
+    if (w.dataType() != nd4j::DataType::INT8)
+        throw std::runtime_error("quantizedMatmul: weights must be INT8");
+
+    if (outScale > 0. && z.dataType() != nd4j::DataType::INT8)
+        throw std::runtime_error("quantizedMatmul: requantized output must be INT8");
+
+    const Nd4jLong M = x.sizeAt(0);
+    const Nd4jLong K = x.sizeAt(1);
+    const Nd4jLong N = w.sizeAt(1);
+
+    if (scales.lengthOf() != N || zeroPoints.lengthOf() != N || (bias != nullptr && bias->lengthOf() != N))
+        throw std::runtime_error("quantizedMatmul: scales, zero points and bias must have one value per output column");
+
+    // there're no int8 kernels here: x goes through the same uint8 quantization as on CPU, and both operands are dequantized into fp32
+    double xScale;
+    int xZeroPoint;
+    QuantizationCalibrator::paramsOf(x.reduceNumber(nd4j::reduce::Min).e<double>(0), x.reduceNumber(nd4j::reduce::Max).e<double>(0), 0, 255, xScale, xZeroPoint);
+
+    NDArray xq('c', {M, K}, nd4j::DataType::FLOAT32, x.getContext());
+    xq.assign(x);
+    quantizeInPlace(xq, xScale, xZeroPoint, 0., 255.);
+    xq.applyScalar(nd4j::scalar::Subtract, static_cast<double>(xZeroPoint), &xq);
+    xq.applyScalar(nd4j::scalar::Multiply, xScale, &xq);
+
+    auto wZeroPoints = zeroPoints.cast(nd4j::DataType::FLOAT32);
+    auto wScales = scales.cast(nd4j::DataType::FLOAT32);
+
+    NDArray wd('c', {K, N}, nd4j::DataType::FLOAT32, w.getContext());
+    wd.assign(w);
+    wd.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Subtract(), wZeroPoints, &wd);
+    wd.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Multiply(), wScales, &wd);
+
+    NDArray result('c', {M, N}, nd4j::DataType::FLOAT32, z.getContext());
+    MmulHelper::mmul(&xq, &wd, &result, 1., 0.);
+
+    if (bias != nullptr)
+        result.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Add(), bias, &result);
+
+    if (outScale > 0.)
+        quantizeInPlace(result, outScale, outZeroPoint, -128., 127.);
+
+    z.assign(result);
+
+    delete wZeroPoints;
+    delete wScales;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void quantizeWeights(const NDArray& input, NDArray& output, NDArray& scales, NDArray& zeroPoints, const bool symmetric) {
+
+    if (input.rankOf() < 1 || output.dataType() != nd4j::DataType::INT8 || !output.isSameShape(&input))
+        throw std::runtime_error("quantizeWeights: output must be INT8 array of input shape");
+
+    const Nd4jLong N = input.sizeAt(-1);
+    if (scales.lengthOf() != N || zeroPoints.lengthOf() != N)
+        throw std::runtime_error("quantizeWeights: scales and zero points must have one value per channel");
+
+    std::vector<int> dimensions;
+    for (int e = 0; e < input.rankOf() - 1; e++)
+        dimensions.emplace_back(e);
+
+    auto lo = dimensions.empty() ? input.dup() : new NDArray(input.reduceAlongDims(nd4j::reduce::Min, dimensions));
+    auto hi = dimensions.empty() ? input.dup() : new NDArray(input.reduceAlongDims(nd4j::reduce::Max, dimensions));
+
+    // parameters are computed on host, there's one pair per channel only
+    NDArray s('c', {N}, nd4j::DataType::FLOAT32, input.getContext());
+    NDArray zp('c', {N}, nd4j::DataType::FLOAT32, input.getContext());
+
+    for (Nd4jLong n = 0; n < N; n++) {
+        double scale;
+        int zeroPoint;
+        if (symmetric)
+            QuantizationCalibrator::symmetricParamsOf(nd4j::math::nd4j_max<double>(-lo->e<double>(n), hi->e<double>(n)), 127, scale, zeroPoint);
+        else
+            QuantizationCalibrator::paramsOf(lo->e<double>(n), hi->e<double>(n), -128, 127, scale, zeroPoint);
+
+        s.p(n, scale);
+        zp.p(n, zeroPoint);
+    }
+
+    NDArray q(input.ordering(), input.getShapeAsVector(), nd4j::DataType::FLOAT32, input.getContext());
+    input.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Divide(), &s, &q);
+    q.applyTransform(nd4j::transform::Rint, &q);
+    q.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Add(), &zp, &q);
+    q.applyScalar(nd4j::scalar::MaxPairwise, -128., &q);
+    q.applyScalar(nd4j::scalar::MinPairwise, 127., &q);
+
+    output.assign(q);
+    scales.assign(s);
+    zeroPoints.assign(zp);
+
+    delete lo;
+    delete hi;
+}
+
+}
+}
+}
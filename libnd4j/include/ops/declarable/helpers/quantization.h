@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_QUANTIZATION_H
+#define LIBND4J_QUANTIZATION_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace nd4j    {
+namespace ops     {
+namespace helpers {
+
+    /**
+     * This method computes z = x x w + bias for int8 weights w [K, N], where column n represents real values scales[n] * (w[k, n] - zeroPoints[n]).
+     *
+     * x [M, K] is quantized into uint8 on the fly, with single scale and zero point taken from its range. Products are summed in int32,
+     * and zero points, scales and bias are applied in epilogue. If outScale is positive, z is int8 and gets requantized result
+     * (z = result / outScale + outZeroPoint), otherwise z is floating point and gets result as is.
+     */
+    void quantizedMatmul(const NDArray& x, const NDArray& w, const NDArray& scales, const NDArray& zeroPoints, const NDArray* bias, NDArray& z, const double outScale, const int outZeroPoint);
+
+    /**
+     * This method quantizes input into int8 output per channel, i.e. along last dimension, which is output channels dimension for
+     * matmul and conv2d weights. scales and zeroPoints get [numChannels] parameters, zero points are 0 if symmetric is TRUE
+     */
+    void quantizeWeights(const NDArray& input, NDArray& output, NDArray& scales, NDArray& zeroPoints, const bool symmetric);
+
+}
+}
+}
+
+
+#endif // LIBND4J_QUANTIZATION_H
@@ -25,6 +25,7 @@
 #include <NDArrayFactory.h>
 #include <exceptions/graph_exception.h>
 #include <exceptions/unresolved_input_exception.h>
+#include <helpers/ConstantShapeHelper.h>
 
 namespace nd4j {
     namespace ops {
@@ -74,6 +75,8 @@ namespace nd4j {
 
             if (_scalar != nullptr)
                 delete _scalar;
+
+            purgeShapeCache();
         }
 
         OpDescriptor* DeclarableOp::getOpDescriptor() {
@@ -89,6 +92,60 @@ namespace nd4j {
         }
 
 
+        void DeclarableOp::purgeShapeCache() {
+            std::lock_guard<std::mutex> lock(_shapeLock);
+            for (auto &v: _shapeCache)
+                for (auto shape: v.second)
+                    ConstantShapeHelper::release(shape);
+
+            _shapeCache.clear();
+        }
+
+        Nd4jLong DeclarableOp::shapeCacheSize() {
+            std::lock_guard<std::mutex> lock(_shapeLock);
+            return (Nd4jLong) _shapeCache.size();
+        }
+
+        ShapeList* DeclarableOp::memoizedOutputShape(ShapeList &inputShapes, Context &ctx) {
+            // we don't want unbounded growth for ops fed with dynamic shapes
+            static const size_t maxCachedShapes = 1024;
+
+            OpShapeKey key(inputShapes, ctx);
+            if (!key.isOrdered())
+                return this->calculateOutputShape(&inputShapes, ctx);
+
+            {
+                std::lock_guard<std::mutex> lock(_shapeLock);
+                auto it = _shapeCache.find(key);
+                if (it != _shapeCache.end())
+                    return new ShapeList(it->second);
+            }
+
+            ctx.resetInputAccesses();
+            auto outSha = this->calculateOutputShape(&inputShapes, ctx);
+
+            // shape function has read input values, so output shapes depend on more than the key
+            if (ctx.inputAccesses() > 0)
+                return outSha;
+
+            for (auto out: *outSha->asVector())
+                if (out == nullptr)
+                    return outSha;
+
+            // memoized shapes are pinned, so ConstantShapeHelper can't evict them while they're here
+            EpochGuard guard;
+            std::vector<Nd4jLong*> shapes;
+            for (auto out: *outSha->asVector())
+                shapes.emplace_back(ConstantShapeHelper::getInstance()->createShapeInfo(ShapeDescriptor(out)));
+
+            std::lock_guard<std::mutex> lock(_shapeLock);
+            if (_shapeCache.size() < maxCachedShapes && _shapeCache.emplace(key, shapes).second)
+                for (auto shape: shapes)
+                    ConstantShapeHelper::retain(shape);
+
+            return outSha;
+        }
+
         nd4j::NDArray* nd4j::ops::DeclarableOp::getZ(Context& ctx, int inputId) {
             NDArray* z = nullptr;
 
@@ -165,12 +222,12 @@ namespace nd4j {
                         inSha.push_back(p->getShapeInfo());
                     }
                 } else {
-                    for (auto p: *ctx.inputs()) {
-                        auto var = ctx.variable(p);
+                    for (int e = 0; e < ctx.inputs()->size(); e++) {
+                        auto var = ctx.inputVariable(e);
                         if (var->variableType() == VariableType::NDARRAY) {
                             NDArray *array = var->getNDArray();
                             if (array == nullptr)
-                                throw unresolved_input_exception::build("Variable wasn't resolved prior shape calculation", p);
+                                throw unresolved_input_exception::build("Variable wasn't resolved prior shape calculation", ctx.inputs()->at(e));
 
                             inSha.push_back(array->getShapeInfo());
                         }
@@ -187,7 +244,8 @@ namespace nd4j {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
+                // shapes are memoized per input shapes & arguments, so repeated executions skip shape function
+                auto outSha = this->memoizedOutputShape(inSha, ctx);
                 results = outSha->size();
 
                 // we must "validate" our output shapes
@@ -235,7 +293,10 @@ namespace nd4j {
                             if (Environment::getInstance()->isDebugAndVerbose())
                                 shape::printShapeInfoLinear("Going to create variable with shape", out);
 
-                            auto outArr = new NDArray(out, true, ctx.launchContext());
+                            // if graph memory was planned, array is placed within arena
+                            NDArray *outArr = ctx.getVariableSpace() != nullptr ? ctx.getVariableSpace()->plannedArray(pair, out, ctx.launchContext()) : nullptr;
+                            if (outArr == nullptr)
+                                outArr = new NDArray(out, true, ctx.launchContext());
 
                             ctx.pushNDArrayToVariableSpace(pair, outArr);
                         } else {
@@ -344,13 +405,21 @@ namespace nd4j {
             return true;
         }
 
-        Nd4jStatus nd4j::ops::DeclarableOp::validateDataTypes(Context& block) {
-            _registrator.lock();
+        void nd4j::ops::DeclarableOp::ensureTypesRegistered() {
+            std::lock_guard<std::mutex> lock(_registrator);
             if (!_registered) {
                 _registered = true;
                 this->registerTypes();
             }
-            _registrator.unlock();
+        }
+
+        bool nd4j::ops::DeclarableOp::isRandom() {
+            ensureTypesRegistered();
+            return _descriptor->isRandom();
+        }
+
+        Nd4jStatus nd4j::ops::DeclarableOp::validateDataTypes(Context& block) {
+            ensureTypesRegistered();
 
             // rolling over inputs first
             int cnt = 0, inT = 0;
@@ -433,6 +502,9 @@ namespace nd4j {
         Nd4jStatus nd4j::ops::DeclarableOp::execute(Context* block) {
             nd4j_debug("Executing op: [%s]\n", this->getOpName()->c_str());
 
+            // shapes and TADs obtained from caches during execution stay valid until op is done with them
+            EpochGuard guard;
+
             std::chrono::time_point<std::chrono::system_clock> timeEnter, timeStart, timeEnd;
             Nd4jLong prepTime, outerTime;
 
@@ -193,6 +193,11 @@ namespace nd4j {
             return this;
         }
 
+        OpDescriptor* OpDescriptor::setRandom(const bool reallyRandom) {
+            _random = reallyRandom;
+            return this;
+        }
+
         OpDescriptor* OpDescriptor::setAllowedInputTypes(int index, const std::vector<nd4j::DataType> &dtype) {
             _inputTypes[index] = dtype;
             return this;
@@ -270,6 +275,10 @@ namespace nd4j {
             return _sameMode;
         }
 
+        bool OpDescriptor::isRandom() {
+            return _random;
+        }
+
         bool OpDescriptor::isInherit(int index) {
             if (std::find(_allowedOuts.begin(), _allowedOuts.end(), nd4j::DataType::INHERIT) != _allowedOuts.end())
                 return true;
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/OpShapeKey.h>
+#include <graph/Context.h>
+#include <tuple>
+
+namespace nd4j {
+    namespace ops {
+        OpShapeKey::OpShapeKey(ShapeList &inputShapes, nd4j::graph::Context &block) {
+            for (auto shapeInfo: *inputShapes.asVector())
+                _inputs.emplace_back(ShapeDescriptor(shapeInfo));
+
+            _iArgs = *block.getIArguments();
+            _tArgs = *block.getTArguments();
+            _bArgs = *block.getBArguments();
+            _axis = *block.getAxis();
+            _dataType = block.dataType();
+            _opNum = block.opNum();
+            _width = block.width();
+        }
+
+        bool OpShapeKey::isOrdered() const {
+            for (auto t: _tArgs)
+                if (t != t)
+                    return false;
+
+            return true;
+        }
+
+        bool OpShapeKey::operator==(const OpShapeKey &other) const {
+            return std::tie(_opNum, _dataType, _width, _iArgs, _tArgs, _bArgs, _axis, _inputs) == std::tie(other._opNum, other._dataType, other._width, other._iArgs, other._tArgs, other._bArgs, other._axis, other._inputs);
+        }
+
+        bool OpShapeKey::operator<(const OpShapeKey &other) const {
+            return std::tie(_opNum, _dataType, _width, _iArgs, _tArgs, _bArgs, _axis, _inputs) < std::tie(other._opNum, other._dataType, other._width, other._iArgs, other._tArgs, other._bArgs, other._axis, other._inputs);
+        }
+    }
+}
@@ -20,35 +20,222 @@
 
 #include "GraphServer.h"
 #include <graph/GraphHolder.h>
+#include <graph/GraphBatcher.h>
+#include <graph/StreamingSessions.h>
 #include <GraphExecutioner.h>
 #include <graph/generated/result_generated.h>
 #include <helpers/StringUtils.h>
 #include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <functional>
+#include <pthread.h>
 #include <stdexcept>
 
-#include <graph/exceptions/unknown_graph_exception.h>
-#include <graph/exceptions/graph_exists_exception.h>
-#include <graph/exceptions/no_results_exception.h>
-#include <graph/exceptions/graph_execution_exception.h>
+#include <exceptions/unknown_graph_exception.h>
+#include <exceptions/graph_exists_exception.h>
+#include <exceptions/no_results_exception.h>
+#include <exceptions/graph_execution_exception.h>
+#include <exceptions/session_limit_exception.h>
 
 
+// calls in flight get this much time to complete once shutdown was requested, and get cancelled after that
+#define SHUTDOWN_GRACE_MS 5000
 
 namespace nd4j {
     namespace graph {
-            grpc::Status GraphInferenceServerImpl::RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
-                auto flat_graph = request_msg->GetRoot();
+        /**
+         * Base class for calls in flight: completion queue tags point to instances of this class
+         */
+        class ServerCall {
+        public:
+            virtual ~ServerCall() = default;
+            virtual void proceed(bool ok) = 0;
+        };
+
+        /**
+         * This class holds state of single unary call: its own ServerContext, request, response and MessageBuilder
+         */
+        template <typename REQUEST, typename RESPONSE>
+        class UnaryCall : public ServerCall {
+        public:
+            typedef std::function<void(grpc::ServerContext*, flatbuffers::grpc::Message<REQUEST>*, grpc::ServerAsyncResponseWriter<flatbuffers::grpc::Message<RESPONSE>>*, grpc::ServerCompletionQueue*, void*)> Starter;
+            typedef std::function<grpc::Status(const REQUEST*, flatbuffers::grpc::MessageBuilder&, flatbuffers::grpc::Message<RESPONSE>*)> Handler;
+
+        private:
+            Starter _starter;
+            Handler _handler;
+            grpc::ServerCompletionQueue *_queue;
+
+            CallTracker *_tracker;
+
+            grpc::ServerContext _context;
+            flatbuffers::grpc::Message<REQUEST> _request;
+            flatbuffers::grpc::Message<RESPONSE> _response;
+            grpc::ServerAsyncResponseWriter<flatbuffers::grpc::Message<RESPONSE>> _responder;
+            flatbuffers::grpc::MessageBuilder _builder;
+
+            bool _finished = false;
+
+        public:
+            UnaryCall(Starter starter, Handler handler, grpc::ServerCompletionQueue *queue, CallTracker *tracker) : _starter(starter), _handler(handler), _queue(queue), _tracker(tracker), _responder(&_context) {
+                _starter(&_context, &_request, &_responder, _queue, this);
+            }
+
+            void proceed(bool ok) override {
+                // either response was sent, or queue is shutting down
+                if (_finished || !ok) {
+                    delete this;
+                    return;
+                }
+
+                // this call will be deleted by other worker as soon as it's finished, so tracker is kept aside
+                auto tracker = _tracker;
+
+                // call is counted first and checked for shutdown next, so shutdown() either waits for it, or it sees shutdown
+                tracker->active.fetch_add(1);
+
+                grpc::Status status;
+                if (tracker->closing.load()) {
+                    status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down");
+                } else {
+                    // next call of the same method will be accepted while this one is processed
+                    new UnaryCall<REQUEST, RESPONSE>(_starter, _handler, _queue, tracker);
+
+                    // exception escaping handler would kill worker thread, and with it the whole server
+                    try {
+                        status = _handler(_request.GetRoot(), _builder, &_response);
+                    } catch (std::exception &e) {
+                        status = grpc::Status(grpc::StatusCode::INTERNAL, grpc::string(e.what()));
+                    } catch (...) {
+                        status = grpc::Status(grpc::StatusCode::INTERNAL, "Caught unknown exception");
+                    }
+                }
+                _finished = true;
+
+                if (status.ok())
+                    _responder.Finish(_response, status, this);
+                else
+                    _responder.FinishWithError(status, this);
+
+                tracker->active.fetch_sub(1);
+            }
+        };
+
+            GraphInferenceServerImpl::GraphInferenceServerImpl(int numWorkers) {
+                _numWorkers = numWorkers > 0 ? numWorkers : 1;
+            }
+
+            GraphInferenceServerImpl::~GraphInferenceServerImpl() {
+                shutdown();
+            }
+
+            void GraphInferenceServerImpl::run(const std::string &address) {
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    if (_stopping || _running)
+                        return;
+
+                    grpc::ServerBuilder builder;
+                    builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+                    builder.RegisterService(&_service);
+
+                    for (int e = 0; e < _numWorkers; e++)
+                        _queues.emplace_back(builder.AddCompletionQueue());
+
+                    _server = builder.BuildAndStart();
+                    if (_server == nullptr) {
+                        _queues.clear();
+                        throw std::runtime_error("Unable to start server at [" + address + "]");
+                    }
+
+                    for (int e = 0; e < _numWorkers; e++)
+                        _workers.emplace_back(&GraphInferenceServerImpl::serve, this, _queues[e].get());
+
+                    _running = true;
+                }
+
+                // workers exit once shutdown() closed their queues, and queues were drained
+                for (auto &w: _workers)
+                    w.join();
+
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+
+                    // server must go before its queues
+                    _workers.clear();
+                    _server.reset();
+                    _queues.clear();
+                    _running = false;
+                }
+
+                _drained.notify_all();
+            }
+
+            void GraphInferenceServerImpl::shutdown() {
+                std::unique_lock<std::mutex> lock(_lock);
+
+                if (!_stopping) {
+                    _stopping = true;
+
+                    if (_running) {
+                        // workers keep polling queues meanwhile, so calls in flight are completed or cancelled here
+                        _server->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(SHUTDOWN_GRACE_MS));
 
+                        // handlers that outlived the grace period still have to queue their Finish, and late ones are rejected
+                        _tracker.closing.store(true);
+                        while (_tracker.active.load() > 0)
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                        // nothing else can be queued now, so queues are closed
+                        for (auto &q: _queues)
+                            q->Shutdown();
+                    }
+                }
+
+                _drained.wait(lock, [&] { return !_running; });
+            }
+
+            void GraphInferenceServerImpl::serve(grpc::ServerCompletionQueue *queue) {
+                auto service = &_service;
+
+                // each queue always has one pending call per method
+                new UnaryCall<FlatGraph, FlatResponse>([service](grpc::ServerContext *c, flatbuffers::grpc::Message<FlatGraph> *r, grpc::ServerAsyncResponseWriter<flatbuffers::grpc::Message<FlatResponse>> *w, grpc::ServerCompletionQueue *q, void *t) {
+                    service->RequestRegisterGraph(c, r, w, q, q, t);
+                }, &GraphInferenceServerImpl::RegisterGraph, queue, &_tracker);
+
+                new UnaryCall<FlatGraph, FlatResponse>([service](grpc::ServerContext *c, flatbuffers::grpc::Message<FlatGraph> *r, grpc::ServerAsyncResponseWriter<flatbuffers::grpc::Message<FlatResponse>> *w, grpc::ServerCompletionQueue *q, void *t) {
+                    service->RequestReplaceGraph(c, r, w, q, q, t);
+                }, &GraphInferenceServerImpl::ReplaceGraph, queue, &_tracker);
+
+                new UnaryCall<FlatDropRequest, FlatResponse>([service](grpc::ServerContext *c, flatbuffers::grpc::Message<FlatDropRequest> *r, grpc::ServerAsyncResponseWriter<flatbuffers::grpc::Message<FlatResponse>> *w, grpc::ServerCompletionQueue *q, void *t) {
+                    service->RequestForgetGraph(c, r, w, q, q, t);
+                }, &GraphInferenceServerImpl::ForgetGraph, queue, &_tracker);
+
+                new UnaryCall<FlatInferenceRequest, FlatResult>([service](grpc::ServerContext *c, flatbuffers::grpc::Message<FlatInferenceRequest> *r, grpc::ServerAsyncResponseWriter<flatbuffers::grpc::Message<FlatResult>> *w, grpc::ServerCompletionQueue *q, void *t) {
+                    service->RequestInferenceRequest(c, r, w, q, q, t);
+                }, &GraphInferenceServerImpl::InferenceRequest, queue, &_tracker);
+
+                void *tag;
+                bool ok;
+                while (queue->Next(&tag, &ok))
+                    static_cast<ServerCall*>(tag)->proceed(ok);
+            }
+
+            grpc::Status GraphInferenceServerImpl::RegisterGraph(const FlatGraph *flat_graph, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
+
+                    GraphHolder::getInstance()->registerGraph(flat_graph->id(), graph);
 
-                    // single data type for now
-                    GraphHolder::getInstance()->registerGraph<float>(flat_graph->id(), graph);
+                    // state variables of streaming sessions, if graph declares any
+                    StreamingSessions::getInstance()->defineStates(flat_graph->id(), flat_graph);
 
                     // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -58,20 +245,18 @@ namespace nd4j {
                 }
             }
 
-            grpc::Status GraphInferenceServerImpl::ReplaceGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
-                auto flat_graph = request_msg->GetRoot();
-
+            grpc::Status GraphInferenceServerImpl::ReplaceGraph(const FlatGraph *flat_graph, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
 
-                    // single data type for now
                     GraphHolder::getInstance()->replaceGraph(flat_graph->id(), graph);
+                    StreamingSessions::getInstance()->defineStates(flat_graph->id(), flat_graph);
 
                     // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -84,19 +269,18 @@ namespace nd4j {
                 }
             }
 
-            grpc::Status GraphInferenceServerImpl::ForgetGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatDropRequest> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
+            grpc::Status GraphInferenceServerImpl::ForgetGraph(const FlatDropRequest *request, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 try {
-
-                    // getting drop request
-                    auto request = request_msg->GetRoot();
-
-                    // dropping out graph (any datatype)
-                    GraphHolder::getInstance()->dropGraphAny(request->id());
+                    // request with session set ends only that streaming session, graph itself is kept
+                    if (request->session() != 0)
+                        StreamingSessions::getInstance()->endSession(request->id(), request->session());
+                    else
+                        GraphHolder::getInstance()->dropGraphAny(request->id());
 
                     // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -106,21 +290,23 @@ namespace nd4j {
                 }
             }
 
-            grpc::Status GraphInferenceServerImpl::InferenceRequest( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatInferenceRequest> *request_msg, flatbuffers::grpc::Message<FlatResult> *response_msg) {
-                auto request = request_msg->GetRoot();
-
+            grpc::Status GraphInferenceServerImpl::InferenceRequest(const FlatInferenceRequest *request, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResult> *response_msg) {
                 try {
-                    // GraphHolder
-                    auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb_, request);
+                    // concurrent calls might be batched together, results are still written into builder of this call
+                    auto response_offset = GraphBatcher::getInstance()->execute(request->id(), mb, request);
 
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResult>();
+                    // message is backed by builder's slice, so response is sent out without copying
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResult>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
                 } catch (nd4j::graph::no_results_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::INTERNAL, gmsg);
+                } catch (nd4j::session_limit_exception &e) {
+                    grpc::string gmsg(e.message());
+                    return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, gmsg);
                 } catch (nd4j::graph::unknown_graph_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::NOT_FOUND, gmsg);
@@ -135,22 +321,42 @@ namespace nd4j {
     }
 }
 
-void RunServer(int port) {
+void RunServer(int port, int numWorkers) {
   assert(port > 0 && port < 65535);
 
   std::string server_address("0.0.0.0:");
   server_address += nd4j::StringUtils::valueToString<int>(port);
 
-  nd4j::graph::GraphInferenceServerImpl service;
+  nd4j::graph::GraphInferenceServerImpl service(numWorkers);
   auto registrator = nd4j::ops::OpRegistrator::getInstance();
 
-  grpc::ServerBuilder builder;
-  builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
-  builder.RegisterService(&service);
-  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
-  std::cerr << "Server listening on: [" << server_address << "]; Number of operations: [" <<  registrator->numberOfOperations()  << "]"<< std::endl;
-
-  server->Wait();
+  // SIGINT & SIGTERM are blocked before any server thread is started, so only stopper thread receives them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  // gRPC can't be called from signal handler, so signals are awaited synchronously
+  std::thread stopper([&service, &signals] {
+      int signal = 0;
+      sigwait(&signals, &signal);
+
+      std::cerr << "Caught signal [" << signal << "], shutting down" << std::endl;
+      service.shutdown();
+  });
+
+  std::cerr << "Server listening on: [" << server_address << "]; Number of operations: [" <<  registrator->numberOfOperations()  << "]; Number of workers: [" << numWorkers << "]" << std::endl;
+
+  try {
+      service.run(server_address);
+  } catch (std::exception &e) {
+      std::cerr << e.what() << std::endl;
+  }
+
+  // stopper is still waiting if server was stopped without signal
+  pthread_kill(stopper.native_handle(), SIGTERM);
+  stopper.join();
 }
 
 char* getCmdOption(char **begin, char **end, const std::string & option) {
@@ -178,13 +384,36 @@ int main(int argc, char *argv[]) {
         port = atoi(sPort);
      }
 
+    // number of threads serving gRPC calls, each one has its own completion queue
+    int numWorkers = std::thread::hardware_concurrency();
+    if(cmdOptionExists(argv, argv+argc, "-w")) {
+        auto sWorkers = getCmdOption(argv, argv + argc, "-w");
+        numWorkers = atoi(sWorkers);
+    }
+
+    // optional dynamic batching of inference requests
+    if(cmdOptionExists(argv, argv+argc, "-b")) {
+        auto sBatch = getCmdOption(argv, argv + argc, "-b");
+        nd4j::graph::GraphBatcher::getInstance()->setMaxBatchSize(atoi(sBatch));
+    }
+
+    if(cmdOptionExists(argv, argv+argc, "-d")) {
+        auto sDelay = getCmdOption(argv, argv + argc, "-d");
+        nd4j::graph::GraphBatcher::getInstance()->setMaxDelay(atol(sDelay));
+    }
+
     if(cmdOptionExists(argv, argv+argc, "-f")) {
         auto file = getCmdOption(argv, argv + argc, "-f");
-        auto graph = GraphExecutioner<float>::importFromFlatBuffers(file);
-        nd4j::graph::GraphHolder::getInstance()->registerGraph<float>(0L, graph);
+
+        // graph file is memory-mapped by default, so weights aren't copied into heap
+        auto graph = cmdOptionExists(argv, argv+argc, "-c") ? nd4j::graph::GraphExecutioner::importFromFlatBuffers(file) : nd4j::graph::GraphExecutioner::importFromMappedFlatBuffers(file);
+        nd4j::graph::GraphHolder::getInstance()->registerGraph(0L, graph);
+
+        auto stats = graph->getOptimizationStats();
+        nd4j_printf("Graph [%s] registered: %lld nodes, %lld nodes after optimization\n", file, stats.nodesBefore, stats.nodesAfter);
     }
 
-    RunServer(port);
+    RunServer(port, numWorkers);
 
     return 0;
 }
\ No newline at end of file
@@ -23,22 +23,68 @@
 #include <NDArray.h>
 #include <graph/Graph.h>
 #include <ops/declarable/CustomOperations.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <graph/generated/graph.grpc.fb.h>
 
 namespace nd4j {
     namespace graph {
-        class GraphInferenceServerImpl final : public GraphInferenceServer::Service {
+        /**
+         * Calls being handled right now, shared by all workers: completion queues can be closed only once there are none
+         */
+        struct CallTracker {
+            std::atomic<int> active{0};
+            std::atomic<bool> closing{false};
+        };
+
+        /**
+         * This class is asynchronous gRPC GraphServer: each worker thread polls its own completion queue,
+         * and each call builds its response within its own MessageBuilder, so concurrent calls never share state.
+         */
+        class GraphInferenceServerImpl final {
         private:
-            flatbuffers::grpc::MessageBuilder mb_;
+            GraphInferenceServer::AsyncService _service;
+            std::unique_ptr<grpc::Server> _server;
+            std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> _queues;
+            std::vector<std::thread> _workers;
+            int _numWorkers;
+
+            // run() and shutdown() can be called from different threads, so their state is guarded by this lock
+            std::mutex _lock;
+            std::condition_variable _drained;
+            bool _running = false;
+            bool _stopping = false;
+
+            CallTracker _tracker;
+
+            void serve(grpc::ServerCompletionQueue *queue);
         public:
-            virtual grpc::Status RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
+            explicit GraphInferenceServerImpl(int numWorkers);
+            ~GraphInferenceServerImpl();
+
+            /**
+             * This method starts server at given address, and blocks until server is shut down
+             */
+            void run(const std::string &address);
+
+            /**
+             * This method stops server: new calls are rejected, calls in flight get grace period to complete,
+             * and method blocks until all workers have drained their queues and exited. Safe to call from any thread, any number of times
+             */
+            void shutdown();
+
+            static grpc::Status RegisterGraph(const FlatGraph *request, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
-            virtual grpc::Status ForgetGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatDropRequest> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
+            static grpc::Status ForgetGraph(const FlatDropRequest *request, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
-            virtual grpc::Status ReplaceGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
+            static grpc::Status ReplaceGraph(const FlatGraph *request, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
-            virtual grpc::Status InferenceRequest( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatInferenceRequest> *request_msg, flatbuffers::grpc::Message<FlatResult> *response_msg);
+            static grpc::Status InferenceRequest(const FlatInferenceRequest *request, flatbuffers::grpc::MessageBuilder &mb, flatbuffers::grpc::Message<FlatResult> *response_msg);
         };
     }
-}
\ No newline at end of file
+}
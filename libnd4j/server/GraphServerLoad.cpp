@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+// Load generator for GraphServer: sends the same inference request from many client threads,
+// and reports throughput and latency percentiles
+//
+
+#include <grpc++/grpc++.h>
+#include <NDArray.h>
+#include <NDArrayFactory.h>
+#include <graph/InferenceRequest.h>
+#include <graph/generated/graph.grpc.fb.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace nd4j;
+using namespace nd4j::graph;
+
+char* getCmdOption(char **begin, char **end, const std::string & option) {
+    auto itr = std::find(begin, end, option);
+    if (itr != end && ++itr != end)
+        return *itr;
+
+    return 0;
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option) {
+    return std::find(begin, end, option) != end;
+}
+
+std::vector<Nd4jLong> parseShape(const std::string &str) {
+    std::vector<Nd4jLong> shape;
+    size_t start = 0;
+    while (start < str.length()) {
+        auto end = str.find(',', start);
+        if (end == std::string::npos)
+            end = str.length();
+
+        shape.emplace_back(atol(str.substr(start, end - start).c_str()));
+        start = end + 1;
+    }
+
+    return shape;
+}
+
+bool registerGraph(GraphInferenceServer::Stub *stub, const char *filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.empty()) {
+        std::cerr << "Can't read graph from [" << filename << "]" << std::endl;
+        return false;
+    }
+
+    auto slice = grpc_slice_from_copied_buffer(data.data(), data.size());
+    flatbuffers::grpc::Message<FlatGraph> request(slice, false);
+    flatbuffers::grpc::Message<FlatResponse> response;
+
+    grpc::ClientContext context;
+    auto status = stub->RegisterGraph(&context, request, &response);
+    if (!status.ok())
+        std::cerr << "RegisterGraph failed: " << status.error_message() << std::endl;
+
+    return status.ok();
+}
+
+int main(int argc, char *argv[]) {
+    /**
+     * -a localhost:40123   // GraphServer address
+     * -f filename.fb       // optional graph to be registered before the load
+     * -g 0                 // graph id
+     * -i 1                 // id of the input variable
+     * -s 1,784             // shape of the input variable
+     * -c 16                // number of concurrent clients
+     * -n 10000             // total number of requests
+     */
+    std::string address("localhost:40123");
+    if (cmdOptionExists(argv, argv + argc, "-a"))
+        address = getCmdOption(argv, argv + argc, "-a");
+
+    Nd4jLong graphId = cmdOptionExists(argv, argv + argc, "-g") ? atol(getCmdOption(argv, argv + argc, "-g")) : 0L;
+    int inputId = cmdOptionExists(argv, argv + argc, "-i") ? atoi(getCmdOption(argv, argv + argc, "-i")) : 1;
+    auto shape = parseShape(cmdOptionExists(argv, argv + argc, "-s") ? getCmdOption(argv, argv + argc, "-s") : "1,784");
+    int numClients = cmdOptionExists(argv, argv + argc, "-c") ? atoi(getCmdOption(argv, argv + argc, "-c")) : 16;
+    int numRequests = cmdOptionExists(argv, argv + argc, "-n") ? atoi(getCmdOption(argv, argv + argc, "-n")) : 10000;
+
+    auto channel = grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
+    auto stub = GraphInferenceServer::NewStub(channel);
+
+    if (cmdOptionExists(argv, argv + argc, "-f") && !registerGraph(stub.get(), getCmdOption(argv, argv + argc, "-f")))
+        return 1;
+
+    std::atomic<int> counter(0);
+    std::atomic<int> failures(0);
+    std::vector<std::vector<Nd4jLong>> latencies(numClients);
+    std::vector<std::thread> clients;
+
+    auto timeStart = std::chrono::steady_clock::now();
+    for (int c = 0; c < numClients; c++) {
+        clients.emplace_back([&, c] {
+            // each client sends the same request over and over
+            auto input = NDArrayFactory::create<float>('c', shape);
+            input.linspace(1.0);
+
+            InferenceRequest ir(graphId);
+            ir.appendVariable(inputId, 0, &input);
+
+            flatbuffers::grpc::MessageBuilder mb;
+            mb.Finish(ir.asFlatInferenceRequest(mb));
+            auto request = mb.ReleaseMessage<FlatInferenceRequest>();
+
+            while (counter++ < numRequests) {
+                flatbuffers::grpc::Message<FlatResult> response;
+                grpc::ClientContext context;
+
+                auto t0 = std::chrono::steady_clock::now();
+                auto status = stub->InferenceRequest(&context, request, &response);
+                auto t1 = std::chrono::steady_clock::now();
+
+                if (!status.ok())
+                    failures++;
+
+                latencies[c].emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+            }
+        });
+    }
+
+    for (auto &c: clients)
+        c.join();
+
+    auto seconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - timeStart).count() / 1e6;
+
+    std::vector<Nd4jLong> all;
+    for (auto &l: latencies)
+        all.insert(all.end(), l.begin(), l.end());
+
+    if (all.empty()) {
+        std::cerr << "No requests were sent" << std::endl;
+        return 1;
+    }
+
+    std::sort(all.begin(), all.end());
+    auto p50 = all[all.size() / 2];
+    auto p99 = all[std::min<size_t>(all.size() - 1, all.size() * 99 / 100)];
+
+    std::cout << "Requests: " << all.size() << "; failures: " << failures.load() << "; clients: " << numClients << std::endl;
+    std::cout << "Throughput: " << all.size() / seconds << " req/s" << std::endl;
+    std::cout << "Latency p50: " << p50 << " us; p99: " << p99 << " us" << std::endl;
+
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -330,4 +330,31 @@ TEST_F(ConditionalTests, Flat_Test_8) {
 
     delete graph;
 }
+
+/**
+ * Frames are propagated within session FlowPath, so nodes shared by sessions stay intact
+ */
+TEST_F(ConditionalTests, Flat_Test_9) {
+    auto graph = GraphExecutioner::importFromFlatBuffers("./resources/simplewhile_1.fb");
+    graph->getVariableSpace()->getVariable(1)->getNDArray()->assign(-4.0f);
+    graph->getVariableSpace()->getVariable(2)->getNDArray()->assign(1.0f);
+    graph->buildGraph();
+
+    std::map<int, Nd4jLong> frames;
+    for (auto &v: *graph->getMapped())
+        frames[v.first] = v.second->getFrameId();
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {-1, -1, -1, -1});
+    for (int e = 0; e < 2; e++) {
+        auto session = graph->createSession();
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+        ASSERT_TRUE(exp.equalsTo(session->getVariableSpace()->getVariable(25)->getNDArray()));
+        delete session;
+    }
+
+    for (auto &v: *graph->getMapped())
+        ASSERT_EQ(frames[v.first], v.second->getFrameId());
+
+    delete graph;
+}
 #endif
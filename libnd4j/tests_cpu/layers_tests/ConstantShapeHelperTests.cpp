@@ -24,6 +24,10 @@
 #include <ShapeDescriptor.h>
 #include <array/ConstantDataBuffer.h>
 #include <helpers/PointersManager.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/EpochManager.h>
+#include <NativeOps.h>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -186,4 +190,160 @@ TEST_F(ConstantShapeHelperTests, ShapeDescriptor_1) {
     ShapeDescriptor descr2(shapeInfo2);
 
     ASSERT_FALSE(descr1 == descr2);
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConstantShapeHelperTests, ShapeDescriptor_Hash_1) {
+
+    ShapeDescriptor descr1(nd4j::DataType::FLOAT32, 'c', {2, 3, 4});
+    ShapeDescriptor descr2(nd4j::DataType::FLOAT32, 'c', {2, 3, 4});
+    ShapeDescriptor descr3(nd4j::DataType::FLOAT32, 'f', {2, 3, 4});
+
+    ASSERT_EQ(descr1.hash(), descr2.hash());
+    ASSERT_NE(descr1.hash(), descr3.hash());
+
+    TadDescriptor tad1(descr1, {2, 1});
+    TadDescriptor tad2(descr2, {1, 2});
+    TadDescriptor tad3(descr1, {1});
+
+    ASSERT_EQ(tad1.hash(), tad2.hash());
+    ASSERT_NE(tad1.hash(), tad3.hash());
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConstantShapeHelperTests, Concurrent_Lookups_1) {
+    const int numThreads = 8;
+    const int numShapes = 512;
+
+    // all threads are racing for the same new shapes, and have to get exactly the same buffers
+    std::vector<std::vector<Nd4jLong*>> shapes(numThreads);
+    std::vector<std::vector<Nd4jLong*>> offsets(numThreads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < numThreads; t++)
+        threads.emplace_back(std::thread([&, t] {
+            for (int e = 0; e < numShapes; e++) {
+                auto shapeInfo = ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::DOUBLE, 'c', {e + 1, 7, 3});
+                shapes[t].emplace_back(shapeInfo);
+                offsets[t].emplace_back(ConstantTadHelper::getInstance()->tadForDimensions(shapeInfo, {0, 2}).primaryOffsets());
+            }
+        }));
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 1; t < numThreads; t++) {
+        ASSERT_EQ(shapes[0], shapes[t]);
+        ASSERT_EQ(offsets[0], offsets[t]);
+    }
+
+    for (int e = 0; e < numShapes; e++) {
+        ASSERT_EQ(e + 1, shape::sizeAt(shapes[0][e], 0));
+        ASSERT_EQ(7, ConstantTadHelper::getInstance()->tadForDimensions(shapes[0][e], {0, 2}).numberOfTads());
+    }
+}
+
+// device caches are never evicted
+#ifndef __CUDABLAS__
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConstantShapeHelperTests, Cache_Eviction_1) {
+    const int numShapes = 20000;
+    auto helper = ConstantShapeHelper::getInstance();
+
+    // this shape is pinned by alive array, so it must survive eviction
+    NDArray x('c', {3, 5, 7, 11, 13}, nd4j::DataType::FLOAT32);
+    auto pinned = x.shapeInfo();
+
+    auto evictions = helper->cacheEvictions();
+    auto entries = helper->cachedEntries();
+
+    nd4j::Environment::getInstance()->setShapeCacheLimit(256 * 1024);
+
+    for (int e = 0; e < numShapes; e++)
+        helper->createShapeInfo(nd4j::DataType::INT16, 'f', {e + 1, 3, 17});
+
+    nd4j::Environment::getInstance()->setShapeCacheLimit(0);
+
+    ASSERT_LT(evictions, helper->cacheEvictions());
+    ASSERT_GT(entries + numShapes / 2, helper->cachedEntries());
+
+    ASSERT_EQ(pinned, helper->createShapeInfo(nd4j::DataType::FLOAT32, 'c', {3, 5, 7, 11, 13}));
+    ASSERT_EQ(15015, shape::length(pinned));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConstantShapeHelperTests, Cache_Eviction_2) {
+    const int numShapes = 20000;
+    auto helper = ConstantTadHelper::getInstance();
+
+    // this copy pins pack, so its buffers must survive eviction
+    auto shapeInfo = ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::FLOAT32, 'c', {7, 11, 13});
+    auto pack = helper->tadForDimensions(shapeInfo, {0, 2});
+    std::vector<Nd4jLong> offsets(pack.primaryOffsets(), pack.primaryOffsets() + pack.numberOfTads());
+    ASSERT_EQ(2, pack.pins());
+
+    auto evictions = helper->cacheEvictions();
+
+    nd4j::Environment::getInstance()->setTadCacheLimit(64 * 1024);
+
+    for (int e = 0; e < numShapes; e++)
+        helper->tadForDimensions(ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::INT16, 'f', {e + 1, 3, 17}), {1});
+
+    nd4j::Environment::getInstance()->setTadCacheLimit(0);
+
+    ASSERT_LT(evictions, helper->cacheEvictions());
+
+    ASSERT_EQ(11, pack.numberOfTads());
+    for (int e = 0; e < (int) offsets.size(); e++)
+        ASSERT_EQ(offsets[e], pack.primaryOffsets()[e]);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConstantShapeHelperTests, Cache_Eviction_3) {
+    auto helper = ConstantShapeHelper::getInstance();
+    NativeOps ops;
+
+    // shapes handed out to Java stay pinned until they're released explicitly
+    Nd4jLong shape[] = {5, 7, 19, 3};
+    Nd4jLong strides[] = {399, 57, 3, 1};
+    auto buffer = ops.shapeBuffer(4, shape, strides, nd4j::DataType::DOUBLE, 'c', 1, false);
+    auto pinned = buffer->primaryAsT<Nd4jLong>();
+
+    auto evictions = helper->cacheEvictions();
+    nd4j::Environment::getInstance()->setShapeCacheLimit(256 * 1024);
+
+    for (int e = 0; e < 20000; e++)
+        helper->createShapeInfo(nd4j::DataType::INT32, 'f', {e + 1, 9, 2});
+
+    nd4j::Environment::getInstance()->setShapeCacheLimit(0);
+
+    ASSERT_LT(evictions, helper->cacheEvictions());
+    ASSERT_EQ(pinned, helper->createShapeInfo(nd4j::DataType::DOUBLE, 'c', {5, 7, 19, 3}));
+    ASSERT_EQ(1995, shape::length(pinned));
+
+    ops.deleteShapeBuffer(buffer);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConstantShapeHelperTests, Epoch_Guard_1) {
+    auto manager = EpochManager::getInstance();
+    Nd4jLong epoch = 0;
+
+    {
+        EpochGuard guard;
+        epoch = manager->retire();
+
+        // this thread might still use memory retired while it's within guard
+        ASSERT_LE(manager->safeEpoch(), epoch);
+
+        {
+            EpochGuard nested;
+            ASSERT_LE(manager->safeEpoch(), epoch);
+        }
+
+        ASSERT_LE(manager->safeEpoch(), epoch);
+    }
+
+    ASSERT_GT(manager->safeEpoch(), epoch);
+}
+#endif
@@ -31,6 +31,7 @@
 #include <NativeOps.h>
 #include <ops/gemm.h>
 #include <helpers/PointersManager.h>
+#include <helpers/ConstantShapeHelper.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -3917,3 +3918,84 @@ TEST_F(DeclarableOpsTests1, Test_Release) {
     // x.printShapeInfo("x shape");
 }
 
+
+TEST_F(DeclarableOpsTests1, Test_Shape_Cache_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<float>('c', {4, 5});
+    auto w = NDArrayFactory::create<float>('c', {4, 7});
+
+    nd4j::ops::matmul op;
+    ASSERT_EQ(0, op.shapeCacheSize());
+
+    for (int e = 0; e < 3; e++) {
+        auto result = op.execute({&x, &y}, {}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+        ASSERT_EQ(std::vector<Nd4jLong>({3, 5}), result->at(0)->getShapeAsVector());
+        delete result;
+    }
+
+    ASSERT_EQ(1, op.shapeCacheSize());
+
+    auto result = op.execute({&x, &w}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(std::vector<Nd4jLong>({3, 7}), result->at(0)->getShapeAsVector());
+    delete result;
+
+    ASSERT_EQ(2, op.shapeCacheSize());
+
+    op.purgeShapeCache();
+    ASSERT_EQ(0, op.shapeCacheSize());
+}
+
+TEST_F(DeclarableOpsTests1, Test_Shape_Cache_2) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto s0 = NDArrayFactory::create<Nd4jLong>('c', {2}, {2, 6});
+    auto s1 = NDArrayFactory::create<Nd4jLong>('c', {2}, {6, 2});
+
+    // reshape reads shape from input values, so its output shapes must not be memoized
+    nd4j::ops::reshape op;
+    auto result0 = op.execute({&x, &s0}, {}, {});
+    auto result1 = op.execute({&x, &s1}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result0->status());
+    ASSERT_EQ(ND4J_STATUS_OK, result1->status());
+    ASSERT_EQ(std::vector<Nd4jLong>({2, 6}), result0->at(0)->getShapeAsVector());
+    ASSERT_EQ(std::vector<Nd4jLong>({6, 2}), result1->at(0)->getShapeAsVector());
+    ASSERT_EQ(0, op.shapeCacheSize());
+
+    delete result0;
+    delete result1;
+}
+
+// device shape caches are never evicted
+#ifndef __CUDABLAS__
+TEST_F(DeclarableOpsTests1, Test_Shape_Cache_3) {
+    auto x = NDArrayFactory::create<float>('c', {3, 401});
+    auto y = NDArrayFactory::create<float>('c', {401, 389});
+    auto helper = ConstantShapeHelper::getInstance();
+
+    nd4j::ops::matmul op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    auto memoized = result->at(0)->shapeInfo();
+    delete result;
+
+    // memoized shape isn't used by any array now, but op cache keeps it pinned
+    auto evictions = helper->cacheEvictions();
+    nd4j::Environment::getInstance()->setShapeCacheLimit(256 * 1024);
+
+    for (int e = 0; e < 20000; e++)
+        helper->createShapeInfo(nd4j::DataType::INT8, 'c', {e + 1, 5, 19});
+
+    nd4j::Environment::getInstance()->setShapeCacheLimit(0);
+    ASSERT_LT(evictions, helper->cacheEvictions());
+
+    result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(std::vector<Nd4jLong>({3, 389}), result->at(0)->getShapeAsVector());
+    ASSERT_EQ(memoized, helper->createShapeInfo(nd4j::DataType::FLOAT32, 'c', {3, 389}));
+    delete result;
+
+    op.purgeShapeCache();
+}
+#endif
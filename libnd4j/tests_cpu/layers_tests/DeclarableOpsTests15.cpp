@@ -335,3 +335,38 @@ TEST_F(DeclarableOpsTests15, test_lstmBlock_2) {
 
     delete result;
 }
+
+TEST_F(DeclarableOpsTests15, test_fused_matmul_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<float>('f', {5, 4});
+    auto b = NDArrayFactory::create<float>('c', {5}, {0.5f, -0.5f, 1.0f, -1.0f, 0.0f});
+    auto bz = NDArrayFactory::create<float>('c', {3}, {0.25f, -0.25f, 0.0f});
+    x.linspace(-1.0, 0.2);
+    y.linspace(0.5, -0.1);
+
+    nd4j::ops::matmul matmul;
+    nd4j::ops::biasadd biasadd;
+    nd4j::ops::relu relu;
+    nd4j::ops::fused_matmul op;
+
+    // x * y^T + b -> relu
+    auto r1 = matmul.execute({&x, &y}, {}, {0, 1});
+    auto r2 = biasadd.execute({r1->at(0), &b}, {}, {});
+    auto r3 = relu.execute({r2->at(0)}, {0.0}, {});
+
+    auto result = op.execute({&x, &y, &b}, {0.0}, {0, 1, 0, 1});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(r3->at(0)->equalsTo(result->at(0)));
+
+    // (x * y^T)^T + bz -> tanh
+    auto r4 = matmul.execute({&x, &y}, {}, {0, 1, 1});
+    auto r5 = biasadd.execute({r4->at(0), &bz}, {}, {});
+    auto exp = r5->at(0)->transform(transform::Tanh);
+
+    auto result2 = op.execute({&x, &y, &bz}, {}, {0, 1, 1, 4});
+    ASSERT_EQ(Status::OK(), result2->status());
+    ASSERT_TRUE(exp.equalsTo(result2->at(0)));
+
+    for (auto r: {r1, r2, r3, r4, r5, result, result2})
+        delete r;
+}
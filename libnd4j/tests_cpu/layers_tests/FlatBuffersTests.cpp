@@ -26,6 +26,7 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <GraphExecutioner.h>
+#include <graph/FlatUtils.h>
 #include <ops/declarable/CustomOperations.h>
 
 using namespace nd4j;
@@ -603,6 +604,30 @@ TEST_F(FlatBuffersTest, ReduceDim_2) {
 }
  */
 
+TEST_F(FlatBuffersTest, Test_ToFlatArray_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 5});
+    x.linspace(1.0);
+
+    // dense array, strided view and permuted view
+    auto column = x({0,0, 1,2});
+    auto transposed = x.transpose();
+
+    for (auto array: {&x, &column, &transposed}) {
+        flatbuffers::FlatBufferBuilder builder(1024);
+        builder.Finish(FlatUtils::toFlatArray(builder, *array));
+
+        auto flatArray = flatbuffers::GetRoot<FlatArray>(builder.GetBufferPointer());
+        ASSERT_EQ(array->lengthOf() * (Nd4jLong) array->sizeOfT(), (Nd4jLong) flatArray->buffer()->size());
+        ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(flatArray->buffer()->data()) % array->sizeOfT());
+
+        auto restored = FlatUtils::fromFlatArray(flatArray);
+        ASSERT_TRUE(array->isSameShape(restored));
+        ASSERT_TRUE(array->equalsTo(restored));
+
+        delete restored;
+    }
+}
+
 #ifdef GRAPH_FILES_OK
 TEST_F(FlatBuffersTest, Ae_00) {
     nd4j::ops::rank op1;
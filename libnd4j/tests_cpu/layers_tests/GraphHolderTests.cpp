@@ -20,6 +20,7 @@
 
 #include "testlayers.h"
 #include <graph/GraphHolder.h>
+#include <helpers/NumaHelper.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -83,4 +84,206 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphHolderTests, SessionTests_1) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 121;
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto sessionA = GraphHolder::getInstance()->cloneGraph(graphId);
+    auto sessionB = GraphHolder::getInstance()->cloneGraph(graphId);
+
+    ASSERT_TRUE(sessionA->isSession());
+    ASSERT_EQ(graph->getOnion(), sessionA->getOnion());
+    ASSERT_EQ(graph->getMapped(), sessionB->getMapped());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionA));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionB));
+
+    auto zA = sessionA->getVariableSpace()->getVariable(3)->getNDArray();
+    auto zB = sessionB->getVariableSpace()->getVariable(3)->getNDArray();
+
+    ASSERT_TRUE(zA != zB);
+    ASSERT_NEAR(0.4161468, zA->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+    ASSERT_NEAR(0.4161468, zB->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    // outputs live within sessions only
+    ASSERT_FALSE(graph->getVariableSpace()->getVariable(3)->hasNDArray());
+
+    delete sessionA;
+    delete sessionB;
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, Test_Replace_1) {
+    Nd4jLong graphId = 122;
+
+    auto buildGraph = [](float value) -> Graph* {
+        auto graph = new Graph;
+        auto x = NDArrayFactory::create_<float>('c', {5, 5});
+        x->assign(value);
+        graph->getVariableSpace()->putVariable(-1, x);
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+        return graph;
+    };
+
+    auto graphA = buildGraph(-2.0f);
+    auto graphB = buildGraph(-3.0f);
+
+    GraphHolder::getInstance()->registerGraph(graphId, graphA);
+
+    // in-flight requests: handle & session, both started before replacement
+    auto handle = GraphHolder::getInstance()->acquireGraph(graphId);
+    auto session = GraphHolder::getInstance()->cloneGraph(graphId);
+
+    GraphHolder::getInstance()->replaceGraph(graphId, graphB);
+
+    ASSERT_TRUE(GraphHolder::getInstance()->hasGraph(graphId));
+    ASSERT_TRUE(graphA == handle.get());
+    ASSERT_TRUE(graphB == GraphHolder::getInstance()->acquireGraph(graphId).get());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+    ASSERT_NEAR(2.0f, session->getVariableSpace()->getVariable(1)->getNDArray()->e<float>(0), 1e-5);
+
+    auto sessionB = GraphHolder::getInstance()->cloneGraph(graphId);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionB));
+    ASSERT_NEAR(3.0f, sessionB->getVariableSpace()->getVariable(1)->getNDArray()->e<float>(0), 1e-5);
+
+    // graphA is released together with last reference to it
+    delete session;
+    handle.reset();
+
+    delete sessionB;
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+    ASSERT_TRUE(GraphHolder::getInstance()->acquireGraph(graphId) == nullptr);
+}
+
+TEST_F(GraphHolderTests, Test_WarmUp_1) {
+    Nd4jLong graphId = 123;
+    auto graph = new Graph;
+
+    auto placeholder = new Variable(true);
+    placeholder->shape() = {-1, 4};
+    graph->getVariableSpace()->putVariable(-1, placeholder);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+
+    ASSERT_EQ(-1L, graph->getWarmUpTime());
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    ASSERT_TRUE(graph->getWarmUpTime() >= 0L);
+
+    // synthetic placeholder doesn't leak into original graph
+    ASSERT_FALSE(graph->getVariableSpace()->getVariable(-1)->hasNDArray());
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 4});
+    x->assign(-1.0f);
+
+    auto session = GraphHolder::getInstance()->cloneGraph(graphId);
+    session->getVariableSpace()->putVariable(-1, x);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+
+    auto z = session->getVariableSpace()->getVariable(1)->getNDArray();
+    ASSERT_TRUE(z->isSameShape(x));
+    ASSERT_NEAR(1.0f, z->e<float>(0), 1e-5);
+
+    delete session;
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, Test_WarmUp_2) {
+    Nd4jLong graphId = 125;
+    auto graph = new Graph;
+    graph->setMemoryPlanning(true);
+
+    auto placeholder = new Variable(true);
+    placeholder->shape() = {-1, 4};
+    graph->getVariableSpace()->putVariable(-1, placeholder);
+
+    for (int e = 1; e <= 4; e++)
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, e, {e == 1 ? -1 : e - 1}, {}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+    ASSERT_TRUE(graph->getWarmUpTime() >= 0L);
+
+    // warm-up had to make up batch size, so plan is left to the first real request
+    ASSERT_TRUE(graph->getMemoryPlan() == nullptr);
+
+    for (int r = 0; r < 2; r++) {
+        auto x = NDArrayFactory::create_<float>('c', {8, 4});
+        x->assign(-1.0f);
+
+        std::unique_ptr<Graph> session(GraphHolder::getInstance()->cloneGraph(graphId));
+        session->getVariableSpace()->putVariable(-1, x);
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session.get()));
+        ASSERT_NEAR(1.0f, session->getVariableSpace()->getVariable(4)->getNDArray()->e<float>(31), 1e-5);
+
+        ASSERT_TRUE(graph->getMemoryPlan() != nullptr);
+        ASSERT_EQ(8 * 4 * 4, graph->getMemoryPlan()->size({1, 0}));
+
+        // second request places intermediates within arena: arrays 1 and 3 share the same region
+        if (r > 0) {
+            auto vs = session->getVariableSpace();
+            ASSERT_EQ(graph->getMemoryPlan()->getPeakBytes(), vs->arenaSize());
+            ASSERT_TRUE(vs->getVariable(1)->getNDArray()->getBuffer() == vs->getVariable(3)->getNDArray()->getBuffer());
+        }
+    }
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, Test_Numa_1) {
+    Nd4jLong graphId = 124;
+    auto graph = new Graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 4});
+    x->assign(-2.0f);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    Environment::getInstance()->setNumaReplication(true);
+
+    auto numa = NumaHelper::getInstance();
+    for (int node = 0; node < numa->numberOfNodes(); node++) {
+        std::unique_ptr<Graph> session(graph->createSession(node));
+        ASSERT_EQ(node, session->numaNode());
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session.get()));
+
+        auto z = session->getVariableSpace()->getVariable(1)->getNDArray();
+        ASSERT_NEAR(2.0f, z->e<float>(0), 1e-5);
+
+        // on multi-node machines session reads its own copy of variables, single-node machines just share them
+        auto input = session->getVariableSpace()->getVariable(-1)->getNDArray();
+        ASSERT_EQ(numa->isAvailable(), input != x);
+        ASSERT_TRUE(input->equalsTo(x));
+    }
+
+    // thread is released once session is executed
+    ASSERT_EQ(-1, numa->boundNode());
+
+    Environment::getInstance()->setNumaReplication(false);
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
@@ -25,9 +25,12 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <graph/GraphUtils.h>
+#include <graph/GraphCompiler.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
+#include <fstream>
+#include <memory>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -1600,6 +1603,453 @@ TEST_F(GraphTests, Test_Inplace_Outputs_2) {
 #endif
 }
 
+static Graph* buildWideGraph(ExecutionMode mode) {
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_executionMode = mode;
+
+    auto x = NDArrayFactory::create_<float>('c', {16, 16});
+    x->linspace(-1.0, 0.01);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // 8 independent branches of 2 nodes each, joined by single node at the end
+    for (int b = 0; b < 8; b++) {
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, b * 2 + 1, {-1}, {b * 2 + 2}));
+        graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, b * 2 + 2, {b * 2 + 1}, {}));
+    }
+
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 100, {2, 16}, {}));
+
+    return graph;
+}
+
+TEST_F(GraphTests, Test_ExecutionMode_Auto_1) {
+    auto graphS = buildWideGraph(ExecutionMode_SEQUENTIAL);
+    auto graphA = buildWideGraph(ExecutionMode_AUTO);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graphS));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graphA));
+
+    for (int e = 1; e <= 16; e++) {
+        auto expected = graphS->getVariableSpace()->getVariable(e)->getNDArray();
+        auto actual = graphA->getVariableSpace()->getVariable(e)->getNDArray();
+
+        ASSERT_TRUE(expected->equalsTo(actual));
+    }
+
+    auto expected = graphS->getVariableSpace()->getVariable(100)->getNDArray();
+    auto actual = graphA->getVariableSpace()->getVariable(100)->getNDArray();
+    ASSERT_TRUE(expected->equalsTo(actual));
+
+    delete graphS;
+    delete graphA;
+}
+
+TEST_F(GraphTests, Test_MemoryPlan_1) {
+    auto graph = new Graph();
+    graph->setMemoryPlanning(true);
+
+    auto x = NDArrayFactory::create_<float>('c', {16, 16});
+    x->linspace(-1.0, 0.01);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // simple chain: only 2 intermediate arrays are alive at any moment
+    for (int e = 1; e <= 6; e++) {
+        if (e % 2 == 1)
+            graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, e, {e == 1 ? -1 : e - 1}, {e + 1}));
+        else
+            graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, e, {e - 1}, {}));
+    }
+
+    // first run provides array sizes for the plan
+    auto sessionA = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionA));
+
+    auto plan = graph->getMemoryPlan();
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_EQ(5, plan->numberOfArrays());
+
+    ASSERT_EQ(2 * 1024, plan->getPeakBytes());
+    ASSERT_EQ(5 * 1024, plan->getTotalBytes());
+
+    nd4j::memory::MemoryReport report;
+    ASSERT_TRUE(graph->reportMemoryPlan(report));
+    ASSERT_EQ(2 * 1024, report.getPlannedPeak());
+    ASSERT_EQ(5 * 1024, report.getPlannedTotal());
+
+    // second run places intermediate arrays within arena
+    auto sessionB = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionB));
+
+    // arena allocated by session is exactly as large as reported peak
+    auto varSpace = sessionB->getVariableSpace();
+    ASSERT_EQ(report.getPlannedPeak(), varSpace->arenaSize());
+    ASSERT_TRUE(varSpace->getVariable(1)->getNDArray()->getBuffer() == varSpace->getVariable(5)->getNDArray()->getBuffer());
+    ASSERT_TRUE(varSpace->getVariable(2)->getNDArray()->getBuffer() == varSpace->getVariable(4)->getNDArray()->getBuffer());
+
+    auto expected = sessionA->getVariableSpace()->getVariable(6)->getNDArray();
+    auto result = varSpace->getVariable(6)->getNDArray();
+    ASSERT_TRUE(expected->equalsTo(result));
+
+    delete sessionA;
+    delete sessionB;
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_MemoryPlan_2) {
+    auto graph = new Graph();
+    graph->setMemoryPlanning(true);
+
+    auto x = NDArrayFactory::create_<float>('c', {16, 16});
+    x->linspace(-1.0, 0.01);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // node 2 overwrites output of node 1, which is consumed later by node 4, so array 1 is alive until the last layer
+    auto nodeB = new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3, 4});
+    nodeB->markInplace(true);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+    graph->addNode(nodeB);
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 4, {2, 3}, {}));
+
+    auto sessionA = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionA));
+
+    auto plan = graph->getMemoryPlan();
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_TRUE(plan->isPlanned({1, 0}));
+    ASSERT_TRUE(plan->isPlanned({3, 0}));
+    ASSERT_FALSE(plan->isPlanned({2, 0}));
+    ASSERT_NE(plan->offset({1, 0}), plan->offset({3, 0}));
+
+    auto sessionB = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(sessionB));
+
+    auto expected = sessionA->getVariableSpace()->getVariable(4)->getNDArray();
+    auto result = sessionB->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(expected->equalsTo(result));
+
+    delete sessionA;
+    delete sessionB;
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Optimizer_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 4});
+    x->linspace(-1.0, 0.125);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto c = NDArrayFactory::create_<float>('c', {4, 4});
+    c->assign(-2.0f);
+    graph->getVariableSpace()->putVariable(-2, c);
+    graph->getVariableSpace()->getVariable(-2)->markConstant(true);
+
+    // nodes 1 & 2 depend on constant only
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-2}, {}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {}));
+
+    // node 3 is Identity
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Identity, 3, {-1}, {}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 4, {3, 2}, {}));
+
+    // nodes 5 & 6 are equal
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 5, {-1}, {}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 6, {-1}, {}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 7, {5, 6}, {}));
+
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Multiply, 8, {4, 7}, {}));
+
+    auto stats = graph->optimize();
+    ASSERT_TRUE(graph->isOptimized());
+    ASSERT_EQ(8, stats.nodesBefore);
+    ASSERT_EQ(4, stats.nodesAfter);
+    ASSERT_EQ(2, stats.foldedNodes);
+    ASSERT_EQ(1, stats.collapsedNodes);
+    ASSERT_EQ(1, stats.mergedNodes);
+    ASSERT_EQ(0, stats.deadNodes);
+
+    ASSERT_FALSE(graph->hasNode(2));
+    ASSERT_FALSE(graph->hasNode(3));
+    ASSERT_FALSE(graph->hasNode(6));
+
+    auto session = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+
+    auto a = c->transform(transform::Abs).transform(transform::Cosine);
+    auto b = x->transform(transform::Abs);
+    auto exp = (*x + a) * (b + b);
+
+    ASSERT_EQ(exp, *session->getVariableSpace()->getVariable(8)->getNDArray());
+
+    delete session;
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Optimizer_2) {
+    nd4j::ops::dropout dropout;
+
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 4});
+    x->linspace(-1.0, 0.125);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto c = NDArrayFactory::create_<float>('c', {4, 4});
+    c->linspace(-2.0, 0.25);
+    graph->getVariableSpace()->putVariable(-2, c);
+    graph->getVariableSpace()->getVariable(-2)->markConstant(true);
+
+    // node 1 depends on constant only, but it's graph output
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-2}, {}));
+
+    // node 2 depends on constant only, but it consumes RNG state
+    graph->addNode(new Node(&dropout, 2, {-2}, {}, {}, 0.0f, {0.5}, {119}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 3, {2, -1}, {}));
+
+    auto stats = graph->optimize();
+    ASSERT_EQ(3, stats.nodesBefore);
+    ASSERT_EQ(3, stats.nodesAfter);
+    ASSERT_EQ(0, stats.foldedNodes);
+
+    ASSERT_TRUE(graph->hasNode(1));
+    ASSERT_TRUE(graph->hasNode(2));
+
+    auto session = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+
+    auto exp = c->transform(transform::Abs);
+    ASSERT_EQ(exp, *session->getVariableSpace()->getVariable(1)->getNDArray());
+
+    delete session;
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Optimizer_Fusion_1) {
+    nd4j::ops::conv2d conv2d;
+    nd4j::ops::biasadd biasadd;
+    nd4j::ops::batchnorm batchnorm;
+    nd4j::ops::relu relu;
+    nd4j::ops::matmul matmul;
+    nd4j::ops::sigmoid sigmoid;
+
+    auto x = NDArrayFactory::create<float>('c', {1, 4, 4, 2});
+    auto w = NDArrayFactory::create<float>('c', {2, 2, 2, 3});
+    auto b = NDArrayFactory::create<float>('c', {3}, {0.1f, -0.2f, 0.3f});
+    auto mean = NDArrayFactory::create<float>('c', {3}, {0.5f, -0.5f, 1.0f});
+    auto variance = NDArrayFactory::create<float>('c', {3}, {1.0f, 2.0f, 0.5f});
+    auto gamma = NDArrayFactory::create<float>('c', {3}, {1.5f, 0.5f, -1.0f});
+    auto beta = NDArrayFactory::create<float>('c', {3}, {0.2f, 0.1f, -0.3f});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+    auto v = NDArrayFactory::create<float>('c', {3, 4});
+    auto c = NDArrayFactory::create<float>('c', {4}, {1.0f, -1.0f, 0.5f, -0.5f});
+    x.linspace(-1.0, 0.1);
+    w.linspace(-0.5, 0.05);
+    y.linspace(-0.3, 0.1);
+    v.linspace(0.2, -0.05);
+
+    auto graph = new Graph();
+    auto variableSpace = graph->getVariableSpace();
+    variableSpace->putVariable(-1, x.dup());
+    variableSpace->putVariable(-8, y.dup());
+
+    // weights & batchnorm parameters are constants
+    std::vector<NDArray*> constants({&w, &b, &mean, &variance, &gamma, &beta, nullptr, &v, &c});
+    for (int e = 0; e < (int) constants.size(); e++) {
+        if (constants[e] == nullptr)
+            continue;
+
+        variableSpace->putVariable(-2 - e, constants[e]->dup());
+        variableSpace->getVariable(-2 - e)->markConstant(true);
+    }
+
+    // NHWC conv2d -> biasadd -> batchnorm -> relu
+    graph->addNode(new Node(&conv2d, 1, {-1, -2}, {}, {}, 0.0f, {}, {2, 2, 1, 1, 0, 0, 1, 1, 1, 1}));
+    graph->addNode(new Node(&biasadd, 2, {1, -3}, {}, {}, 0.0f, {}, {}));
+    graph->addNode(new Node(&batchnorm, 3, {2, -4, -5, -6, -7}, {}, {}, 0.0f, {1e-3}, {1, 1}));
+    graph->addNode(new Node(&relu, 4, {3}, {}, {}, 0.0f, {0.0}, {}));
+
+    // matmul -> biasadd -> sigmoid
+    graph->addNode(new Node(&matmul, 5, {-8, -9}, {}, {}, 0.0f, {}, {}));
+    graph->addNode(new Node(&biasadd, 6, {5, -10}, {}, {}, 0.0f, {}, {}));
+    graph->addNode(new Node(&sigmoid, 7, {6}, {}, {}, 0.0f, {}, {}));
+
+    auto stats = graph->optimize();
+    ASSERT_EQ(7, stats.nodesBefore);
+    ASSERT_EQ(2, stats.nodesAfter);
+    ASSERT_EQ(5, stats.fusedNodes);
+
+    ASSERT_TRUE(graph->hasNode(4));
+    ASSERT_TRUE(graph->hasNode(7));
+    ASSERT_EQ(std::string("fused_conv2d"), *graph->nodeById(4)->getCustomOp()->getOpName());
+    ASSERT_EQ(std::string("fused_matmul"), *graph->nodeById(7)->getCustomOp()->getOpName());
+
+    auto session = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+
+    // the same ops executed one by one
+    auto r1 = conv2d.execute({&x, &w}, {}, {2, 2, 1, 1, 0, 0, 1, 1, 1, 1});
+    auto r2 = biasadd.execute({r1->at(0), &b}, {}, {});
+    auto r3 = batchnorm.execute({r2->at(0), &mean, &variance, &gamma, &beta}, {1e-3}, {1, 1});
+    auto r4 = relu.execute({r3->at(0)}, {0.0}, {});
+
+    auto r5 = matmul.execute({&y, &v}, {}, {});
+    auto r6 = biasadd.execute({r5->at(0), &c}, {}, {});
+    auto r7 = sigmoid.execute({r6->at(0)}, {}, {});
+
+    ASSERT_TRUE(r4->at(0)->equalsTo(session->getVariableSpace()->getVariable(4)->getNDArray()));
+    ASSERT_TRUE(r7->at(0)->equalsTo(session->getVariableSpace()->getVariable(7)->getNDArray()));
+
+    for (auto r: {r1, r2, r3, r4, r5, r6, r7})
+        delete r;
+
+    delete session;
+    delete graph;
+}
+
+#ifdef GRAPH_COMPILER_COMMAND
+/**
+ * This function builds generated source with the driver dumping compiled graph outputs, runs it,
+ * and compares dumped outputs with expected arrays
+ */
+static bool runCompiled(const std::string &source, const std::string &ns, const std::vector<NDArray*> &expected) {
+    auto sourceFile = ns + ".cpp";
+    auto binaryFile = "./" + ns + ".bin";
+
+    std::ofstream out(sourceFile);
+    out << source;
+    out << "\n#include <fstream>\n\n";
+    out << "int main() {\n";
+    out << "    if (" << ns << "::execute() != ND4J_STATUS_OK)\n";
+    out << "        return 1;\n\n";
+    out << "    for (int o = 0; o < " << ns << "::numberOfOutputs(); o++) {\n";
+    out << "        auto array = " << ns << "::output(o);\n";
+    out << "        std::ofstream file(\"" << ns << "_\" + std::to_string(o) + \".out\", std::ios::binary);\n";
+    out << "        file.write(reinterpret_cast<char *>(array->getBuffer()), array->lengthOf() * array->sizeOfT());\n";
+    out << "    }\n\n";
+    out << "    return 0;\n";
+    out << "}\n";
+    out.close();
+
+    auto command = std::string(GRAPH_COMPILER_COMMAND) + " -o " + binaryFile + " " + sourceFile + " " + GRAPH_COMPILER_LIBRARIES;
+    bool result = std::system(command.c_str()) == 0 && std::system(binaryFile.c_str()) == 0;
+
+    for (int o = 0; o < (int) expected.size(); o++) {
+        auto outputFile = ns + "_" + std::to_string(o) + ".out";
+
+        // compiled graph keeps outputs dense, in the same order as interpreter does
+        std::unique_ptr<NDArray> actual(expected[o]->dup(expected[o]->ordering()));
+        std::ifstream file(outputFile, std::ios::binary);
+        result = result && file.read(reinterpret_cast<char *>(actual->getBuffer()), actual->lengthOf() * actual->sizeOfT()).good();
+        result = result && expected[o]->equalsTo(actual.get());
+
+        unlink(outputFile.c_str());
+    }
+
+    unlink(sourceFile.c_str());
+    unlink(binaryFile.c_str());
+
+    return result;
+}
+#endif
+
+TEST_F(GraphTests, Test_Compiler_1) {
+    nd4j::ops::matmul matmul;
+    nd4j::ops::sigmoid sigmoid;
+
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {3, 4});
+    x.linspace(1.0);
+    y.linspace(0.1, 0.1);
+
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, x.dup());
+    graph->getVariableSpace()->putVariable(-2, y.dup());
+    graph->getVariableSpace()->getVariable(-2)->markConstant(true);
+
+    graph->addNode(new Node(&matmul, 1, {-1, -2}, {}, {}, 0.0f, {}, {}));
+    graph->addNode(new Node(&sigmoid, 2, {1}, {}, {}, 0.0f, {}, {}));
+    graph->addOutput(2);
+
+    auto source = GraphCompiler::compile(graph, "test_graph", false);
+
+    ASSERT_NE(std::string::npos, source.find("namespace test_graph {"));
+    ASSERT_NE(std::string::npos, source.find("static nd4j::ops::matmul op_1;"));
+    ASSERT_NE(std::string::npos, source.find("static nd4j::ops::sigmoid op_2;"));
+    ASSERT_NE(std::string::npos, source.find("context_2.setInputArray(0, &array_1_0);"));
+
+    // only non-constant variable is exposed as input
+    ASSERT_NE(std::string::npos, source.find("static nd4j::NDArray* inputs[] = {&array_m1_0};"));
+    ASSERT_NE(std::string::npos, source.find("static nd4j::NDArray* outputs[] = {&array_2_0};"));
+    ASSERT_EQ(std::string::npos, source.find("int main("));
+
+#ifdef GRAPH_COMPILER_COMMAND
+    auto session = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+
+    auto expected = session->getVariableSpace()->getVariable(2)->getNDArray();
+    ASSERT_TRUE(runCompiled(source, "test_graph", {expected}));
+
+    delete session;
+#endif
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Compiler_2) {
+    nd4j::ops::add add;
+    nd4j::ops::matmul matmul;
+    nd4j::ops::tanh tanh;
+
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto a = NDArrayFactory::create<float>('c', {3, 4});
+    auto b = NDArrayFactory::create<float>('c', {3, 4});
+    x.linspace(1.0);
+    a.linspace(0.1, 0.1);
+    b.linspace(-0.5, 0.05);
+
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, x.dup());
+    graph->getVariableSpace()->putVariable(-2, a.dup());
+    graph->getVariableSpace()->putVariable(-3, b.dup());
+    graph->getVariableSpace()->getVariable(-2)->markConstant(true);
+    graph->getVariableSpace()->getVariable(-3)->markConstant(true);
+
+    // node 1 depends on constants only, so it gets folded by optimizer
+    graph->addNode(new Node(&add, 1, {-2, -3}, {}, {}, 0.0f, {}, {}));
+    graph->addNode(new Node(&matmul, 2, {-1, 1}, {}, {}, 0.0f, {}, {}));
+    graph->addNode(new Node(OpType_SCALAR, scalar::Add, 3, {2}, {}, {}, 1.5f));
+    graph->addNode(new Node(&tanh, 4, {3}, {}, {}, 0.0f, {}, {}));
+    graph->addOutput(3);
+    graph->addOutput(4);
+
+    auto source = GraphCompiler::compile(graph, "test_graph_2", false);
+
+    ASSERT_FALSE(graph->hasNode(1));
+
+    // result of folded node is stored as constant
+    ASSERT_NE(std::string::npos, source.find("static nd4j::NDArray array_1_0(buffer_1_0, shape_1_0);"));
+    ASSERT_EQ(std::string::npos, source.find("op_1"));
+    ASSERT_NE(std::string::npos, source.find("context_2.setInputArray(1, &array_1_0);"));
+    ASSERT_NE(std::string::npos, source.find("nd4j::NDArrayFactory::create("));
+    ASSERT_NE(std::string::npos, source.find("static nd4j::ops::LegacyScalarOp op_3("));
+    ASSERT_NE(std::string::npos, source.find("static nd4j::NDArray* inputs[] = {&array_m1_0};"));
+    ASSERT_NE(std::string::npos, source.find("static nd4j::NDArray* outputs[] = {&array_3_0, &array_4_0};"));
+
+#ifdef GRAPH_COMPILER_COMMAND
+    auto session = graph->createSession();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(session));
+
+    auto space = session->getVariableSpace();
+    ASSERT_TRUE(runCompiled(source, "test_graph_2", {space->getVariable(3)->getNDArray(), space->getVariable(4)->getNDArray()}));
+
+    delete session;
+#endif
+
+    delete graph;
+}
+
 /*
 TEST_F(GraphTests, Test_Minifier_1) {
     // run preprocessor to produce single header
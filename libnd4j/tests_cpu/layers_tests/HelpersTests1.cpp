@@ -1692,6 +1692,80 @@ TEST_F(HelpersTests1, mmulHelper_test_7) {
 
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_8) {
+
+    // mixed types go through blocked gemm: few K blocks, partial micro-tiles, transposed A
+    const Nd4jLong M = 67;
+    const Nd4jLong K = 300;
+    const Nd4jLong N = 131;
+
+    NDArray a('c', {M,K}, nd4j::DataType::INT32);
+    NDArray b('f', {K,N}, nd4j::DataType::FLOAT32);
+    NDArray c('f', {M,N}, nd4j::DataType::FLOAT32);
+
+    NDArray aD('c', {M,K}, nd4j::DataType::DOUBLE);
+    NDArray bD('f', {K,N}, nd4j::DataType::DOUBLE);
+    NDArray exp('f', {M,N}, nd4j::DataType::DOUBLE);
+
+    // values are chosen so that all sums are exact in float
+    for (Nd4jLong e = 0; e < a.lengthOf(); e++) {
+        a.p(e, (e * 7) % 13 - 6);
+        aD.p(e, (e * 7) % 13 - 6);
+    }
+
+    for (Nd4jLong e = 0; e < b.lengthOf(); e++) {
+        b.p(e, ((e * 5) % 11 - 5) * 0.125);
+        bD.p(e, ((e * 5) % 11 - 5) * 0.125);
+    }
+
+    MmulHelper::mmul(&a, &b, &c, 1., 0.);
+    MmulHelper::mmul(&aD, &bD, &exp, 1., 0.);
+
+    auto result = c.cast(nd4j::DataType::DOUBLE);
+    ASSERT_TRUE(exp.equalsTo(result));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_9) {
+
+    // half types are accumulated in fp32 across K blocks, and rounded only once
+    const Nd4jLong M = 37;
+    const Nd4jLong K = 1000;
+    const Nd4jLong N = 53;
+
+    for (auto dtype : {nd4j::DataType::HALF, nd4j::DataType::BFLOAT16}) {
+        NDArray a('c', {M,K}, dtype);
+        NDArray b('f', {K,N}, dtype);
+        NDArray c('c', {M,N}, dtype);
+
+        NDArray aD('c', {M,K}, nd4j::DataType::DOUBLE);
+        NDArray bD('f', {K,N}, nd4j::DataType::DOUBLE);
+        NDArray expD('c', {M,N}, nd4j::DataType::DOUBLE);
+
+        // all sums are exact in float, but not in half/bfloat16
+        for (Nd4jLong e = 0; e < a.lengthOf(); e++) {
+            a.p(e, (e * 7) % 13 - 6);
+            aD.p(e, (e * 7) % 13 - 6);
+        }
+
+        for (Nd4jLong e = 0; e < b.lengthOf(); e++) {
+            b.p(e, ((e * 5) % 11 - 5) * 0.125);
+            bD.p(e, ((e * 5) % 11 - 5) * 0.125);
+        }
+
+        MmulHelper::mmul(&a, &b, &c, 1., 0.);
+        MmulHelper::mmul(&aD, &bD, &expD, 1., 0.);
+
+        auto exp = expD.cast(dtype);
+        ASSERT_TRUE(exp->equalsTo(c));
+
+        delete exp;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(HelpersTests1, tensordot_test_1) {
 
@@ -20,8 +20,12 @@
 
 #include <memory/MemoryReport.h>
 #include <memory/MemoryUtils.h>
+#include <memory/CachingHostAllocator.h>
+#include <NDArray.h>
+#include <Environment.h>
 #include "testlayers.h"
 
+using namespace nd4j;
 using namespace nd4j::memory;
 
 class MemoryUtilsTests : public testing::Test {
@@ -44,3 +48,60 @@ TEST_F(MemoryUtilsTests, BasicRetrieve_1) {
 
     ASSERT_NE(reportA, reportB);
 }
+
+TEST_F(MemoryUtilsTests, HostCache_1) {
+    auto env = nd4j::Environment::getInstance();
+    auto allocator = CachingHostAllocator::getInstance();
+    auto wasEnabled = env->isHostCache();
+
+    env->setHostCache(true);
+    allocator->trim();
+
+    // other threads might still hold some blocks
+    auto cached = allocator->cachedBytes();
+    auto misses = allocator->misses();
+    auto hits = allocator->hits();
+    {
+        NDArray x('c', {100, 100}, nd4j::DataType::FLOAT32);
+        auto buffer = x.bufferAsT<float>();
+        for (int e = 0; e < x.lengthOf(); e++)
+            buffer[e] = 1.0f;
+    }
+
+    // 40000 bytes go to 64KB class
+    ASSERT_EQ(misses + 1, allocator->misses());
+    ASSERT_EQ(cached + 65536L, allocator->cachedBytes());
+
+    {
+        // same size class, so buffer is reused, and comes zeroed
+        NDArray y('c', {120, 120}, nd4j::DataType::FLOAT32);
+        ASSERT_EQ(hits + 1, allocator->hits());
+        ASSERT_EQ(cached, allocator->cachedBytes());
+
+        auto buffer = y.bufferAsT<float>();
+        for (int e = 0; e < y.lengthOf(); e++)
+            ASSERT_EQ(0.0f, buffer[e]);
+    }
+
+    // nothing above limit is cached
+    env->setHostCacheLimit(1024L);
+    auto ptr = allocator->allocate(40000);
+    ASSERT_EQ(hits + 2, allocator->hits());
+    allocator->release(ptr);
+    ASSERT_EQ(cached, allocator->cachedBytes());
+
+    // blocks above max class aren't cached at all
+    env->setHostCacheLimit(256L * 1024L * 1024L);
+    ptr = allocator->allocate(100L * 1024L * 1024L);
+    allocator->release(ptr);
+    ASSERT_EQ(cached, allocator->cachedBytes());
+
+    ptr = allocator->allocate(100);
+    allocator->release(ptr);
+    ASSERT_EQ(cached + 128L, allocator->cachedBytes());
+
+    allocator->trim();
+    ASSERT_EQ(cached, allocator->cachedBytes());
+
+    env->setHostCache(wasEnabled);
+}
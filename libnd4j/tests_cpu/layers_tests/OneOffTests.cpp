@@ -166,6 +166,33 @@ TEST_F(OneOffTests, test_conv2d_nhwc_failed_1) {
     delete graph;
 }
 
+TEST_F(OneOffTests, test_conv2d_nhwc_mapped_1) {
+    auto copied = GraphExecutioner::importFromFlatBuffers("./resources/channels_last_b1_k2_s1_d1_SAME_crelu.fb");
+    auto mapped = GraphExecutioner::importFromMappedFlatBuffers("./resources/channels_last_b1_k2_s1_d1_SAME_crelu.fb");
+    ASSERT_TRUE(copied != nullptr);
+    ASSERT_TRUE(mapped != nullptr);
+
+    // restored arrays must be equal, no matter if they were copied or not
+    auto vars = copied->getVariableSpace()->getVariables();
+    for (auto v: vars) {
+        if (!v->hasNDArray())
+            continue;
+
+        auto m = mapped->getVariableSpace()->getVariable(v->id(), v->index());
+        ASSERT_TRUE(m->hasNDArray());
+        ASSERT_EQ(*v->getNDArray(), *m->getNDArray());
+    }
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(copied));
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(mapped));
+
+    auto z = mapped->getVariableSpace()->getVariable(9)->getNDArray();
+    ASSERT_EQ(*copied->getVariableSpace()->getVariable(9)->getNDArray(), *z);
+
+    delete copied;
+    delete mapped;
+}
+
 TEST_F(OneOffTests, test_tensor_array_1) {
     auto e = NDArrayFactory::create<float>('c', {2, 3}, {0.77878559f, 0.80119777f, 0.72437465f, 0.23089433f, 0.72714126f, 0.18039072f});
 
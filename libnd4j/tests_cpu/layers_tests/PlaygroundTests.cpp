@@ -38,6 +38,16 @@
 #include <helpers/ConstantShapeHelper.h>
 #include <helpers/ConstantTadHelper.h>
 #include <array>
+#include <thread>
+#include <Workspace.h>
+#include <memory/HugePages.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
 
@@ -906,6 +916,170 @@ TEST_F(PlaygroundTests, Test_Profile_2) {
 }
 #endif
 
+TEST_F(PlaygroundTests, Test_GraphExecutionModes_1) {
+    nd4j::ops::matmul op;
+
+    // 12 independent branches of 3 matmuls each, so each onion layer holds 12 nodes
+    auto build = [&](ExecutionMode mode) -> Graph* {
+        auto graph = new Graph();
+        graph->getExecutorConfiguration()->_executionMode = mode;
+
+        auto x = NDArrayFactory::create_<float>('c', {256, 256});
+        x->linspace(0.0, 1e-5);
+        graph->getVariableSpace()->putVariable(-1, x);
+
+        for (int b = 0; b < 12; b++) {
+            int id = b * 3 + 1;
+            graph->addNode(new Node(&op, id, {-1, -1}));
+            graph->addNode(new Node(&op, id + 1, {id, -1}));
+            graph->addNode(new Node(&op, id + 2, {id + 1, -1}));
+        }
+
+        return graph;
+    };
+
+    auto graphS = build(ExecutionMode_SEQUENTIAL);
+    auto graphA = build(ExecutionMode_AUTO);
+
+    // warm up, so both modes have outputs allocated already
+    GraphExecutioner::execute(graphS);
+    GraphExecutioner::execute(graphA);
+
+    auto timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < numIterations; e++)
+        GraphExecutioner::execute(graphS);
+
+    auto timeMiddle = std::chrono::system_clock::now();
+    for (int e = 0; e < numIterations; e++)
+        GraphExecutioner::execute(graphA);
+
+    auto timeEnd = std::chrono::system_clock::now();
+
+    auto sequentialTime = std::chrono::duration_cast<std::chrono::microseconds> (timeMiddle - timeStart).count();
+    auto autoTime = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeMiddle).count();
+
+    nd4j_printf("SEQUENTIAL time: %lld us; AUTO time: %lld us\n", sequentialTime / numIterations, autoTime / numIterations);
+
+    for (int e = 1; e <= 36; e++)
+        ASSERT_TRUE(graphS->getVariableSpace()->getVariable(e)->getNDArray()->equalsTo(graphA->getVariableSpace()->getVariable(e)->getNDArray()));
+
+    delete graphS;
+    delete graphA;
+}
+
+TEST_F(PlaygroundTests, Test_Workspace_Contention_1) {
+    const int numThreads = 8;
+    const int numAllocations = 10000;
+
+    // every thread does lots of small allocations from the same workspace, as ops within parallel region would
+    auto run = [&](bool threadLocal) -> Nd4jLong {
+        nd4j::memory::Workspace ws(numThreads * numAllocations * 64);
+        ws.setThreadLocal(threadLocal);
+
+        Nd4jLong time = 0;
+        for (int i = 0; i < numIterations; i++) {
+            std::vector<std::thread> threads;
+
+            auto timeStart = std::chrono::system_clock::now();
+            for (int t = 0; t < numThreads; t++)
+                threads.emplace_back(std::thread([&] {
+                    for (int e = 0; e < numAllocations; e++)
+                        ws.allocateBytes(32);
+                }));
+
+            for (auto &t: threads)
+                t.join();
+
+            auto timeEnd = std::chrono::system_clock::now();
+            time += std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+
+            EXPECT_EQ(0, ws.getSpilledSize());
+            ws.scopeOut();
+        }
+
+        return time / numIterations;
+    };
+
+    auto lockedTime = run(false);
+    auto threadLocalTime = run(true);
+
+    nd4j_printf("Locked workspace: %lld us; Thread-local workspace: %lld us\n", lockedTime, threadLocalTime);
+}
+
+TEST_F(PlaygroundTests, Test_HugePages_Conv2d_1) {
+    // NCHW input, im2col buffer within conv2d takes ~115MB here
+    const int bS = 4, iC = 64, iH = 112, iW = 112, oC = 64, kH = 3, kW = 3;
+
+    auto input = NDArrayFactory::create<float>('c', {bS, iC, iH, iW});
+    auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+    input.linspace(0.0, 1e-6);
+    weights.linspace(0.0, 1e-4);
+
+    nd4j::ops::conv2d op;
+
+    // dTLB read misses of this thread, and of threads spawned after counter was opened. -1 if counter isn't available
+    auto openCounter = []() -> int {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+        return -1;
+#endif
+    };
+
+    auto run = [&](bool hugePages, Nd4jLong &tlbMisses) -> Nd4jLong {
+        Environment::getInstance()->setHugePages(hugePages);
+
+        // warm up
+        delete op.execute({&input, &weights}, {}, {kH, kW, 1, 1, 1, 1, 1, 1, 0, 0});
+
+        auto fd = openCounter();
+#if defined(__linux__)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+
+        auto timeStart = std::chrono::system_clock::now();
+        for (int e = 0; e < numIterations; e++)
+            delete op.execute({&input, &weights}, {}, {kH, kW, 1, 1, 1, 1, 1, 1, 0, 0});
+
+        auto timeEnd = std::chrono::system_clock::now();
+
+        tlbMisses = -1;
+#if defined(__linux__)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            if (read(fd, &value, sizeof(value)) == sizeof(value))
+                tlbMisses = value / numIterations;
+
+            close(fd);
+        }
+#endif
+
+        return std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count() / numIterations;
+    };
+
+    Environment::getInstance()->setHugePagesThreshold(16 * 1024 * 1024);
+
+    Nd4jLong regularMisses, hugeMisses;
+    auto regularTime = run(false, regularMisses);
+    auto hugeTime = run(true, hugeMisses);
+
+    Environment::getInstance()->setHugePages(false);
+
+    nd4j_printf("conv2d with 4KB pages: %lld us, %lld dTLB misses; with huge pages: %lld us, %lld dTLB misses\n", regularTime, regularMisses, hugeTime, hugeMisses);
+}
+
 TEST_F(PlaygroundTests, Test_Im2Col_1) {
     
     int bS=16, iH=224,iW=224,  iC=3,oC=3,  kH=11,kW=11,  sH=4,sW=4,  pH=2,pW=2,  dH=1,dW=1;    
@@ -2383,3 +2557,108 @@ TEST_F(PlaygroundTests, mmulMxM_1) {
     printf("duration  %ld\n", duration1);
 }
 */
+
+TEST_F(PlaygroundTests, Test_ConstantCaches_Contention_1) {
+    const int numLookups = 100000;
+
+    // few hot shapes, as ops of the same model would request them over and over
+    std::vector<Nd4jLong*> shapes;
+    for (int e = 1; e <= 16; e++)
+        shapes.emplace_back(ConstantShapeHelper::getInstance()->createShapeInfo(nd4j::DataType::FLOAT32, 'c', {e, 32, 64}));
+
+    auto run = [&](int numThreads, bool tads) -> Nd4jLong {
+        std::vector<std::thread> threads;
+
+        auto timeStart = std::chrono::system_clock::now();
+        for (int t = 0; t < numThreads; t++)
+            threads.emplace_back(std::thread([&] {
+                for (int e = 0; e < numLookups; e++) {
+                    auto shapeInfo = shapes[e % shapes.size()];
+                    if (tads)
+                        ConstantTadHelper::getInstance()->tadForDimensions(shapeInfo, {1, 2});
+                    else
+                        ConstantShapeHelper::getInstance()->bufferForShapeInfo(shapeInfo);
+                }
+            }));
+
+        for (auto &t: threads)
+            t.join();
+
+        auto timeEnd = std::chrono::system_clock::now();
+        auto time = std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+
+        // lookups per microsecond
+        return time > 0 ? (Nd4jLong) numThreads * numLookups / time : 0;
+    };
+
+    for (int numThreads = 1; numThreads <= 16; numThreads *= 2)
+        nd4j_printf("Threads: %i; Shape lookups: %lld M/s; TAD lookups: %lld M/s\n", numThreads, run(numThreads, false), run(numThreads, true));
+}
+
+TEST_F(PlaygroundTests, Test_BlockedGemm_1) {
+    const int numOfIters = 10;
+    const Nd4jLong M = 512;
+    const Nd4jLong K = 512;
+    const Nd4jLong N = 512;
+
+    // none of these combinations is covered by BLAS
+    std::vector<std::vector<nd4j::DataType>> types = {{nd4j::DataType::HALF, nd4j::DataType::HALF, nd4j::DataType::HALF},
+                                                      {nd4j::DataType::BFLOAT16, nd4j::DataType::BFLOAT16, nd4j::DataType::BFLOAT16},
+                                                      {nd4j::DataType::INT32, nd4j::DataType::FLOAT32, nd4j::DataType::FLOAT32},
+                                                      {nd4j::DataType::FLOAT32, nd4j::DataType::DOUBLE, nd4j::DataType::DOUBLE}};
+
+    for (auto &t: types) {
+        NDArray a('c', {M,K}, t[0]);
+        NDArray b('f', {K,N}, t[1]);
+        NDArray c('c', {M,N}, t[2]);
+
+        a.linspace(0.01, 0.001);
+        b.linspace(0.01, 0.001);
+
+        auto timeStart = std::chrono::system_clock::now();
+
+        for (int i = 0; i < numOfIters; ++i)
+            nd4j::MmulHelper::mmul(&a, &b, &c, 1., 0.);
+
+        auto timeEnd = std::chrono::system_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / numOfIters).count();
+        nd4j_printf("%s x %s -> %s: %lld us\n", DataTypeUtils::asString(t[0]).c_str(), DataTypeUtils::asString(t[1]).c_str(), DataTypeUtils::asString(t[2]).c_str(), (Nd4jLong) duration);
+    }
+}
+
+TEST_F(PlaygroundTests, Test_QuantizedMatmul_1) {
+    const int numOfIters = 10;
+    const Nd4jLong M = 256;
+    const Nd4jLong K = 1024;
+    const Nd4jLong N = 1024;
+
+    auto x = NDArrayFactory::create<float>('c', {M, K});
+    auto w = NDArrayFactory::create<float>('c', {K, N});
+    auto z = NDArrayFactory::create<float>('c', {M, N});
+
+    x.linspace(-1., 2. / x.lengthOf());
+    w.linspace(-0.5, 1. / w.lengthOf());
+
+    nd4j::ops::quantize_weights calibrate;
+    auto weights = calibrate.execute({&w}, {}, {});
+
+    nd4j::ops::quantized_matmul op;
+    nd4j::ops::matmul fp;
+
+    auto timeStart = std::chrono::system_clock::now();
+
+    for (int i = 0; i < numOfIters; ++i)
+        fp.execute({&x, &w}, {&z}, {}, {}, {});
+
+    auto timeMiddle = std::chrono::system_clock::now();
+
+    for (int i = 0; i < numOfIters; ++i)
+        op.execute({&x, weights->at(0), weights->at(1), weights->at(2)}, {&z}, {}, {}, {});
+
+    auto timeEnd = std::chrono::system_clock::now();
+    auto fpTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeMiddle - timeStart) / numOfIters).count();
+    auto qTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeMiddle) / numOfIters).count();
+    nd4j_printf("matmul: %lld us; quantized_matmul: %lld us\n", (Nd4jLong) fpTime, (Nd4jLong) qTime);
+
+    delete weights;
+}
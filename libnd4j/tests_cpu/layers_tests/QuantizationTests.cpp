@@ -22,6 +22,12 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <type_conversions.h>
+#include <ops/declarable/CustomOperations.h>
+#include <helpers/QuantizationCalibrator.h>
+#include <MmulHelper.h>
+#ifndef __CUDABLAS__
+#include <helpers/QuantizedGemm.h>
+#endif
 
 
 using namespace nd4j;
@@ -58,4 +64,218 @@ TEST_F(QuantizationTests, Compression_Test_1) {
     ASSERT_NEAR(10.0f, fq[1], 1e-5);
 
     delete[] q;
-}
\ No newline at end of file
+}
+
+#ifndef __CUDABLAS__
+TEST_F(QuantizationTests, QuantizedGemm_1) {
+    // K spans two blocks, M and N aren't multiples of micro-tile sizes, and B is f-ordered
+    const int M = 19;
+    const int K = 1100;
+    const int N = 45;
+
+    std::vector<uint8_t> a(M * K);
+    std::vector<int8_t> b(K * N);
+    std::vector<int32_t> c(M * N);
+
+    for (int e = 0; e < M * K; e++)
+        a[e] = static_cast<uint8_t>((e * 37) % 256);
+
+    for (int e = 0; e < K * N; e++)
+        b[e] = static_cast<int8_t>((e * 53) % 256 - 128);
+
+    QuantizedGemm::gemm(M, N, K, a.data(), K, 1, b.data(), 1, K, c.data(), N, 1);
+
+    for (int m = 0; m < M; m++)
+        for (int n = 0; n < N; n++) {
+            Nd4jLong exp = 0;
+            for (int k = 0; k < K; k++)
+                exp += a[m * K + k] * b[n * K + k];
+
+            ASSERT_EQ(exp, c[m * N + n]);
+        }
+}
+#endif
+
+TEST_F(QuantizationTests, Quantized_Matmul_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 5, 64});
+    auto w = NDArrayFactory::create<float>('c', {64, 24});
+
+    // all values are on quantization grid, so quantized product matches float one
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+        x.p(e, ((e * 7) % 52 - 20) * 0.05f);
+
+    for (int n = 0; n < 24; n++) {
+        const float range = 0.25f + 0.01f * n;
+        for (int k = 0; k < 64; k++)
+            w.p(k * 24 + n, k == 0 ? range : range * (((k * 5 + n * 3) % 255) - 127) / 127.f);
+    }
+
+    nd4j::ops::quantize_weights calibrate;
+    auto weights = calibrate.execute({&w}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, weights->status());
+
+    auto qw = weights->at(0);
+    auto scales = weights->at(1);
+    auto zeroPoints = weights->at(2);
+
+    ASSERT_EQ(nd4j::DataType::INT8, qw->dataType());
+    ASSERT_NEAR(0.25f / 127.f, scales->e<float>(0), 1e-7);
+    ASSERT_EQ(0, zeroPoints->e<int>(5));
+
+    nd4j::ops::quantized_matmul op;
+    auto result = op.execute({&x, qw, scales, zeroPoints}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(std::vector<Nd4jLong>({2, 5, 24}), z->getShapeAsVector());
+
+    auto x2 = x.reshape('c', {10, 64});
+    auto exp = NDArrayFactory::create<float>('c', {10, 24});
+    MmulHelper::mmul(&x2, &w, &exp, 1., 0.);
+
+    ASSERT_TRUE(exp.equalsTo(z->reshape('c', {10, 24}), 1e-3));
+
+    delete result;
+    delete weights;
+}
+
+TEST_F(QuantizationTests, Quantized_Matmul_2) {
+    auto x = NDArrayFactory::create<float>('c', {4, 2}, {300.f, 1.f, -300.f, 1.f, 1.7f, 0.f, -2.6f, 0.f});
+    auto w = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 0.5f, -0.25f, 1.f, 1.f, 1.f});
+    auto z = NDArrayFactory::create<int8_t>('c', {4, 3});
+
+    nd4j::ops::quantize_weights calibrate;
+    auto weights = calibrate.execute({&w}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, weights->status());
+
+    nd4j::ops::quantized_matmul op;
+    auto result = op.execute({&x, weights->at(0), weights->at(1), weights->at(2)}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    // int8 output without output scale is rounded and saturated, not truncated
+    ASSERT_EQ(ND4J_STATUS_OK, op.execute({&x, weights->at(0), weights->at(1), weights->at(2)}, {&z}, {}, {}, {}));
+
+    auto f = result->at(0);
+    for (Nd4jLong e = 0; e < z.lengthOf(); e++) {
+        auto exp = nd4j::math::nd4j_min<int>(127, nd4j::math::nd4j_max<int>(-128, static_cast<int>(std::nearbyint(f->e<float>(e)))));
+        ASSERT_EQ(exp, z.e<int>(e));
+    }
+
+    ASSERT_EQ(127, z.e<int>(0));
+    ASSERT_EQ(-128, z.e<int>(3));
+
+    delete result;
+    delete weights;
+}
+
+TEST_F(QuantizationTests, Quantized_XwPlusB_1) {
+    auto x = NDArrayFactory::create<float>('c', {7, 40});
+    auto w = NDArrayFactory::create<float>('c', {40, 9});
+    auto b = NDArrayFactory::create<float>('c', {9});
+
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+        x.p(e, std::sin(0.37 * e));
+
+    for (Nd4jLong e = 0; e < w.lengthOf(); e++)
+        w.p(e, 0.3 * std::cos(0.11 * e) + 0.1);
+
+    b.linspace(-1.f, 0.25f);
+
+    // asymmetric weights
+    nd4j::ops::quantize_weights calibrate;
+    auto weights = calibrate.execute({&w}, {}, {0});
+    ASSERT_EQ(ND4J_STATUS_OK, weights->status());
+
+    nd4j::ops::quantized_xw_plus_b op;
+    auto result = op.execute({&x, weights->at(0), &b, weights->at(1), weights->at(2)}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    nd4j::ops::xw_plus_b fp;
+    auto expected = fp.execute({&x, &w, &b}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, expected->status());
+
+    auto z = result->at(0);
+    ASSERT_TRUE(expected->at(0)->equalsTo(z, 2e-2));
+
+    // requantized output is the same result, rounded to int8 grid calibrated on it
+    QuantizationCalibrator calibrator;
+    calibrator.observe(*z);
+
+    const double outScale = calibrator.scale();
+    const int outZeroPoint = calibrator.zeroPoint();
+
+    auto requantized = op.execute({&x, weights->at(0), &b, weights->at(1), weights->at(2)}, {outScale, (double) outZeroPoint}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, requantized->status());
+
+    auto q = requantized->at(0);
+    ASSERT_EQ(nd4j::DataType::INT8, q->dataType());
+
+    for (Nd4jLong e = 0; e < z->lengthOf(); e++) {
+        auto exp = nd4j::math::nd4j_max<int>(-128, nd4j::math::nd4j_min<int>(127, static_cast<int>(std::nearbyint(z->e<float>(e) * static_cast<float>(1. / outScale))) + outZeroPoint));
+        ASSERT_EQ(exp, q->e<int>(e));
+    }
+
+    delete requantized;
+    delete expected;
+    delete result;
+    delete weights;
+}
+
+TEST_F(QuantizationTests, Quantized_Conv2d_1) {
+    int bS=2, iH=5,iW=5,  iC=3,oC=4,  kH=2,kW=2,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+
+    auto input = NDArrayFactory::create<float>('c', {bS, iH, iW, iC});
+    auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+    auto bias = NDArrayFactory::create<float>('c', {oC}, {0.5f, -1.f, 0.f, 2.f});
+
+    // values are on quantization grid, as in Quantized_Matmul_1
+    for (Nd4jLong e = 0; e < input.lengthOf(); e++)
+        input.p(e, ((e * 7) % 52 - 20) * 0.05f);
+
+    for (Nd4jLong e = 0; e < weights.lengthOf(); e++)
+        weights.p(e, e < oC ? 1.f : ((e * 13) % 255 - 127) / 127.f);
+
+    nd4j::ops::quantize_weights calibrate;
+    auto qw = calibrate.execute({&weights}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, qw->status());
+
+    nd4j::ops::quantized_conv2d op;
+    auto result = op.execute({&input, qw->at(0), qw->at(1), qw->at(2), &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    nd4j::ops::conv2d fp;
+    auto expected = fp.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    ASSERT_EQ(ND4J_STATUS_OK, expected->status());
+
+    auto z = result->at(0);
+    ASSERT_TRUE(expected->at(0)->isSameShape(z));
+    ASSERT_TRUE(expected->at(0)->equalsTo(z, 1e-3));
+
+    delete expected;
+    delete result;
+    delete qw;
+}
+
+TEST_F(QuantizationTests, Calibrator_1) {
+    auto a = NDArrayFactory::create<float>('c', {4}, {0.5f, 1.f, 2.f, 0.25f});
+    auto b = NDArrayFactory::create<float>('c', {3}, {-0.55f, 0.f, 1.f});
+
+    QuantizationCalibrator calibrator;
+    calibrator.observe(a);
+    calibrator.observe(b);
+
+    ASSERT_EQ(2, calibrator.observations());
+    ASSERT_NEAR(-0.55, calibrator.min(), 1e-6);
+    ASSERT_NEAR(2.0, calibrator.max(), 1e-6);
+
+    // [-0.55, 2] -> [0, 255] with step 0.01, so zero is at 55
+    ASSERT_NEAR(0.01, calibrator.scale(0, 255), 1e-6);
+    ASSERT_EQ(55, calibrator.zeroPoint(0, 255));
+
+    // positive-only ranges are extended to 0
+    calibrator.reset();
+    calibrator.observe(a);
+    ASSERT_EQ(-128, calibrator.zeroPoint());
+}
@@ -22,6 +22,9 @@
 #include <GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <graph/InferenceRequest.h>
+#include <graph/GraphBatcher.h>
+#include <graph/StreamingSessions.h>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -36,6 +39,9 @@ public:
     ~ServerRelatedTests() {
         Environment::getInstance()->setDebug(false);
         Environment::getInstance()->setVerbose(false);
+
+        // batching is global, so it's disabled even if test has failed halfway
+        GraphBatcher::getInstance()->setMaxBatchSize(1);
     }
 };
 
@@ -80,6 +86,191 @@ TEST_F(ServerRelatedTests, Basic_Output_Test_1) {
     ASSERT_EQ(*array2, *restored.byId("second")->getNDArray());
     ASSERT_EQ(*array3, *restored.byId("second indexed")->getNDArray());
 }
+
+TEST_F(ServerRelatedTests, Batched_Execution_Test_1) {
+    const int numRequests = 4;
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 4});
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {}));
+
+    GraphHolder::getInstance()->registerGraph(11904L, graph);
+
+    // long delay, so batch is started only once all requests are queued
+    GraphBatcher::getInstance()->resetStats();
+    GraphBatcher::getInstance()->setMaxBatchSize(numRequests);
+    GraphBatcher::getInstance()->setMaxDelay(5000000L);
+
+    std::vector<NDArray*> inputs(numRequests);
+    std::vector<NDArray*> outputs(numRequests);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numRequests; t++) {
+        // requests might have different number of rows
+        inputs[t] = NDArrayFactory::create_<float>('c', {t + 1, 4});
+        inputs[t]->linspace(-1.0 * t, 0.25);
+
+        threads.emplace_back(std::thread([&, t] {
+            flatbuffers::FlatBufferBuilder builder(4096);
+            flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+            InferenceRequest ir(11904L);
+            ir.appendVariable(-1, 0, inputs[t]);
+
+            auto af = ir.asFlatInferenceRequest(otherBuilder);
+            otherBuilder.Finish(af);
+            auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+            auto flatResult = GraphBatcher::getInstance()->execute(fir->id(), builder, fir);
+            builder.Finish(flatResult);
+
+            ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+            outputs[t] = restored.at(0)->getNDArray()->dup();
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 0; t < numRequests; t++) {
+        auto exp = inputs[t]->transform(transform::Abs).transform(transform::Cosine);
+
+        ASSERT_TRUE(outputs[t] != nullptr);
+        ASSERT_EQ(exp, *outputs[t]);
+
+        delete inputs[t];
+        delete outputs[t];
+    }
+
+    auto stats = GraphBatcher::getInstance()->getStats(11904L);
+    ASSERT_EQ(numRequests, stats.requests);
+    ASSERT_EQ(1, stats.batches);
+    ASSERT_EQ(numRequests, stats.batchedRequests);
+    ASSERT_EQ(0, stats.singleRequests);
+
+    GraphHolder::getInstance()->dropGraphAny(11904L);
+}
+
+TEST_F(ServerRelatedTests, Streaming_Session_Test_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 4});
+    auto h = NDArrayFactory::create_<float>('c', {1, 4});
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, h);
+
+    // output of node 1 is fed back as -2 on the next request
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 1, {-1, -2}, {}));
+
+    GraphHolder::getInstance()->registerGraph(11905L, graph);
+    StreamingSessions::getInstance()->defineState(11905L, {1, 0}, {-2, 0});
+
+    auto input = NDArrayFactory::create<float>('c', {1, 4}, {1.f, 2.f, 3.f, 4.f});
+    auto exp = NDArrayFactory::create<float>('c', {1, 4}, {3.f, 6.f, 9.f, 12.f});
+
+    for (int e = 0; e < 3; e++) {
+        flatbuffers::FlatBufferBuilder builder(4096);
+        flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+        InferenceRequest ir(11905L);
+        ir.setSession(7L);
+        ir.appendVariable(-1, 0, &input);
+
+        auto af = ir.asFlatInferenceRequest(otherBuilder);
+        otherBuilder.Finish(af);
+        auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+        ASSERT_EQ(7L, fir->session());
+
+        auto flatResult = GraphBatcher::getInstance()->execute(fir->id(), builder, fir);
+        builder.Finish(flatResult);
+    }
+
+    ASSERT_TRUE(StreamingSessions::getInstance()->hasSession(11905L, 7L));
+    ASSERT_FALSE(StreamingSessions::getInstance()->hasSession(11905L, 8L));
+
+    auto state = StreamingSessions::getInstance()->state(11905L, 7L, {-2, 0});
+    ASSERT_TRUE(state != nullptr);
+    ASSERT_EQ(exp, *state);
+    delete state;
+
+    // graph itself is never modified by session requests
+    ASSERT_NEAR(0.0f, graph->getVariableSpace()->getVariable(-2)->getNDArray()->sumNumber().e<float>(0), 1e-5f);
+
+    StreamingSessions::getInstance()->endSession(11905L, 7L);
+    ASSERT_FALSE(StreamingSessions::getInstance()->hasSession(11905L, 7L));
+
+    GraphHolder::getInstance()->dropGraphAny(11905L);
+}
+
+TEST_F(ServerRelatedTests, Streaming_Session_Test_2) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 4});
+    auto h = NDArrayFactory::create_<float>('c', {1, 4});
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, h);
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 1, {-1, -2}, {}));
+
+    GraphHolder::getInstance()->registerGraph(11906L, graph);
+
+    auto input = NDArrayFactory::create<float>('c', {1, 4}, {1.f, 2.f, 3.f, 4.f});
+    auto run = [&](Nd4jLong sessionId) {
+        flatbuffers::FlatBufferBuilder builder(4096);
+        flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+        InferenceRequest ir(11906L);
+        ir.setSession(sessionId);
+        ir.appendVariable(-1, 0, &input);
+
+        auto af = ir.asFlatInferenceRequest(otherBuilder);
+        otherBuilder.Finish(af);
+        auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+        auto flatResult = GraphHolder::getInstance()->execute(fir->id(), builder, fir);
+        builder.Finish(flatResult);
+    };
+
+    // there's no state defined yet, so session isn't created
+    run(1L);
+    ASSERT_FALSE(StreamingSessions::getInstance()->hasSession(11906L, 1L));
+
+    // state declared within FlatGraph, the same way GraphServer gets it
+    flatbuffers::FlatBufferBuilder fgBuilder(1024);
+    std::vector<flatbuffers::Offset<IntPair>> outputs({CreateIntPair(fgBuilder, 1, 0)});
+    std::vector<flatbuffers::Offset<IntPair>> inputs({CreateIntPair(fgBuilder, -2, 0)});
+    auto fg = CreateFlatGraphDirect(fgBuilder, 11906L, nullptr, nullptr, nullptr, 0, nullptr, nullptr, nullptr, nullptr, &outputs, &inputs);
+    fgBuilder.Finish(fg);
+    StreamingSessions::getInstance()->defineStates(11906L, GetFlatGraph(fgBuilder.GetBufferPointer()));
+
+    auto maxSessions = StreamingSessions::getInstance()->maxSessions();
+    StreamingSessions::getInstance()->setMaxSessions(StreamingSessions::getInstance()->numberOfSessions() + 1);
+
+    run(1L);
+    run(1L);
+    ASSERT_TRUE(StreamingSessions::getInstance()->hasSession(11906L, 1L));
+
+    auto exp = NDArrayFactory::create<float>('c', {1, 4}, {2.f, 4.f, 6.f, 8.f});
+    auto state = StreamingSessions::getInstance()->state(11906L, 1L, {-2, 0});
+    ASSERT_TRUE(state != nullptr);
+    ASSERT_EQ(exp, *state);
+    delete state;
+
+    // no room for one more session
+    ASSERT_ANY_THROW(run(2L));
+    ASSERT_FALSE(StreamingSessions::getInstance()->hasSession(11906L, 2L));
+
+    // ended session frees its slot
+    StreamingSessions::getInstance()->endSession(11906L, 1L);
+    run(2L);
+    ASSERT_TRUE(StreamingSessions::getInstance()->hasSession(11906L, 2L));
+
+    StreamingSessions::getInstance()->setMaxSessions(maxSessions);
+    GraphHolder::getInstance()->dropGraphAny(11906L);
+    ASSERT_FALSE(StreamingSessions::getInstance()->hasSession(11906L, 2L));
+}
+
 #if GRAPH_FILES_OK
 TEST_F(ServerRelatedTests, Basic_Execution_Test_1) {
     flatbuffers::FlatBufferBuilder builder(4096);
@@ -170,4 +170,28 @@ TEST_F(VariableProxyTests, Test_Clone_1) {
     ASSERT_TRUE(clone->hasVariable(119));
 
     delete clone;
-}
\ No newline at end of file
+}
+
+TEST_F(VariableProxyTests, Test_Slots_1) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2}, {4, 2, 3, 1});
+
+    std::map<std::pair<int, int>, int> slots;
+    slots[{-119, 0}] = 0;
+    slots[{119, 0}] = 1;
+
+    VariableSpace ref;
+    ref.putVariable(-119, x);
+    ref.attachSlots(&slots);
+
+    VariableProxy proxy(&ref);
+    proxy.attachSlots(&slots);
+
+    ASSERT_TRUE(proxy.slotVariable(0) == ref.getVariable(-119));
+    ASSERT_TRUE(proxy.slotVariable(1) == nullptr);
+
+    proxy.putVariable(119, 0, y);
+
+    ASSERT_TRUE(proxy.slotVariable(1) == proxy.getVariable(119, 0));
+    ASSERT_TRUE(ref.slotVariable(1) == nullptr);
+}
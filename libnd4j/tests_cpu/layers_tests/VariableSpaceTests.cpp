@@ -217,4 +217,33 @@ TEST_F(VariableSpaceTest, Test_DType_Conversion_1) {
     delete sd;
     delete sf;
     */
-}
\ No newline at end of file
+}
+
+TEST_F(VariableSpaceTest, Test_Slots_1) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2}, {4, 3, 2, 1});
+    auto z = NDArrayFactory::create_<float>('c', {2, 2}, {0, 1, 0, 1});
+
+    std::map<std::pair<int, int>, int> slots;
+    slots[{-1, 0}] = 0;
+    slots[{1, 0}] = 1;
+    slots[{2, 1}] = 2;
+
+    VariableSpace space;
+    space.putVariable(-1, x);
+    space.putVariable(1, 0, y);
+
+    space.attachSlots(&slots);
+
+    ASSERT_TRUE(space.slotVariable(0) == space.getVariable(-1));
+    ASSERT_TRUE(space.slotVariable(1) == space.getVariable(1, 0));
+    ASSERT_TRUE(space.slotVariable(2) == nullptr);
+    ASSERT_TRUE(space.slotVariable(3) == nullptr);
+
+    // slots follow variables stored after attachment
+    space.putVariable(2, 1, z);
+
+    ASSERT_TRUE(space.slotVariable(2) != nullptr);
+    ASSERT_TRUE(space.slotVariable(2) == space.getVariable(2, 1));
+    ASSERT_TRUE(z == space.slotVariable(2)->getNDArray());
+}
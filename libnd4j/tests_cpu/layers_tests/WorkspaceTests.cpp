@@ -26,6 +26,9 @@
 #include <Workspace.h>
 #include <MemoryRegistrator.h>
 #include <MmulHelper.h>
+#include <helpers/NumaHelper.h>
+#include <memory/HugePages.h>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::memory;
@@ -131,6 +134,15 @@ TEST_F(WorkspaceTests, StretchTest1) {
     workspace.scopeOut();
     workspace.scopeIn();
 
+    // single overflowing cycle is served from spills
+    ASSERT_EQ(128, workspace.getCurrentSize());
+
+    for (int e = 0; e < 10; e++)
+        workspace.allocateBytes(128);
+
+    workspace.scopeOut();
+    workspace.scopeIn();
+
     ASSERT_EQ(0, workspace.getCurrentOffset());
 
     // we should have absolutely different pointer here, due to reallocation
@@ -138,7 +150,6 @@ TEST_F(WorkspaceTests, StretchTest1) {
 
     //ASSERT_FALSE(ptr == ptr2);
 
-
     ASSERT_EQ(1280, workspace.getCurrentSize());
     ASSERT_EQ(0, workspace.getSpilledSize());
 }
@@ -265,6 +276,216 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
     ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, Test_ThreadLocal_1) {
+    const int numThreads = 4;
+    const int numAllocations = 64;
+
+    Workspace ws(1024 * 1024);
+    ws.setThreadLocal(true, 4096);
+    ASSERT_TRUE(ws.isThreadLocal());
+
+    std::vector<std::vector<char*>> pointers(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back(std::thread([&, t] {
+            for (int e = 0; e < numAllocations; e++) {
+                auto p = reinterpret_cast<char*>(ws.allocateBytes(100));
+                memset(p, t + 1, 100);
+                pointers[t].emplace_back(p);
+            }
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    // nothing was overwritten by other threads, and nothing was spilled
+    for (int t = 0; t < numThreads; t++)
+        for (auto p: pointers[t])
+            for (int e = 0; e < 100; e++)
+                ASSERT_EQ(t + 1, (int) p[e]);
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_EQ(numThreads * 2 * 4096, ws.getCurrentOffset());
+
+    ws.scopeOut();
+    ASSERT_EQ(0, ws.getCurrentOffset());
+
+    // chunks of previous cycle are dropped
+    ws.allocateBytes(100);
+    ASSERT_EQ(4096, ws.getCurrentOffset());
+}
+
+TEST_F(WorkspaceTests, Test_ThreadLocal_2) {
+    Workspace ws(2048);
+    ws.setThreadLocal(true);
+
+    // allocations beyond workspace go to spills, and workspace grows for the next cycle
+    for (int e = 0; e < 16; e++)
+        ws.allocateBytes(256);
+
+    ASSERT_TRUE(ws.getSpilledSize() > 0);
+
+    ws.scopeOut();
+    ws.scopeIn();
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_TRUE(ws.getCurrentSize() >= 16 * 256);
+}
+
+TEST_F(WorkspaceTests, Test_ThreadLocal_3) {
+    Workspace ws(1024 * 1024);
+    ws.setThreadLocal(true, 1000);
+
+    // chunk size is rounded up, so chunks carved by other threads stay aligned
+    std::vector<Nd4jLong> pointers(2);
+    for (int t = 0; t < 2; t++) {
+        std::thread thread([&, t] {
+            pointers[t] = reinterpret_cast<Nd4jLong>(ws.allocateBytes(16));
+        });
+        thread.join();
+    }
+
+    ASSERT_EQ(2 * 1008, ws.getCurrentOffset());
+    ASSERT_EQ(0, pointers[0] % 16);
+    ASSERT_EQ(0, pointers[1] % 16);
+}
+
+TEST_F(WorkspaceTests, Test_SpillsPool_1) {
+    Workspace ws(1024);
+
+    ws.allocateBytes(1000);
+    ws.scopeOut();
+    ws.scopeIn();
+    ASSERT_EQ(1024, ws.getCurrentSize());
+
+    // spike: nothing pooled yet, so every spill is malloc
+    for (int e = 0; e < 4; e++)
+        ws.allocateBytes(1000);
+
+    ASSERT_EQ(3000, ws.getSpilledSize());
+    ASSERT_EQ(0, ws.getSpillsHits());
+    ASSERT_EQ(3, ws.getSpillsMisses());
+
+    ws.scopeOut();
+    ws.scopeIn();
+
+    // single spike doesn't grow workspace
+    ASSERT_EQ(1024, ws.getCurrentSize());
+    ASSERT_EQ(0, ws.getSpilledSize());
+
+    // pool is trimmed to the workspace size: 1 buffer of 1024 bytes
+    ASSERT_EQ(1024, ws.getSpillsPoolSize());
+
+    // the same spike now spills into pooled buffer first
+    for (int e = 0; e < 4; e++)
+        ws.allocateBytes(1000);
+
+    ASSERT_EQ(3000, ws.getSpilledSize());
+    ASSERT_EQ(1, ws.getSpillsHits());
+    ASSERT_EQ(5, ws.getSpillsMisses());
+    ASSERT_EQ(0, ws.getSpillsPoolSize());
+
+    ws.scopeOut();
+    ws.scopeIn();
+
+    // overflow persists, so workspace grows straight to the cycle size
+    ASSERT_EQ(4000, ws.getCurrentSize());
+    ASSERT_EQ(1, ws.getReallocations());
+    ASSERT_EQ(3072, ws.getSpillsPoolSize());
+
+    for (int e = 0; e < 4; e++)
+        ws.allocateBytes(1000);
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+}
+
+TEST_F(WorkspaceTests, Test_Reallocations_1) {
+    Workspace ws(128);
+
+    for (int e = 0; e < 5; e++) {
+        ws.scopeIn();
+        ws.allocateBytes(8);
+        ws.scopeOut();
+    }
+
+    ASSERT_EQ(0, ws.getReallocations());
+
+    // step change of cycle size: 8 -> 1280 bytes
+    for (int e = 0; e < 20; e++) {
+        ws.scopeIn();
+        for (int i = 0; i < 10; i++)
+            ws.allocateBytes(128);
+
+        if (e >= 2)
+            ASSERT_EQ(0, ws.getSpilledSize());
+
+        ws.scopeOut();
+    }
+
+    ASSERT_EQ(1280, ws.getCurrentSize());
+    ASSERT_EQ(1, ws.getReallocations());
+
+    // and back: workspace shrinks once smoothed cycle size drops below 1/4 of it, but never below initial size
+    for (int e = 0; e < 40; e++) {
+        ws.scopeIn();
+        ws.allocateBytes(8);
+        ws.scopeOut();
+    }
+
+    ASSERT_EQ(128, ws.getCurrentSize());
+}
+
+TEST_F(WorkspaceTests, Test_Numa_1) {
+    auto numa = NumaHelper::getInstance();
+    ASSERT_TRUE(numa->numberOfNodes() >= 1);
+
+    auto node = numa->currentNode();
+    ASSERT_TRUE(node >= 0 && node < numa->numberOfNodes());
+
+    Workspace ws(4096);
+    ws.setNumaNode(node);
+    ASSERT_EQ(node, ws.numaNode());
+    ASSERT_EQ(4096, ws.getCurrentSize());
+
+    auto p = reinterpret_cast<char*>(ws.allocateBytes(100));
+    for (int e = 0; e < 100; e++)
+        ASSERT_EQ(0, (int) p[e]);
+
+    ASSERT_EQ(100, ws.getCurrentOffset());
+}
+
+TEST_F(WorkspaceTests, Test_HugePages_1) {
+    Environment::getInstance()->setHugePages(true);
+    Environment::getInstance()->setHugePagesThreshold(1024 * 1024);
+
+    auto regions = HugePages::numberOfRegions();
+    {
+        Workspace ws(4 * 1024 * 1024);
+        auto x = NDArrayFactory::create<float>('c', {1024, 1024});
+
+        // small buffers are never backed by huge pages
+        auto y = NDArrayFactory::create<float>('c', {16, 16});
+
+#if defined(__linux__)
+        ASSERT_EQ(regions + 2, HugePages::numberOfRegions());
+#endif
+
+        auto p = reinterpret_cast<char*>(ws.allocateBytes(1024));
+        for (int e = 0; e < 1024; e++)
+            ASSERT_EQ(0, (int) p[e]);
+
+        ASSERT_NEAR(0.0f, x.sumNumber().e<float>(0), 1e-5f);
+
+        x.assign(1.0f);
+        ASSERT_NEAR(1024.0f * 1024.0f, x.sumNumber().e<float>(0), 1e-1f);
+    }
+
+    ASSERT_EQ(regions, HugePages::numberOfRegions());
+
+    Environment::getInstance()->setHugePages(false);
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {
@@ -4953,7 +4953,7 @@ public class SameDiff extends SDBaseOps {
         }
 
         int fg = FlatGraph.createFlatGraph(bufferBuilder, graphId, variablesOffset, nodesOffset, outputsOffset,
-                configuration.getFlatConfiguration(bufferBuilder), placeholdersOffset, lossVarOffset, trainingConfigOffset, updaterStateOffset);
+                configuration.getFlatConfiguration(bufferBuilder), placeholdersOffset, lossVarOffset, trainingConfigOffset, updaterStateOffset, 0, 0);
         bufferBuilder.finish(fg);
 
         synchronized (this) {
@@ -37,6 +37,12 @@ public final class FlatGraph extends Table {
   public UpdaterState updaterState(int j) { return updaterState(new UpdaterState(), j); }
   public UpdaterState updaterState(UpdaterState obj, int j) { int o = __offset(20); return o != 0 ? obj.__assign(__indirect(__vector(o) + j * 4), bb) : null; }
   public int updaterStateLength() { int o = __offset(20); return o != 0 ? __vector_len(o) : 0; }
+  public IntPair stateOutputs(int j) { return stateOutputs(new IntPair(), j); }
+  public IntPair stateOutputs(IntPair obj, int j) { int o = __offset(22); return o != 0 ? obj.__assign(__indirect(__vector(o) + j * 4), bb) : null; }
+  public int stateOutputsLength() { int o = __offset(22); return o != 0 ? __vector_len(o) : 0; }
+  public IntPair stateInputs(int j) { return stateInputs(new IntPair(), j); }
+  public IntPair stateInputs(IntPair obj, int j) { int o = __offset(24); return o != 0 ? obj.__assign(__indirect(__vector(o) + j * 4), bb) : null; }
+  public int stateInputsLength() { int o = __offset(24); return o != 0 ? __vector_len(o) : 0; }
 
   public static int createFlatGraph(FlatBufferBuilder builder,
       long id,
@@ -47,9 +53,13 @@ public final class FlatGraph extends Table {
       int placeholdersOffset,
       int lossVariablesOffset,
       int trainingConfigOffset,
-      int updaterStateOffset) {
-    builder.startObject(9);
+      int updaterStateOffset,
+      int stateOutputsOffset,
+      int stateInputsOffset) {
+    builder.startObject(11);
     FlatGraph.addId(builder, id);
+    FlatGraph.addStateInputs(builder, stateInputsOffset);
+    FlatGraph.addStateOutputs(builder, stateOutputsOffset);
     FlatGraph.addUpdaterState(builder, updaterStateOffset);
     FlatGraph.addTrainingConfig(builder, trainingConfigOffset);
     FlatGraph.addLossVariables(builder, lossVariablesOffset);
@@ -61,7 +71,7 @@ public final class FlatGraph extends Table {
     return FlatGraph.endFlatGraph(builder);
   }
 
-  public static void startFlatGraph(FlatBufferBuilder builder) { builder.startObject(9); }
+  public static void startFlatGraph(FlatBufferBuilder builder) { builder.startObject(11); }
   public static void addId(FlatBufferBuilder builder, long id) { builder.addLong(0, id, 0L); }
   public static void addVariables(FlatBufferBuilder builder, int variablesOffset) { builder.addOffset(1, variablesOffset, 0); }
   public static int createVariablesVector(FlatBufferBuilder builder, int[] data) { builder.startVector(4, data.length, 4); for (int i = data.length - 1; i >= 0; i--) builder.addOffset(data[i]); return builder.endVector(); }
@@ -83,6 +93,12 @@ public final class FlatGraph extends Table {
   public static void addUpdaterState(FlatBufferBuilder builder, int updaterStateOffset) { builder.addOffset(8, updaterStateOffset, 0); }
   public static int createUpdaterStateVector(FlatBufferBuilder builder, int[] data) { builder.startVector(4, data.length, 4); for (int i = data.length - 1; i >= 0; i--) builder.addOffset(data[i]); return builder.endVector(); }
   public static void startUpdaterStateVector(FlatBufferBuilder builder, int numElems) { builder.startVector(4, numElems, 4); }
+  public static void addStateOutputs(FlatBufferBuilder builder, int stateOutputsOffset) { builder.addOffset(9, stateOutputsOffset, 0); }
+  public static int createStateOutputsVector(FlatBufferBuilder builder, int[] data) { builder.startVector(4, data.length, 4); for (int i = data.length - 1; i >= 0; i--) builder.addOffset(data[i]); return builder.endVector(); }
+  public static void startStateOutputsVector(FlatBufferBuilder builder, int numElems) { builder.startVector(4, numElems, 4); }
+  public static void addStateInputs(FlatBufferBuilder builder, int stateInputsOffset) { builder.addOffset(10, stateInputsOffset, 0); }
+  public static int createStateInputsVector(FlatBufferBuilder builder, int[] data) { builder.startVector(4, data.length, 4); for (int i = data.length - 1; i >= 0; i--) builder.addOffset(data[i]); return builder.endVector(); }
+  public static void startStateInputsVector(FlatBufferBuilder builder, int numElems) { builder.startVector(4, numElems, 4); }
   public static int endFlatGraph(FlatBufferBuilder builder) {
     int o = builder.endObject();
     return o;
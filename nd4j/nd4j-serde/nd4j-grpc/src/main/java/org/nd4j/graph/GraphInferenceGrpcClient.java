@@ -153,7 +153,7 @@ public class GraphInferenceGrpcClient {
 
         val varsOff = FlatInferenceRequest.createVariablesVector(builder, ins);
 
-        val off = FlatInferenceRequest.createFlatInferenceRequest(builder, graphId, varsOff, 0);
+        val off = FlatInferenceRequest.createFlatInferenceRequest(builder, graphId, varsOff, 0, 0L);
         builder.finish(off);
 
         val req = FlatInferenceRequest.getRootAsFlatInferenceRequest(builder.dataBuffer());
@@ -195,7 +195,7 @@ public class GraphInferenceGrpcClient {
     public void dropGraph(long graphId) {
         val builder = new FlatBufferBuilder(128);
 
-        val off = FlatDropRequest.createFlatDropRequest(builder, graphId);
+        val off = FlatDropRequest.createFlatDropRequest(builder, graphId, 0L);
         builder.finish(off);
 
         val req = FlatDropRequest.getRootAsFlatDropRequest(builder.dataBuffer());
@@ -204,4 +204,22 @@ public class GraphInferenceGrpcClient {
         if (v.status() != 0)
             throw new ND4JIllegalStateException("registerGraph() gRPC call failed");
     }
+
+    /**
+     * This method ends streaming session of the given graph on the GraphServer instance, releasing its state
+     * @param graphId id of the graph
+     * @param sessionId id of the session
+     */
+    public void endSession(long graphId, long sessionId) {
+        val builder = new FlatBufferBuilder(128);
+
+        val off = FlatDropRequest.createFlatDropRequest(builder, graphId, sessionId);
+        builder.finish(off);
+
+        val req = FlatDropRequest.getRootAsFlatDropRequest(builder.dataBuffer());
+
+        val v = blockingStub.forgetGraph(req);
+        if (v.status() != 0)
+            throw new ND4JIllegalStateException("endSession() gRPC call failed");
+    }
 }